@@ -23,178 +23,225 @@
 #include <cassert>
 #include <iostream>
 #include <limits>
-#include <stack>
+#include <mutex>
+#include <type_traits>
 #include <vector>
 
 // Undefine this to prevent false positives when looking for memory leaks.
 #define TB_ENABLE_ALLOCATOR 1
 
-template <class T, size_t PoolSize = 64, size_t BlocksPerChunk = 256>
+/**
+ * Fixed size block allocator for classes that derive from it. Blocks are carved out of contiguous chunks that
+ * belong to an arena, and every thread allocates from its own arena, so that objects can be created and destroyed
+ * on worker threads. An object may be deleted on any thread; its block is returned to the arena it was allocated
+ * from. Arenas of finished threads are handed to the next thread that starts allocating.
+ */
+template <class T, size_t BlocksPerChunk = 256>
 class Allocator {
 private:
+    class Chunk;
+    
+    struct Block {
+        typename std::aligned_storage<sizeof(T), std::alignment_of<T>::value>::type storage;
+        Chunk* chunk;
+    };
+    
+    class Arena;
+    
     class Chunk {
+    public:
+        Arena* const arena;
+        Chunk* previous;
+        Chunk* next;
     private:
-        unsigned char m_blocks[BlocksPerChunk * sizeof(T)];
-        unsigned char m_firstFreeBlock;
-        unsigned char m_numFreeBlocks;
+        Block m_blocks[BlocksPerChunk];
+        Block* m_firstFreeBlock;
+        size_t m_numFreeBlocks;
     public:
-        Chunk() :
-        m_firstFreeBlock(0),
-        m_numFreeBlocks(BlocksPerChunk - 1) {
-            for (size_t i = 0; i < BlocksPerChunk - 1; i++)
-                m_blocks[i * sizeof(T)] = static_cast<unsigned char>(i + 1);
+        Chunk(Arena* i_arena) :
+        arena(i_arena),
+        previous(NULL),
+        next(NULL),
+        m_firstFreeBlock(m_blocks),
+        m_numFreeBlocks(BlocksPerChunk) {
+            static_assert(sizeof(T) >= sizeof(Block*), "Allocated type must be able to hold a pointer");
+            for (size_t i = 0; i < BlocksPerChunk; ++i) {
+                m_blocks[i].chunk = this;
+                setNext(m_blocks[i], i < BlocksPerChunk - 1 ? &m_blocks[i + 1] : NULL);
+            }
         }
         
-        bool contains(const T* t) const {
-            const unsigned char* block = reinterpret_cast<const unsigned char*>(t);
-            if (block < m_blocks)
-                return false;
-            size_t offset = static_cast<size_t>(block - m_blocks);
-            return offset < (BlocksPerChunk - 1) * sizeof(T);
+        Block* allocate() {
+            assert(!full());
+            Block* block = m_firstFreeBlock;
+            m_firstFreeBlock = getNext(*block);
+            --m_numFreeBlocks;
+            return block;
         }
         
-        T* allocate() {
-            if (m_numFreeBlocks == 0)
-                return NULL;
-            
-            unsigned char* block = m_blocks + m_firstFreeBlock * sizeof(T);
-            m_firstFreeBlock = *block;
-            m_numFreeBlocks--;
-            return reinterpret_cast<T*>(block);
+        void deallocate(Block* block) {
+            assert(block->chunk == this);
+            assert(m_numFreeBlocks < BlocksPerChunk);
+            setNext(*block, m_firstFreeBlock);
+            m_firstFreeBlock = block;
+            ++m_numFreeBlocks;
         }
         
-        void deallocate(T* t) {
-            assert(m_numFreeBlocks < BlocksPerChunk - 1);
-            assert(contains(t));
-            
-            unsigned char* block = reinterpret_cast<unsigned char*>(t);
-            assert(block >= m_blocks);
-            size_t offset = static_cast<size_t>(block - m_blocks);
-            assert(offset % sizeof(T) == 0);
+        bool empty() const {
+            return m_numFreeBlocks == BlocksPerChunk;
+        }
+        
+        bool full() const {
+            return m_numFreeBlocks == 0;
+        }
+    private:
+        static Block* getNext(const Block& block) {
+            return *reinterpret_cast<Block* const*>(&block.storage);
+        }
+        
+        static void setNext(Block& block, Block* next) {
+            *reinterpret_cast<Block**>(&block.storage) = next;
+        }
+    };
+    
+    /**
+     * Owns the chunks allocated by one thread at a time. The mutex is only contended when another thread deletes
+     * an object that was allocated from this arena.
+     */
+    class Arena {
+    private:
+        std::mutex m_mutex;
+        Chunk* m_availableChunks; // chunks that have at least one free block
+        Chunk* m_spareChunk; // an empty chunk that is kept to avoid reallocating chunks repeatedly
+    public:
+        Arena() :
+        m_availableChunks(NULL),
+        m_spareChunk(NULL) {}
+        
+        Block* allocate() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_availableChunks == NULL) {
+                if (m_spareChunk != NULL) {
+                    link(m_spareChunk);
+                    m_spareChunk = NULL;
+                } else {
+                    link(new Chunk(this));
+                }
+            }
             
-            size_t index = offset / sizeof(T);
-            assert(index < BlocksPerChunk);
+            Chunk* chunk = m_availableChunks;
+            Block* block = chunk->allocate();
+            if (chunk->full())
+                unlink(chunk);
+            return block;
+        }
+        
+        void deallocate(Block* block) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            Chunk* chunk = block->chunk;
+            const bool wasFull = chunk->full();
+            chunk->deallocate(block);
             
-            *block = m_firstFreeBlock;
-            m_firstFreeBlock = static_cast<unsigned char>(index);
-            m_numFreeBlocks++;
+            if (wasFull) {
+                link(chunk);
+            } else if (chunk->empty()) {
+                unlink(chunk);
+                if (m_spareChunk == NULL)
+                    m_spareChunk = chunk;
+                else
+                    delete chunk;
+            }
+        }
+    private:
+        void link(Chunk* chunk) {
+            chunk->previous = NULL;
+            chunk->next = m_availableChunks;
+            if (m_availableChunks != NULL)
+                m_availableChunks->previous = chunk;
+            m_availableChunks = chunk;
         }
         
-        bool empty() const {
-            return m_numFreeBlocks == BlocksPerChunk - 1;
+        void unlink(Chunk* chunk) {
+            if (chunk->previous != NULL)
+                chunk->previous->next = chunk->next;
+            else
+                m_availableChunks = chunk->next;
+            if (chunk->next != NULL)
+                chunk->next->previous = chunk->previous;
+            chunk->previous = chunk->next = NULL;
         }
+    };
+    
+    typedef std::vector<Arena*> ArenaList;
+    
+    /**
+     * Arenas are never deleted because objects allocated from them may outlive the thread that created them.
+     * Instead, an arena is returned to the list of idle arenas when its thread exits, and reused by the next thread.
+     */
+    class ThreadArena {
+    private:
+        Arena* m_arena;
+    public:
+        ThreadArena() :
+        m_arena(acquireArena()) {}
         
-        bool full() const {
-            return m_numFreeBlocks == 0;
+        ~ThreadArena() {
+            releaseArena(m_arena);
+        }
+        
+        Arena& arena() {
+            return *m_arena;
         }
     };
     
-    typedef std::vector<Chunk*> ChunkList;
-    typedef std::stack<T*> Pool;
+    static std::mutex& idleArenasMutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
     
-    static Pool& pool() {
-        static Pool p;
-        return p;
+    static ArenaList& idleArenas() {
+        static ArenaList arenas;
+        return arenas;
     }
     
-    static ChunkList& fullChunks() {
-        static ChunkList chunks;
-        return chunks;
+    static Arena* acquireArena() {
+        std::lock_guard<std::mutex> lock(idleArenasMutex());
+        ArenaList& arenas = idleArenas();
+        if (arenas.empty())
+            return new Arena();
+        
+        Arena* arena = arenas.back();
+        arenas.pop_back();
+        return arena;
     }
     
-    static ChunkList& mixedChunks() {
-        static ChunkList chunks;
-        return chunks;
+    static void releaseArena(Arena* arena) {
+        std::lock_guard<std::mutex> lock(idleArenasMutex());
+        idleArenas().push_back(arena);
     }
     
-    static ChunkList emptyChunks() {
-        static ChunkList chunks;
-        return chunks;
+    static Arena& threadArena() {
+        // the plain pointer avoids the initialization check of the thread local handle on every allocation
+        static thread_local Arena* arena = NULL;
+        if (arena == NULL) {
+            static thread_local ThreadArena threadArena;
+            arena = &threadArena.arena();
+        }
+        return *arena;
     }
 public:
 #ifdef TB_ENABLE_ALLOCATOR
     void* operator new(size_t size) {
         assert(size == sizeof(T));
-        
-        if (!pool().empty()) {
-            T* t = pool().top();
-            pool().pop();
-            return t;
-        }
-        
-        Chunk* chunk = NULL;
-        if (mixedChunks().empty()) {
-            if (!emptyChunks().empty()) {
-                chunk = emptyChunks().back();
-                emptyChunks().pop_back();
-            } else {
-                chunk = new Chunk();
-            }
-        } else {
-            chunk = mixedChunks().back();
-            mixedChunks().pop_back();
-        }
-        
-        assert(!chunk->full());
-        T* block = chunk->allocate();
-        
-        if (chunk->full())
-            fullChunks().push_back(chunk);
-            else
-                mixedChunks().push_back(chunk);
-                return block;
+        return &threadArena().allocate()->storage;
     }
     
     void operator delete(void* block) {
-        T* t = reinterpret_cast<T*>(block);
-        
-        if (PoolSize > 0 && pool().size() < PoolSize) {
-            pool().push(t);
+        if (block == NULL)
             return;
-        }
         
-        typename ChunkList::reverse_iterator fullIt, fullEnd, mixedIt, mixedEnd;
-        fullIt = fullChunks().rbegin();
-        fullEnd = fullChunks().rend();
-        mixedIt = mixedChunks().rbegin();
-        mixedEnd = mixedChunks().rend();
-        
-        Chunk* chunk = NULL;
-        while (fullIt < fullEnd || mixedIt < mixedEnd) {
-            if (fullIt < fullEnd) {
-                Chunk* fullChunk = *fullIt;
-                if (fullChunk->contains(t)) {
-                    chunk = fullChunk;
-                    break;
-                }
-                ++fullIt;
-            }
-            if (mixedIt < mixedEnd) {
-                Chunk* mixedChunk = *mixedIt;
-                if (mixedChunk->contains(t)) {
-                    chunk = mixedChunk;
-                    break;
-                }
-                ++mixedIt;
-            }
-        }
-        
-        assert(chunk != NULL);
-        
-        if (chunk->full()) {
-            fullChunks().erase((fullIt + 1).base());
-            mixedChunks().push_back(chunk);
-        }
-        
-        chunk->deallocate(t);
-        
-        if (chunk->empty()) {
-            mixedChunks().erase((mixedIt + 1).base());
-            if (emptyChunks().size() < 2)
-                emptyChunks().push_back(chunk);
-                else
-                    delete chunk;
-        }
+        Block* b = reinterpret_cast<Block*>(block);
+        b->chunk->arena->deallocate(b);
     }
 #endif
 };
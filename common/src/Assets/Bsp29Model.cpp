@@ -87,7 +87,7 @@ namespace TrenchBroom {
             
             for (const Face& face : model.faces) {
                 const size_t faceVertexCount = face.vertices().size();
-                size.inc(face.texture(), GL_POLYGON, faceVertexCount);
+                size.incPolygon(face.texture(), faceVertexCount);
                 vertexCount += faceVertexCount;
             }
 
@@ -34,9 +34,13 @@ namespace TrenchBroom {
         }
 
         void EntityDefinitionManager::loadDefinitions(const IO::Path& path, const IO::EntityDefinitionLoader& loader, IO::ParserStatus& status) {
+            setDefinitions(loader.loadEntityDefinitions(status, path));
+        }
+        
+        void EntityDefinitionManager::setDefinitions(const EntityDefinitionList& definitions) {
             using std::swap;
             
-            EntityDefinitionList newDefinitions = loader.loadEntityDefinitions(status, path);
+            EntityDefinitionList newDefinitions = definitions;
             std::swap(m_definitions, newDefinitions);
             VectorUtils::clearAndDelete(newDefinitions);
             
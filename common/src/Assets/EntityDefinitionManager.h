@@ -48,6 +48,12 @@ namespace TrenchBroom {
             ~EntityDefinitionManager();
 
             void loadDefinitions(const IO::Path& path, const IO::EntityDefinitionLoader& loader, IO::ParserStatus& status);
+            
+            /**
+             * Replaces the current definitions with the given ones, which have already been loaded. This manager
+             * takes ownership of the given definitions.
+             */
+            void setDefinitions(const EntityDefinitionList& definitions);
             void clear();
             
             EntityDefinition* definition(const Model::AttributableNode* attributable) const;
@@ -25,35 +25,123 @@
 #include "IO/FileSystem.h"
 
 #include <algorithm>
-#include <cstring>
+#include <ctime>
 #include <fstream>
+#include <map>
+#include <mutex>
 
 namespace TrenchBroom {
     namespace Assets {
+        class Palette::Cache {
+        private:
+            struct Entry {
+                std::time_t modificationTime;
+                DataPtr data;
+                
+                Entry(const std::time_t i_modificationTime, DataPtr i_data) :
+                modificationTime(i_modificationTime),
+                data(i_data) {}
+            };
+            
+            typedef std::map<String, Entry> EntryMap;
+            
+            std::mutex m_mutex;
+            EntryMap m_entries;
+        public:
+            static Cache& instance() {
+                static Cache cache;
+                return cache;
+            }
+            
+            DataPtr find(const String& key, const std::time_t modificationTime) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                
+                EntryMap::const_iterator it = m_entries.find(key);
+                if (it == m_entries.end() || it->second.modificationTime != modificationTime)
+                    return DataPtr();
+                return it->second.data;
+            }
+            
+            DataPtr insert(const String& key, const std::time_t modificationTime, DataPtr data) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                
+                EntryMap::iterator it = m_entries.find(key);
+                if (it == m_entries.end()) {
+                    m_entries.insert(std::make_pair(key, Entry(modificationTime, data)));
+                } else if (it->second.modificationTime == modificationTime) {
+                    // another thread might have been faster
+                    return it->second.data;
+                } else {
+                    // the file has changed, so the old entry is stale
+                    it->second = Entry(modificationTime, data);
+                }
+                return data;
+            }
+            
+            void clear() {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_entries.clear();
+            }
+        };
+        
         Palette::Data::Data(const size_t size, unsigned char* data) :
         m_size(size),
         m_data(data) {
             ensure(m_size > 0, "size is 0");
             ensure(m_data != NULL, "data is null");
+            
+            std::fill(m_rgba, m_rgba + 256 * 4, 0);
+            const size_t count = std::min(m_size / 3, static_cast<size_t>(256));
+            for (size_t i = 0; i < count; ++i) {
+                m_rgba[i * 4 + 0] = m_data[i * 3 + 0];
+                m_rgba[i * 4 + 1] = m_data[i * 3 + 1];
+                m_rgba[i * 4 + 2] = m_data[i * 3 + 2];
+                m_rgba[i * 4 + 3] = 0xFF;
+            }
         }
         
         Palette::Data::~Data() {
             delete [] m_data;
         }
 
+        size_t Palette::Data::size() const {
+            return m_size;
+        }
+        
+        const unsigned char* Palette::Data::data() const {
+            return m_data;
+        }
+
         Palette::Palette(const size_t size, unsigned char* data) :
         m_data(new Data(size, data)) {}
 
+        Palette::Palette(DataPtr data) :
+        m_data(data) {
+            ensure(m_data.get() != NULL, "data is null");
+        }
+
         Palette Palette::loadFile(const IO::FileSystem& fs, const IO::Path& path) {
             try {
-                IO::MappedFile::Ptr file = fs.openFile(path);
                 const String extension = StringUtils::toLower(path.extension());
-                if (extension == "lmp")
-                    return loadLmp(file);
-                else if (extension == "pcx")
-                    return loadPcx(file);
-                else
-                    throw new AssetException("Could not load palette file '" + path.asString() + "': Unknown palette format");
+                if (extension != "lmp" && extension != "pcx")
+                    throw AssetException("Could not load palette file '" + path.asString() + "': Unknown palette format");
+                
+                // files whose modification time is unknown are not cached
+                const String key = StringUtils::toLower(fs.makeAbsolute(path).asString());
+                const std::time_t modificationTime = fs.modificationTime(path);
+                
+                Cache& cache = Cache::instance();
+                if (modificationTime != 0) {
+                    DataPtr data = cache.find(key, modificationTime);
+                    if (data.get() != NULL)
+                        return Palette(data);
+                }
+                
+                IO::MappedFile::Ptr file = fs.openFile(path);
+                const Palette palette = extension == "lmp" ? loadLmp(file) : loadPcx(file);
+                if (modificationTime == 0)
+                    return palette;
+                return Palette(cache.insert(key, modificationTime, palette.m_data));
             } catch (const FileSystemException& e) {
                 throw AssetException("Could not load palette file '" + path.asString() + "': " + e.what());
             }
@@ -79,5 +167,17 @@ namespace TrenchBroom {
             
             return Palette(size, data);
         }
+
+        void Palette::clearCache() {
+            Cache::instance().clear();
+        }
+
+        bool Palette::operator==(const Palette& other) const {
+            return m_data == other.m_data;
+        }
+        
+        bool Palette::operator!=(const Palette& other) const {
+            return !(*this == other);
+        }
     }
 }
@@ -24,6 +24,7 @@
 #include "ByteBuffer.h"
 #include "IO/MappedFile.h"
 
+#include <algorithm>
 #include <cassert>
 
 namespace TrenchBroom {
@@ -39,10 +40,14 @@ namespace TrenchBroom {
             private:
                 size_t m_size;
                 unsigned char* m_data;
+                unsigned char m_rgba[256 * 4];
             public:
                 Data(const size_t size, unsigned char* data);
                 ~Data();
 
+                size_t size() const;
+                const unsigned char* data() const;
+
                 template <typename IndexT, typename ColorT>
                 void indexedToRgb(const Buffer<IndexT>& indexedImage, const size_t pixelCount, Buffer<ColorT>& rgbImage, Color& averageColor) const {
                     indexedToRgb(&indexedImage[0], pixelCount, rgbImage, averageColor);
@@ -50,15 +55,28 @@ namespace TrenchBroom {
                 
                 template <typename IndexT, typename ColorT>
                 void indexedToRgb(const IndexT* indexedImage, const size_t pixelCount, Buffer<ColorT>& rgbImage, Color& averageColor) const {
-                    double avg[3];
-                    avg[0] = avg[1] = avg[2] = 0.0;
+                    // Expand each pixel through the precomputed lookup table and only count how often each index
+                    // occurs; the average color is then derived from the histogram instead of summing every pixel.
+                    size_t histogram[256];
+                    std::fill(histogram, histogram + 256, 0);
+                    
                     for (size_t i = 0; i < pixelCount; ++i) {
                         const size_t index = static_cast<size_t>(static_cast<unsigned char>(indexedImage[i]));
-                        assert(index < m_size);
-                        for (size_t j = 0; j < 3; ++j) {
-                            const unsigned char c = m_data[index * 3 + j];
-                            rgbImage[i * 3 + j] = c;
-                            avg[j] += static_cast<double>(c);
+                        assert(index * 3 < m_size);
+                        const unsigned char* entry = m_rgba + index * 4;
+                        rgbImage[i * 3 + 0] = entry[0];
+                        rgbImage[i * 3 + 1] = entry[1];
+                        rgbImage[i * 3 + 2] = entry[2];
+                        ++histogram[index];
+                    }
+                    
+                    double avg[3];
+                    avg[0] = avg[1] = avg[2] = 0.0;
+                    for (size_t i = 0; i < 256; ++i) {
+                        if (histogram[i] > 0) {
+                            const double count = static_cast<double>(histogram[i]);
+                            for (size_t j = 0; j < 3; ++j)
+                                avg[j] += count * static_cast<double>(m_rgba[i * 4 + j]);
                         }
                     }
                     
@@ -70,13 +88,29 @@ namespace TrenchBroom {
             
             typedef std::shared_ptr<Data> DataPtr;
             DataPtr m_data;
+            
+            class Cache;
         public:
             Palette(const size_t size, unsigned char* data);
-            
+        private:
+            Palette(DataPtr data);
+        public:
+            /**
+             * Loads the palette at the given path. Palettes are cached process wide by absolute path and modification
+             * time, so loading an unchanged palette file again does not read the file at all.
+             */
             static Palette loadFile(const IO::FileSystem& fs, const IO::Path& path);
             static Palette loadLmp(IO::MappedFile::Ptr file);
             static Palette loadPcx(IO::MappedFile::Ptr file);
             
+            /**
+             * Drops all cached palettes. Palettes that are still in use remain valid.
+             */
+            static void clearCache();
+            
+            bool operator==(const Palette& other) const;
+            bool operator!=(const Palette& other) const;
+            
             template <typename IndexT, typename ColorT>
             void indexedToRgb(const Buffer<IndexT>& indexedImage, const size_t pixelCount, Buffer<ColorT>& rgbImage, Color& averageColor) const {
                 m_data->indexedToRgb(indexedImage, pixelCount, rgbImage, averageColor);
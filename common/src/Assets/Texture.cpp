@@ -21,6 +21,7 @@
 #include "Assets/ImageUtils.h"
 #include "Assets/TextureCollection.h"
 
+#include <algorithm>
 #include <cassert>
 
 namespace TrenchBroom {
@@ -34,6 +35,62 @@ namespace TrenchBroom {
             }
         }
 
+        TextureBuffer createThumbnail(const TextureBuffer::List& mips, const size_t textureWidth, const size_t textureHeight, const GLenum format, const size_t maxSize, size_t& width, size_t& height) {
+            assert(maxSize > 0);
+            if (mips.empty() || (format != GL_RGB && format != GL_BGR))
+                return TextureBuffer();
+            
+            width = textureWidth;
+            height = textureHeight;
+            if (width > maxSize || height > maxSize) {
+                const size_t maxDim = std::max(width, height);
+                width  = std::max(static_cast<size_t>(1), width  * maxSize / maxDim);
+                height = std::max(static_cast<size_t>(1), height * maxSize / maxDim);
+            }
+            
+            // find the smallest mip level that is still at least as large as the thumbnail
+            size_t level = 0;
+            while (level + 1 < mips.size() && (textureWidth >> (level + 1)) >= width && (textureHeight >> (level + 1)) >= height)
+                ++level;
+            
+            const size_t mipWidth = textureWidth >> level;
+            const size_t mipHeight = textureHeight >> level;
+            const unsigned char* mip = mips[level].ptr();
+            const bool bgr = format == GL_BGR;
+            
+            TextureBuffer thumbnail(3 * width * height);
+            unsigned char* out = thumbnail.ptr();
+            
+            // box filter each thumbnail pixel from the mip pixels that it covers
+            for (size_t y = 0; y < height; ++y) {
+                const size_t y0 = y * mipHeight / height;
+                const size_t y1 = std::max(y0 + 1, (y + 1) * mipHeight / height);
+                for (size_t x = 0; x < width; ++x) {
+                    const size_t x0 = x * mipWidth / width;
+                    const size_t x1 = std::max(x0 + 1, (x + 1) * mipWidth / width);
+                    
+                    size_t sum[3] = { 0, 0, 0 };
+                    for (size_t sy = y0; sy < y1; ++sy) {
+                        const unsigned char* pixel = mip + 3 * (sy * mipWidth + x0);
+                        for (size_t sx = x0; sx < x1; ++sx) {
+                            sum[0] += pixel[0];
+                            sum[1] += pixel[1];
+                            sum[2] += pixel[2];
+                            pixel += 3;
+                        }
+                    }
+                    
+                    const size_t count = (y1 - y0) * (x1 - x0);
+                    unsigned char* target = out + 3 * (y * width + x);
+                    target[0] = static_cast<unsigned char>(sum[bgr ? 2 : 0] / count);
+                    target[1] = static_cast<unsigned char>(sum[1] / count);
+                    target[2] = static_cast<unsigned char>(sum[bgr ? 0 : 2] / count);
+                }
+            }
+            
+            return thumbnail;
+        }
+        
         Texture::Texture(const String& name, const size_t width, const size_t height, const Color& averageColor, const TextureBuffer& buffer, const GLenum format) :
         m_collection(NULL),
         m_name(name),
@@ -43,7 +100,11 @@ namespace TrenchBroom {
         m_usageCount(0),
         m_overridden(false),
         m_format(format),
-        m_textureId(0) {
+        m_minFilter(GL_NEAREST),
+        m_magFilter(GL_NEAREST),
+        m_prepared(false),
+        m_textureId(0),
+        m_thumbnailAtlas(NULL) {
             assert(m_width > 0);
             assert(m_height > 0);
             assert(buffer.size() >= m_width * m_height * 3);
@@ -59,8 +120,12 @@ namespace TrenchBroom {
         m_usageCount(0),
         m_overridden(false),
         m_format(format),
+        m_minFilter(GL_NEAREST),
+        m_magFilter(GL_NEAREST),
+        m_prepared(false),
         m_textureId(0),
-        m_buffers(buffers) {
+        m_buffers(buffers),
+        m_thumbnailAtlas(NULL) {
             assert(m_width > 0);
             assert(m_height > 0);
             for (size_t i = 0; i < m_buffers.size(); ++i) {
@@ -77,15 +142,23 @@ namespace TrenchBroom {
         m_usageCount(0),
         m_overridden(false),
         m_format(format),
-        m_textureId(0) {}
+        m_minFilter(GL_NEAREST),
+        m_magFilter(GL_NEAREST),
+        m_prepared(false),
+        m_textureId(0),
+        m_thumbnailAtlas(NULL) {}
 
         Texture::~Texture() {
-            if (m_collection == NULL && m_textureId != 0)
+            if (m_textureId != 0)
                 glAssert(glDeleteTextures(1, &m_textureId));
             m_textureId = 0;
         }
         
         const String& Texture::name() const {
+            return m_name.name();
+        }
+        
+        const TextureName& Texture::internedName() const {
             return m_name;
         }
         
@@ -127,13 +200,68 @@ namespace TrenchBroom {
         }
         
         bool Texture::isPrepared() const {
-            return m_textureId != 0;
+            return m_prepared;
+        }
+
+        void Texture::prepare(const int minFilter, const int magFilter) {
+            assert(!m_buffers.empty());
+            m_minFilter = minFilter;
+            m_magFilter = magFilter;
+            m_prepared = true;
+        }
+        
+        void Texture::setMode(const int minFilter, const int magFilter) {
+            m_minFilter = minFilter;
+            m_magFilter = magFilter;
+            if (isUploaded()) {
+                activate();
+                glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter));
+                glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter));
+                deactivate();
+            }
+        }
+
+        void Texture::activate() const {
+            assert(isPrepared());
+            if (!isUploaded())
+                upload();
+            glAssert(glBindTexture(GL_TEXTURE_2D, m_textureId));
+        }
+        
+        void Texture::deactivate() const {
+            glAssert(glBindTexture(GL_TEXTURE_2D, 0));
         }
 
-        void Texture::prepare(const GLuint textureId, const int minFilter, const int magFilter) {
-            assert(textureId > 0);
+        TextureBuffer Texture::createThumbnail(const size_t maxSize, size_t& width, size_t& height) const {
+            return Assets::createThumbnail(m_buffers, m_width, m_height, m_format, maxSize, width, height);
+        }
+        
+        bool Texture::hasThumbnail() const {
+            return m_thumbnailAtlas != NULL;
+        }
+        
+        const Renderer::TextureAtlas* Texture::thumbnailAtlas() const {
+            return m_thumbnailAtlas;
+        }
+        
+        const Renderer::TextureAtlas::Slot& Texture::thumbnailSlot() const {
+            return m_thumbnailSlot;
+        }
+        
+        void Texture::setThumbnail(const Renderer::TextureAtlas* atlas, const Renderer::TextureAtlas::Slot& slot) {
+            m_thumbnailAtlas = atlas;
+            m_thumbnailSlot = slot;
+        }
+
+        bool Texture::isUploaded() const {
+            return m_textureId != 0;
+        }
+        
+        void Texture::upload() const {
             assert(!m_buffers.empty());
             
+            glAssert(glGenTextures(1, &m_textureId));
+            
             glAssert(glPixelStorei(GL_UNPACK_SWAP_BYTES, false));
             glAssert(glPixelStorei(GL_UNPACK_LSB_FIRST, false));
             glAssert(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
@@ -141,10 +269,10 @@ namespace TrenchBroom {
             glAssert(glPixelStorei(GL_UNPACK_SKIP_ROWS, 0));
             glAssert(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
             
-            glAssert(glBindTexture(GL_TEXTURE_2D, textureId));
+            glAssert(glBindTexture(GL_TEXTURE_2D, m_textureId));
             glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(m_buffers.size() - 1)));
-            glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter));
-            glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter));
+            glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_minFilter));
+            glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_magFilter));
             glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT));
             glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT));
             
@@ -169,23 +297,6 @@ namespace TrenchBroom {
             }
             
             m_buffers.clear();
-            m_textureId = textureId;
-        }
-        
-        void Texture::setMode(const int minFilter, const int magFilter) {
-            activate();
-            glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter));
-            glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter));
-            deactivate();
-        }
-
-        void Texture::activate() const {
-            assert(isPrepared());
-            glAssert(glBindTexture(GL_TEXTURE_2D, m_textureId));
-        }
-        
-        void Texture::deactivate() const {
-            glAssert(glBindTexture(GL_TEXTURE_2D, 0));
         }
 
         void Texture::setCollection(TextureCollection* collection) {
@@ -23,7 +23,9 @@
 #include "ByteBuffer.h"
 #include "Color.h"
 #include "StringUtils.h"
+#include "Assets/TextureName.h"
 #include "Renderer/GL.h"
+#include "Renderer/TextureAtlas.h"
 
 #include <cassert>
 #include <vector>
@@ -35,10 +37,18 @@ namespace TrenchBroom {
         typedef Buffer<unsigned char> TextureBuffer;
         void setMipBufferSize(TextureBuffer::List& buffers, const size_t width, const size_t height);
         
+        /**
+         * Creates a downsampled RGB copy of the given mip levels of a texture with the given size and format that fits
+         * into a square with the given edge length and stores its size in width and height. The copy is computed from
+         * the smallest suitable mip level. Returns an empty buffer if there are no mip levels or if the format is not
+         * supported. Only reads the given buffers, so it may be called from any thread.
+         */
+        TextureBuffer createThumbnail(const TextureBuffer::List& mips, size_t textureWidth, size_t textureHeight, GLenum format, size_t maxSize, size_t& width, size_t& height);
+        
         class Texture {
         private:
             TextureCollection* m_collection;
-            String m_name;
+            TextureName m_name;
             
             size_t m_width;
             size_t m_height;
@@ -48,9 +58,15 @@ namespace TrenchBroom {
             bool m_overridden;
 
             GLenum m_format;
+            int m_minFilter;
+            int m_magFilter;
+            bool m_prepared;
 
             mutable GLuint m_textureId;
             mutable TextureBuffer::List m_buffers;
+            
+            const Renderer::TextureAtlas* m_thumbnailAtlas;
+            Renderer::TextureAtlas::Slot m_thumbnailSlot;
         public:
             Texture(const String& name, const size_t width, const size_t height, const Color& averageColor, const TextureBuffer& buffer, GLenum format = GL_RGB);
             Texture(const String& name, const size_t width, const size_t height, const Color& averageColor, const TextureBuffer::List& buffers, GLenum format = GL_RGB);
@@ -58,6 +74,7 @@ namespace TrenchBroom {
             ~Texture();
 
             const String& name() const;
+            const TextureName& internedName() const;
             
             size_t width() const;
             size_t height() const;
@@ -70,12 +87,31 @@ namespace TrenchBroom {
             void setOverridden(const bool overridden);
 
             bool isPrepared() const;
-            void prepare(GLuint textureId, int minFilter, int magFilter);
+            /**
+             * Marks this texture as ready for rendering with the given filters. The image data is only uploaded when the
+             * texture is activated for the first time, so textures that are never rendered do not occupy video memory.
+             */
+            void prepare(int minFilter, int magFilter);
             void setMode(int minFilter, int magFilter);
 
             void activate() const;
             void deactivate() const;
+            
+            /**
+             * Creates a downsampled RGB copy of this texture that fits into a square with the given edge length. The
+             * copy is computed from the smallest suitable mip level, so this must be called before the texture is
+             * uploaded. Returns an empty buffer if the texture has no image data.
+             */
+            TextureBuffer createThumbnail(size_t maxSize, size_t& width, size_t& height) const;
+            
+            bool hasThumbnail() const;
+            const Renderer::TextureAtlas* thumbnailAtlas() const;
+            const Renderer::TextureAtlas::Slot& thumbnailSlot() const;
+            void setThumbnail(const Renderer::TextureAtlas* atlas, const Renderer::TextureAtlas::Slot& slot);
         private:
+            bool isUploaded() const;
+            void upload() const;
+            
             void setCollection(TextureCollection* collection);
             friend class TextureCollection;
         };
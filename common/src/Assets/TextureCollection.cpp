@@ -20,39 +20,64 @@
 #include "TextureCollection.h"
 
 #include "CollectionUtils.h"
+#include "ParallelUtils.h"
 #include "Assets/Texture.h"
 
+#include <algorithm>
+#include <atomic>
+
 namespace TrenchBroom {
     namespace Assets {
+        /**
+         * Shared between a collection and the worker task that creates its thumbnails so that the task can outlive the
+         * collection. The mip buffers share their storage with the textures and are only read by the task.
+         */
+        struct TextureCollection::ThumbnailJob {
+            struct Source {
+                TextureBuffer::List mips;
+                size_t width;
+                size_t height;
+                GLenum format;
+            };
+            
+            std::vector<Source> sources;
+            std::vector<TextureBuffer> thumbnails;
+            std::vector<size_t> widths;
+            std::vector<size_t> heights;
+            std::atomic<bool> done;
+            
+            ThumbnailJob() :
+            done(false) {}
+        };
+        
         TextureCollection::TextureCollection() :
         m_loaded(false),
-        m_usageCount(0) {}
+        m_usageCount(0),
+        m_prepared(false) {}
         
         TextureCollection::TextureCollection(const TextureList& textures) :
         m_loaded(false),
-        m_usageCount(0) {
+        m_usageCount(0),
+        m_prepared(false) {
             addTextures(textures);
         }
 
         TextureCollection::TextureCollection(const IO::Path& path) :
         m_loaded(false),
         m_path(path),
-        m_usageCount(0) {}
+        m_usageCount(0),
+        m_prepared(false) {}
 
         TextureCollection::TextureCollection(const IO::Path& path, const TextureList& textures) :
         m_loaded(true),
         m_path(path),
-        m_usageCount(0) {
+        m_usageCount(0),
+        m_prepared(false) {
             addTextures(textures);
         }
 
         TextureCollection::~TextureCollection() {
             VectorUtils::clearAndDelete(m_textures);
-            if (!m_textureIds.empty()) {
-                glAssert(glDeleteTextures(static_cast<GLsizei>(m_textureIds.size()),
-                                          static_cast<GLuint*>(&m_textureIds.front())));
-                m_textureIds.clear();
-            }
         }
 
         void TextureCollection::addTextures(const TextureList& textures) {
@@ -90,21 +115,69 @@ namespace TrenchBroom {
         }
 
         bool TextureCollection::prepared() const {
-            return !m_textureIds.empty();
+            return m_prepared;
         }
 
         void TextureCollection::prepare(const int minFilter, const int magFilter) {
             assert(!prepared());
             
-            const size_t textureCount = m_textures.size();
-            m_textureIds.resize(textureCount);
-            glAssert(glGenTextures(static_cast<GLsizei>(textureCount),
-                                   static_cast<GLuint*>(&m_textureIds.front())));
+            // must happen before the textures are uploaded because they release their mips when that happens
+            startThumbnails();
+            
+            for (Texture* texture : m_textures)
+                texture->prepare(minFilter, magFilter);
+            m_prepared = true;
+        }
 
-            for (size_t i = 0; i < textureCount; ++i) {
-                Texture* texture = m_textures[i];
-                texture->prepare(m_textureIds[i], minFilter, magFilter);
+        void TextureCollection::startThumbnails() {
+            static const size_t ThumbnailSize = 64;
+            
+            std::shared_ptr<ThumbnailJob> job(new ThumbnailJob());
+            job->sources.reserve(m_textures.size());
+            for (const Texture* texture : m_textures) {
+                const ThumbnailJob::Source source = { texture->m_buffers, texture->width(), texture->height(), texture->m_format };
+                job->sources.push_back(source);
+            }
+            
+            m_thumbnailJob = job;
+            ParallelUtils::ThreadPool::instance().submit([job]() {
+                const size_t count = job->sources.size();
+                job->thumbnails.resize(count);
+                job->widths.resize(count, 0);
+                job->heights.resize(count, 0);
+                
+                ParallelUtils::parallelFor(count, [&](const size_t i) {
+                    const ThumbnailJob::Source& source = job->sources[i];
+                    job->thumbnails[i] = createThumbnail(source.mips, source.width, source.height, source.format, ThumbnailSize, job->widths[i], job->heights[i]);
+                });
+                
+                job->sources.clear();
+                job->done = true;
+            });
+        }
+
+        void TextureCollection::commitThumbnails() {
+            if (m_thumbnailJob == NULL || !m_thumbnailJob->done)
+                return;
+            
+            const std::shared_ptr<ThumbnailJob> job = m_thumbnailJob;
+            m_thumbnailJob.reset();
+            
+            // packing the thumbnails from tallest to shortest wastes less space on the shelves
+            std::vector<size_t> order;
+            order.reserve(job->thumbnails.size());
+            for (size_t i = 0; i < job->thumbnails.size(); ++i) {
+                if (job->thumbnails[i].size() > 0)
+                    order.push_back(i);
+            }
+            std::stable_sort(std::begin(order), std::end(order), [&](const size_t lhs, const size_t rhs) { return job->heights[lhs] > job->heights[rhs]; });
+            
+            for (const size_t i : order) {
+                Renderer::TextureAtlas::Slot slot;
+                if (m_thumbnails.insert(job->thumbnails[i].ptr(), job->widths[i], job->heights[i], slot))
+                    m_textures[i]->setThumbnail(&m_thumbnails, slot);
             }
+            m_thumbnails.prepare();
         }
 
         void TextureCollection::setTextureMode(const int minFilter, const int magFilter) {
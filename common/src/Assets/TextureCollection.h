@@ -25,14 +25,16 @@
 #include "Assets/AssetTypes.h"
 #include "IO/Path.h"
 #include "Renderer/GL.h"
+#include "Renderer/TextureAtlas.h"
 
+#include <memory>
 #include <vector>
 
 namespace TrenchBroom {
     namespace Assets {
         class TextureCollection {
         private:
-            typedef std::vector<GLuint> TextureIdList;
+            struct ThumbnailJob;
             
             bool m_loaded;
             IO::Path m_path;
@@ -40,7 +42,9 @@ namespace TrenchBroom {
             
             size_t m_usageCount;
             
-            TextureIdList m_textureIds;
+            bool m_prepared;
+            std::shared_ptr<ThumbnailJob> m_thumbnailJob;
+            Renderer::TextureAtlas m_thumbnails;
             
             friend class Texture;
         public:
@@ -63,9 +67,21 @@ namespace TrenchBroom {
             size_t usageCount() const;
             
             bool prepared() const;
+            /**
+             * Prepares the textures for rendering and starts creating their thumbnails on worker threads. The textures
+             * are uploaded when they are first rendered.
+             */
             void prepare(int minFilter, int magFilter);
             void setTextureMode(int minFilter, int magFilter);
+            
+            /**
+             * Adds the thumbnails to the atlas and uploads it if the worker threads have finished creating them.
+             * Textures have no thumbnail until then.
+             */
+            void commitThumbnails();
         private:
+            void startThumbnails();
+
             void incUsageCount();
             void decUsageCount();
         };
@@ -87,6 +87,19 @@ namespace TrenchBroom {
             VectorUtils::append(m_toRemove, collections);
         }
 
+        void TextureManager::setTextureCollections(const TextureCollectionList& collections) {
+            VectorUtils::append(m_toRemove, m_collections);
+            m_collections.clear();
+            m_toPrepare.clear();
+            
+            for (TextureCollection* collection : collections) {
+                addTextureCollection(collection);
+                collection->usageCountDidChange.addObserver(usageCountDidChange);
+            }
+            
+            updateTextures();
+        }
+
         TextureManager::TextureCollectionMap TextureManager::collectionMap() const {
             TextureCollectionMap result;
             for (Assets::TextureCollection* collection : m_collections)
@@ -109,6 +122,7 @@ namespace TrenchBroom {
             
             m_toPrepare.clear();
             m_texturesByName.clear();
+            m_texturesByKey.clear();
             m_textures.clear();
             
             // Remove logging because it might fail when the document is already destroyed.
@@ -123,12 +137,17 @@ namespace TrenchBroom {
         void TextureManager::commitChanges() {
             resetTextureMode();
             prepare();
+            commitThumbnails();
             VectorUtils::clearAndDelete(m_toRemove);
         }
         
         Texture* TextureManager::texture(const String& name) const {
-            TextureMap::const_iterator it = m_texturesByName.find(StringUtils::toLower(name));
-            if (it == std::end(m_texturesByName))
+            return texture(TextureName(name));
+        }
+        
+        Texture* TextureManager::texture(const TextureName& name) const {
+            TextureKeyMap::const_iterator it = m_texturesByKey.find(name.key());
+            if (it == std::end(m_texturesByKey))
                 return NULL;
             return it->second;
         }
@@ -163,13 +182,19 @@ namespace TrenchBroom {
             m_toPrepare.clear();
         }
         
+        void TextureManager::commitThumbnails() {
+            std::for_each(std::begin(m_collections), std::end(m_collections),
+                          [](TextureCollection* collection) { collection->commitThumbnails(); });
+        }
+        
         void TextureManager::updateTextures() {
             m_texturesByName.clear();
+            m_texturesByKey.clear();
             m_textures.clear();
             
             for (TextureCollection* collection : m_collections) {
                 for (Texture* texture : collection->textures()) {
-                    const String key = StringUtils::toLower(texture->name());
+                    const String& key = texture->internedName().key().name();
                     texture->setOverridden(false);
                     
                     TextureMap::iterator mIt = m_texturesByName.find(key);
@@ -183,6 +208,8 @@ namespace TrenchBroom {
             }
 
             m_textures = MapUtils::valueList(m_texturesByName);
+            for (Texture* texture : m_textures)
+                m_texturesByKey.insert(std::make_pair(texture->internedName().key(), texture));
         }
         
         TextureList TextureManager::textureList() const {
@@ -22,10 +22,12 @@
 
 #include "Notifier.h"
 #include "Assets/AssetTypes.h"
+#include "Assets/TextureName.h"
 #include "IO/Path.h"
 #include "Model/ModelTypes.h"
 
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom {
@@ -41,6 +43,7 @@ namespace TrenchBroom {
             typedef std::map<IO::Path, TextureCollection*> TextureCollectionMap;
             typedef std::pair<IO::Path, TextureCollection*> TextureCollectionMapEntry;
             typedef std::map<String, Texture*> TextureMap;
+            typedef std::unordered_map<TextureName, Texture*, TextureName::Hash> TextureKeyMap;
             
             Logger* m_logger;
             
@@ -50,6 +53,7 @@ namespace TrenchBroom {
             TextureCollectionList m_toRemove;
             
             TextureMap m_texturesByName;
+            TextureKeyMap m_texturesByKey;
             TextureList m_textures;
             
             int m_minFilter;
@@ -62,6 +66,12 @@ namespace TrenchBroom {
             ~TextureManager();
 
             void setTextureCollections(const IO::Path::List& paths, IO::TextureLoader& loader);
+            
+            /**
+             * Replaces the current texture collections with the given ones, which have already been read. This
+             * manager takes ownership of the given collections.
+             */
+            void setTextureCollections(const TextureCollectionList& collections);
         private:
             TextureCollectionMap collectionMap() const;
             void addTextureCollection(Assets::TextureCollection* collection);
@@ -72,12 +82,14 @@ namespace TrenchBroom {
             void commitChanges();
             
             Texture* texture(const String& name) const;
+            Texture* texture(const TextureName& name) const;
             const TextureList& textures() const;
             const TextureCollectionList& collections() const;
             const StringList collectionNames() const;
         private:
             void resetTextureMode();
             void prepare();
+            void commitThumbnails();
 
             void updateTextures();
             TextureList textureList() const;
@@ -0,0 +1,100 @@
+/*
+ Copyright (C) 2010-2016 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TextureName.h"
+
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+namespace TrenchBroom {
+    namespace Assets {
+        struct TextureName::Entry {
+            const String* name;
+            const Entry* key;
+            
+            Entry() :
+            name(NULL),
+            key(NULL) {}
+        };
+        
+        class TextureName::Pool {
+        private:
+            typedef std::unordered_map<String, Entry> EntryMap;
+            
+            std::mutex m_mutex;
+            EntryMap m_entries;
+        public:
+            static Pool& instance() {
+                // never destroyed so that static texture names remain valid during shutdown
+                static Pool* pool = new Pool();
+                return *pool;
+            }
+            
+            const Entry* intern(const String& name) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                return doIntern(name);
+            }
+        private:
+            const Entry* doIntern(const String& name) {
+                EntryMap::iterator it = m_entries.find(name);
+                if (it != std::end(m_entries))
+                    return &it->second;
+                
+                // the map never moves its elements, so the entries can point to their keys and each other
+                it = m_entries.insert(std::make_pair(name, Entry())).first;
+                Entry& entry = it->second;
+                entry.name = &it->first;
+                
+                const String lowerName = StringUtils::toLower(name);
+                entry.key = lowerName == name ? &entry : doIntern(lowerName);
+                return &entry;
+            }
+        };
+        
+        size_t TextureName::Hash::operator()(const TextureName& name) const {
+            return std::hash<const Entry*>()(name.m_entry);
+        }
+
+        TextureName::TextureName() :
+        m_entry(Pool::instance().intern("")) {}
+        
+        TextureName::TextureName(const String& name) :
+        m_entry(Pool::instance().intern(name)) {}
+
+        TextureName::TextureName(const Entry* entry) :
+        m_entry(entry) {}
+
+        const String& TextureName::name() const {
+            return *m_entry->name;
+        }
+        
+        TextureName TextureName::key() const {
+            return TextureName(m_entry->key);
+        }
+        
+        bool TextureName::operator==(const TextureName& other) const {
+            return m_entry == other.m_entry;
+        }
+        
+        bool TextureName::operator!=(const TextureName& other) const {
+            return m_entry != other.m_entry;
+        }
+    }
+}
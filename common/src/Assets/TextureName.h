@@ -0,0 +1,61 @@
+/*
+ Copyright (C) 2010-2016 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_TextureName
+#define TrenchBroom_TextureName
+
+#include "StringUtils.h"
+
+#include <cstddef>
+
+namespace TrenchBroom {
+    namespace Assets {
+        /**
+         * An interned texture name. Equal names share a single pooled entry, so copying a texture name only copies
+         * a pointer and comparing two names compares their addresses. Every name refers to its lower case form,
+         * the key, which is used to look up textures regardless of case.
+         *
+         * Interned names are never freed since a map uses only a small number of distinct texture names.
+         */
+        class TextureName {
+        public:
+            struct Hash {
+                size_t operator()(const TextureName& name) const;
+            };
+        private:
+            struct Entry;
+            class Pool;
+            
+            const Entry* m_entry;
+        public:
+            TextureName();
+            explicit TextureName(const String& name);
+            
+            const String& name() const;
+            TextureName key() const;
+            
+            bool operator==(const TextureName& other) const;
+            bool operator!=(const TextureName& other) const;
+        private:
+            explicit TextureName(const Entry* entry);
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_TextureName) */
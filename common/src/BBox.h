@@ -23,6 +23,7 @@
 #include "Mat.h"
 #include "Plane.h"
 #include "Quat.h"
+#include "SIMD.h"
 #include "Vec.h"
 
 #include <algorithm>
@@ -87,8 +88,7 @@ public:
     BBox(const typename Vec<T,S>::List& vertices) {
         assert(vertices.size() > 0);
         min = max = vertices[0];
-        for (size_t i = 0; i < vertices.size(); ++i)
-            mergeWith(vertices[i]);
+        mergeBounds(*this, vertices.data() + 1, vertices.size() - 1);
     }
     
     template <typename I, typename G>
@@ -349,6 +349,96 @@ void eachBBoxEdge(const BBox<T,3>& bbox, Op& op) {
     op(bbox.min + x,     bbox.min + x + z    );
 }
 
+// Merges the given boxes into the given bounds.
+template <typename T, size_t S>
+BBox<T,S>& mergeBounds(BBox<T,S>& bounds, const BBox<T,S>* boxes, const size_t count) {
+    for (size_t i = 0; i < count; ++i)
+        bounds.mergeWith(boxes[i]);
+    return bounds;
+}
+
+// Merges the given points into the given bounds.
+template <typename T, size_t S>
+BBox<T,S>& mergeBounds(BBox<T,S>& bounds, const Vec<T,S>* points, const size_t count) {
+    for (size_t i = 0; i < count; ++i)
+        bounds.mergeWith(points[i]);
+    return bounds;
+}
+
+#ifdef TB_SIMD_SSE2
+// The operands are ordered so that the comparisons match those of std::min and std::max in BBox::mergeWith.
+inline BBox<double,3>& mergeBounds(BBox<double,3>& bounds, const BBox<double,3>* boxes, const size_t count) {
+    __m128d minXY = _mm_loadu_pd(&bounds.min[0]);
+    __m128d minZ  = _mm_load_sd(&bounds.min[2]);
+    __m128d maxXY = _mm_loadu_pd(&bounds.max[0]);
+    __m128d maxZ  = _mm_load_sd(&bounds.max[2]);
+    
+    for (size_t i = 0; i < count; ++i) {
+        minXY = _mm_min_pd(_mm_loadu_pd(&boxes[i].min[0]), minXY);
+        minZ  = _mm_min_sd(_mm_load_sd(&boxes[i].min[2]), minZ);
+        maxXY = _mm_max_pd(_mm_loadu_pd(&boxes[i].max[0]), maxXY);
+        maxZ  = _mm_max_sd(_mm_load_sd(&boxes[i].max[2]), maxZ);
+    }
+    
+    _mm_storeu_pd(&bounds.min[0], minXY);
+    _mm_store_sd(&bounds.min[2], minZ);
+    _mm_storeu_pd(&bounds.max[0], maxXY);
+    _mm_store_sd(&bounds.max[2], maxZ);
+    return bounds;
+}
+
+inline BBox<double,3>& mergeBounds(BBox<double,3>& bounds, const Vec<double,3>* points, const size_t count) {
+    __m128d minXY = _mm_loadu_pd(&bounds.min[0]);
+    __m128d minZ  = _mm_load_sd(&bounds.min[2]);
+    __m128d maxXY = _mm_loadu_pd(&bounds.max[0]);
+    __m128d maxZ  = _mm_load_sd(&bounds.max[2]);
+    
+    for (size_t i = 0; i < count; ++i) {
+        const __m128d xy = _mm_loadu_pd(&points[i][0]);
+        const __m128d z  = _mm_load_sd(&points[i][2]);
+        minXY = _mm_min_pd(xy, minXY);
+        minZ  = _mm_min_sd(z, minZ);
+        maxXY = _mm_max_pd(xy, maxXY);
+        maxZ  = _mm_max_sd(z, maxZ);
+    }
+    
+    _mm_storeu_pd(&bounds.min[0], minXY);
+    _mm_store_sd(&bounds.min[2], minZ);
+    _mm_storeu_pd(&bounds.max[0], maxXY);
+    _mm_store_sd(&bounds.max[2], maxZ);
+    return bounds;
+}
+
+inline BBox<float,3>& mergeBounds(BBox<float,3>& bounds, const BBox<float,3>* boxes, const size_t count) {
+    __m128 min = SIMD::load3(&bounds.min[0]);
+    __m128 max = SIMD::load3(&bounds.max[0]);
+    
+    for (size_t i = 0; i < count; ++i) {
+        min = _mm_min_ps(SIMD::load3(&boxes[i].min[0]), min);
+        max = _mm_max_ps(SIMD::load3(&boxes[i].max[0]), max);
+    }
+    
+    SIMD::store3(&bounds.min[0], min);
+    SIMD::store3(&bounds.max[0], max);
+    return bounds;
+}
+
+inline BBox<float,3>& mergeBounds(BBox<float,3>& bounds, const Vec<float,3>* points, const size_t count) {
+    __m128 min = SIMD::load3(&bounds.min[0]);
+    __m128 max = SIMD::load3(&bounds.max[0]);
+    
+    for (size_t i = 0; i < count; ++i) {
+        const __m128 point = SIMD::load3(&points[i][0]);
+        min = _mm_min_ps(point, min);
+        max = _mm_max_ps(point, max);
+    }
+    
+    SIMD::store3(&bounds.min[0], min);
+    SIMD::store3(&bounds.max[0], max);
+    return bounds;
+}
+#endif
+
 template <typename T>
 typename Vec<T,3>::List bBoxVertices(const BBox<T,3>& bbox) {
     const Vec<T,3> size = bbox.size();
@@ -420,30 +510,26 @@ BBox<T,3> rotateBBox(const BBox<T,3>& bbox, const Quat<T>& rotation, const Vec<T
 }
 
 template <typename T>
-struct TransformBBox {
-    Mat<T,4,4> transformation;
-    bool first;
-    BBox<T,3> bbox;
+struct CollectBBoxVertices {
+    Vec<T,3> vertices[8];
+    size_t count;
     
-    TransformBBox(const Mat<T,4,4>& i_transformation) :
-    transformation(i_transformation),
-    first(true) {}
+    CollectBBoxVertices() :
+    count(0) {}
     
     void operator()(const Vec<T,3>& vertex) {
-        if (first) {
-            bbox.min = bbox.max = transformation * vertex;
-            first = false;
-        } else {
-            bbox.mergeWith(transformation * vertex);
-        }
+        vertices[count++] = vertex;
     }
 };
 
 template <typename T>
 BBox<T,3> rotateBBox(const BBox<T,3>& bbox, const Mat<T,4,4>& transformation) {
-    TransformBBox<T> transformator(transformation);
-    eachBBoxVertex(bbox, transformator);
-    return transformator.bbox;
+    CollectBBoxVertices<T> collector;
+    eachBBoxVertex(bbox, collector);
+    transformPoints(transformation, collector.vertices, collector.count, collector.vertices);
+    
+    BBox<T,3> result(collector.vertices[0], collector.vertices[0]);
+    return mergeBounds(result, collector.vertices + 1, collector.count - 1);
 }
 
 
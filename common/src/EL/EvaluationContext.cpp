@@ -24,13 +24,17 @@
 namespace TrenchBroom {
     namespace EL {
         EvaluationContext::EvaluationContext() :
-        m_store(new VariableTable()) {}
+        m_store(NULL),
+        m_ownStore(new VariableTable()) {
+            m_store = m_ownStore;
+        }
         
         EvaluationContext::EvaluationContext(const VariableStore& store) :
-        m_store(store.clone()) {}
+        m_store(&store),
+        m_ownStore(NULL) {}
         
         EvaluationContext::~EvaluationContext() {
-            delete m_store;
+            delete m_ownStore;
         }
         
         Value EvaluationContext::variableValue(const String& name) const {
@@ -38,7 +42,11 @@ namespace TrenchBroom {
         }
         
         void EvaluationContext::declareVariable(const String& name, const Value& value) {
-            m_store->declare(name, value);
+            if (m_ownStore == NULL) {
+                m_ownStore = m_store->clone();
+                m_store = m_ownStore;
+            }
+            m_ownStore->declare(name, value);
         }
         
         EvaluationStack::EvaluationStack(const EvaluationContext& next) :
@@ -28,7 +28,9 @@ namespace TrenchBroom {
         
         class EvaluationContext {
         private:
-            VariableStore* m_store;
+            // the given store is only cloned when a variable is declared
+            const VariableStore* m_store;
+            VariableStore* m_ownStore;
         public:
             EvaluationContext();
             EvaluationContext(const VariableStore& store);
@@ -36,6 +38,9 @@ namespace TrenchBroom {
             
             virtual Value variableValue(const String& name) const;
             virtual void declareVariable(const String& name, const Value& value = Value::Undefined);
+        private:
+            EvaluationContext(const EvaluationContext& other);
+            EvaluationContext& operator=(const EvaluationContext& other);
         };
         
         class EvaluationStack : public EvaluationContext {
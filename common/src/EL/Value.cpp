@@ -25,11 +25,17 @@
 
 #include <algorithm>
 #include <iterator>
+#include <new>
 
 namespace TrenchBroom {
     namespace EL {
         ValueHolder::~ValueHolder() {}
         
+        ValueHolder* ValueHolder::cloneInto(void* storage) const {
+            ensure(false, "value cannot be stored in place");
+            return NULL;
+        }
+        
         String ValueHolder::describe() const {
             StringStream str;
             appendToStream(str, false, "");
@@ -86,6 +92,7 @@ namespace TrenchBroom {
         }
         
         ValueHolder* BooleanValueHolder::clone() const { return new BooleanValueHolder(m_value); }
+        ValueHolder* BooleanValueHolder::cloneInto(void* storage) const { return new (storage) BooleanValueHolder(m_value); }
         void BooleanValueHolder::appendToStream(std::ostream& str, const bool multiline, const String& indent) const { str << (m_value ? "true" : "false"); }
         
         StringHolder::~StringHolder() {}
@@ -155,12 +162,14 @@ namespace TrenchBroom {
         
         StringValueHolder::StringValueHolder(const StringType& value) : m_value(value) {}
         ValueHolder* StringValueHolder::clone() const { return new StringValueHolder(m_value); }
+        ValueHolder* StringValueHolder::cloneInto(void* storage) const { return new (storage) StringValueHolder(m_value); }
         const StringType& StringValueHolder::doGetValue() const { return m_value; }
 
         
         
         StringReferenceHolder::StringReferenceHolder(const StringType& value) : m_value(value) {}
         ValueHolder* StringReferenceHolder::clone() const { return new StringReferenceHolder(m_value); }
+        ValueHolder* StringReferenceHolder::cloneInto(void* storage) const { return new (storage) StringReferenceHolder(m_value); }
         const StringType& StringReferenceHolder::doGetValue() const { return m_value; }
         
         
@@ -207,6 +216,7 @@ namespace TrenchBroom {
         }
         
         ValueHolder* NumberValueHolder::clone() const { return new NumberValueHolder(m_value); }
+        ValueHolder* NumberValueHolder::cloneInto(void* storage) const { return new (storage) NumberValueHolder(m_value); }
         void NumberValueHolder::appendToStream(std::ostream& str, const bool multiline, const String& indent) const {
             if (Math::isInteger(m_value)) {
                 str.precision(0);
@@ -464,6 +474,7 @@ namespace TrenchBroom {
         }
         
         ValueHolder* NullValueHolder::clone() const { return new NullValueHolder(); }
+        ValueHolder* NullValueHolder::cloneInto(void* storage) const { return new (storage) NullValueHolder(); }
         void NullValueHolder::appendToStream(std::ostream& str, const bool multiline, const String& indent) const { str << "null"; }
         
         
@@ -472,47 +483,88 @@ namespace TrenchBroom {
         bool UndefinedValueHolder::convertibleTo(const ValueType toType) const { return false; }
         ValueHolder* UndefinedValueHolder::convertTo(const ValueType toType) const { throw ConversionError(describe(), type(), toType); }
         ValueHolder* UndefinedValueHolder::clone() const { return new UndefinedValueHolder(); }
+        ValueHolder* UndefinedValueHolder::cloneInto(void* storage) const { return new (storage) UndefinedValueHolder(); }
         void UndefinedValueHolder::appendToStream(std::ostream& str, const bool multiline, const String& indent) const { str << "undefined"; }
         
         
-        const Value Value::Null = Value(new NullValueHolder(), 0, 0);
+        static_assert(sizeof(BooleanValueHolder) <= sizeof(StringValueHolder), "boolean holder must fit in place");
+        static_assert(sizeof(NumberValueHolder) <= sizeof(StringValueHolder), "number holder must fit in place");
+        static_assert(sizeof(StringReferenceHolder) <= sizeof(StringValueHolder), "string reference holder must fit in place");
+        static_assert(sizeof(NullValueHolder) <= sizeof(StringValueHolder), "null holder must fit in place");
+        static_assert(sizeof(UndefinedValueHolder) <= sizeof(StringValueHolder), "undefined holder must fit in place");
+        
+        const Value Value::Null = Value();
         const Value Value::Undefined = Value(new UndefinedValueHolder(), 0, 0);
         
-        Value::Value(ValueHolder* holder, const size_t line, const size_t column)      : m_value(holder), m_line(line), m_column(column) {}
+        Value::Value(ValueHolder* holder, const size_t line, const size_t column)      : m_shared(holder), m_value(holder), m_line(line), m_column(column) {}
+        
+        Value::Value(const BooleanType& value, const size_t line, const size_t column) : m_value(new (&m_storage) BooleanValueHolder(value)), m_line(line), m_column(column) {}
+        Value::Value(const BooleanType& value)                                         : m_value(new (&m_storage) BooleanValueHolder(value)), m_line(0), m_column(0) {}
+        
+        Value::Value(const StringType& value, const size_t line, const size_t column)  : m_value(createStringHolder(value)), m_line(line), m_column(column) {}
+        Value::Value(const StringType& value)                                          : m_value(createStringHolder(value)), m_line(0), m_column(0) {}
+        
+        Value::Value(const char* value, const size_t line, const size_t column)        : m_value(createStringHolder(String(value))), m_line(line), m_column(column) {}
+        Value::Value(const char* value)                                                : m_value(createStringHolder(String(value))), m_line(0), m_column(0) {}
+        
+        Value::Value(const NumberType& value, const size_t line, const size_t column)  : m_value(new (&m_storage) NumberValueHolder(value)), m_line(line), m_column(column) {}
+        Value::Value(const NumberType& value)                                          : m_value(new (&m_storage) NumberValueHolder(value)), m_line(0), m_column(0) {}
         
-        Value::Value(const BooleanType& value, const size_t line, const size_t column) : m_value(new BooleanValueHolder(value)), m_line(line), m_column(column) {}
-        Value::Value(const BooleanType& value)                                         : m_value(new BooleanValueHolder(value)), m_line(0), m_column(0) {}
+        Value::Value(const int value, const size_t line, const size_t column)          : m_value(new (&m_storage) NumberValueHolder(static_cast<NumberType>(value))), m_line(line), m_column(column) {}
+        Value::Value(const int value)                                                  : m_value(new (&m_storage) NumberValueHolder(static_cast<NumberType>(value))), m_line(0), m_column(0) {}
         
-        Value::Value(const StringType& value, const size_t line, const size_t column)  : m_value(new StringValueHolder(value)), m_line(line), m_column(column) {}
-        Value::Value(const StringType& value)                                          : m_value(new StringValueHolder(value)), m_line(0), m_column(0) {}
+        Value::Value(const long value, const size_t line, const size_t column)         : m_value(new (&m_storage) NumberValueHolder(static_cast<NumberType>(value))), m_line(line), m_column(column) {}
+        Value::Value(const long value)                                                 : m_value(new (&m_storage) NumberValueHolder(static_cast<NumberType>(value))), m_line(0), m_column(0) {}
         
-        Value::Value(const char* value, const size_t line, const size_t column)        : m_value(new StringValueHolder(String(value))), m_line(line), m_column(column) {}
-        Value::Value(const char* value)                                                : m_value(new StringValueHolder(String(value))), m_line(0), m_column(0) {}
+        Value::Value(const size_t value, const size_t line, const size_t column)       : m_value(new (&m_storage) NumberValueHolder(static_cast<NumberType>(value))), m_line(line), m_column(column) {}
+        Value::Value(const size_t value)                                               : m_value(new (&m_storage) NumberValueHolder(static_cast<NumberType>(value))), m_line(0), m_column(0) {}
         
-        Value::Value(const NumberType& value, const size_t line, const size_t column)  : m_value(new NumberValueHolder(value)), m_line(line), m_column(column) {}
-        Value::Value(const NumberType& value)                                          : m_value(new NumberValueHolder(value)), m_line(0), m_column(0) {}
+        Value::Value(const ArrayType& value, const size_t line, const size_t column)   : m_shared(new ArrayValueHolder(value)), m_value(m_shared.get()), m_line(line), m_column(column) {}
+        Value::Value(const ArrayType& value)                                           : m_shared(new ArrayValueHolder(value)), m_value(m_shared.get()), m_line(0), m_column(0) {}
         
-        Value::Value(const int value, const size_t line, const size_t column)          : m_value(new NumberValueHolder(static_cast<NumberType>(value))), m_line(line), m_column(column) {}
-        Value::Value(const int value)                                                  : m_value(new NumberValueHolder(static_cast<NumberType>(value))), m_line(0), m_column(0) {}
+        Value::Value(const MapType& value, const size_t line, const size_t column)     : m_shared(new MapValueHolder(value)), m_value(m_shared.get()), m_line(line), m_column(column) {}
+        Value::Value(const MapType& value)                                             : m_shared(new MapValueHolder(value)), m_value(m_shared.get()), m_line(0), m_column(0) {}
         
-        Value::Value(const long value, const size_t line, const size_t column)         : m_value(new NumberValueHolder(static_cast<NumberType>(value))), m_line(line), m_column(column) {}
-        Value::Value(const long value)                                                 : m_value(new NumberValueHolder(static_cast<NumberType>(value))), m_line(0), m_column(0) {}
+        Value::Value(const RangeType& value, const size_t line, const size_t column)   : m_shared(new RangeValueHolder(value)), m_value(m_shared.get()), m_line(line), m_column(column) {}
+        Value::Value(const RangeType& value)                                           : m_shared(new RangeValueHolder(value)), m_value(m_shared.get()), m_line(0), m_column(0) {}
         
-        Value::Value(const size_t value, const size_t line, const size_t column)       : m_value(new NumberValueHolder(static_cast<NumberType>(value))), m_line(line), m_column(column) {}
-        Value::Value(const size_t value)                                               : m_value(new NumberValueHolder(static_cast<NumberType>(value))), m_line(0), m_column(0) {}
+        Value::Value(const Value& other, const size_t line, const size_t column)       : m_shared(other.m_shared), m_value(copyHolder(other)), m_line(line), m_column(column) {}
+        Value::Value(const Value& other)                                               : m_shared(other.m_shared), m_value(copyHolder(other)), m_line(other.m_line), m_column(other.m_column) {}
         
-        Value::Value(const ArrayType& value, const size_t line, const size_t column)   : m_value(new ArrayValueHolder(value)), m_line(line), m_column(column) {}
-        Value::Value(const ArrayType& value)                                           : m_value(new ArrayValueHolder(value)), m_line(0), m_column(0) {}
+        Value::Value()                                                                 : m_value(new (&m_storage) NullValueHolder()), m_line(0), m_column(0) {}
         
-        Value::Value(const MapType& value, const size_t line, const size_t column)     : m_value(new MapValueHolder(value)), m_line(line), m_column(column) {}
-        Value::Value(const MapType& value)                                             : m_value(new MapValueHolder(value)), m_line(0), m_column(0) {}
+        Value::~Value() {
+            destroyHolder();
+        }
         
-        Value::Value(const RangeType& value, const size_t line, const size_t column)   : m_value(new RangeValueHolder(value)), m_line(line), m_column(column) {}
-        Value::Value(const RangeType& value)                                           : m_value(new RangeValueHolder(value)), m_line(0), m_column(0) {}
+        Value& Value::operator=(const Value& other) {
+            if (this != &other) {
+                destroyHolder();
+                m_shared = other.m_shared;
+                m_value = copyHolder(other);
+                m_line = other.m_line;
+                m_column = other.m_column;
+            }
+            return *this;
+        }
         
-        Value::Value(const Value& other, const size_t line, const size_t column)       : m_value(other.m_value), m_line(line), m_column(column) {}
+        ValueHolder* Value::createStringHolder(const StringType& value) {
+            if (value.size() <= MaxInlineStringLength)
+                return new (&m_storage) StringValueHolder(value);
+            m_shared.reset(new StringValueHolder(value));
+            return m_shared.get();
+        }
         
-        Value::Value()                                                                 : m_value(new NullValueHolder()), m_line(0), m_column(0) {}
+        ValueHolder* Value::copyHolder(const Value& other) {
+            if (m_shared.get() != NULL)
+                return m_shared.get();
+            return other.m_value->cloneInto(&m_storage);
+        }
+        
+        void Value::destroyHolder() {
+            if (m_shared.get() == NULL)
+                m_value->~ValueHolder();
+        }
         
         Value Value::ref(const StringType& value, const size_t line, const size_t column) {
             return Value(new StringReferenceHolder(value), line, column);
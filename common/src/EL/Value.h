@@ -26,6 +26,8 @@
 
 #include <algorithm>
 #include <iterator>
+#include <memory>
+#include <type_traits>
 
 namespace TrenchBroom {
     namespace EL {
@@ -49,6 +51,7 @@ namespace TrenchBroom {
             virtual ValueHolder* convertTo(ValueType toType) const = 0;
             
             virtual ValueHolder* clone() const = 0;
+            virtual ValueHolder* cloneInto(void* storage) const;
             
             virtual void appendToStream(std::ostream& str, bool multiline, const String& indent) const = 0;
         };
@@ -64,6 +67,7 @@ namespace TrenchBroom {
             bool convertibleTo(ValueType toType) const;
             ValueHolder* convertTo(ValueType toType) const;
             ValueHolder* clone() const;
+            ValueHolder* cloneInto(void* storage) const;
             void appendToStream(std::ostream& str, bool multiline, const String& indent) const;
         };
 
@@ -87,6 +91,7 @@ namespace TrenchBroom {
         public:
             StringValueHolder(const StringType& value);
             ValueHolder* clone() const;
+            ValueHolder* cloneInto(void* storage) const;
         private:
             const StringType& doGetValue() const;
         };
@@ -97,6 +102,7 @@ namespace TrenchBroom {
         public:
             StringReferenceHolder(const StringType& value);
             ValueHolder* clone() const;
+            ValueHolder* cloneInto(void* storage) const;
         private:
             const StringType& doGetValue() const;
         };
@@ -112,6 +118,7 @@ namespace TrenchBroom {
             bool convertibleTo(ValueType toType) const;
             ValueHolder* convertTo(ValueType toType) const;
             ValueHolder* clone() const;
+            ValueHolder* cloneInto(void* storage) const;
             void appendToStream(std::ostream& str, bool multiline, const String& indent) const;
         };
         
@@ -169,6 +176,7 @@ namespace TrenchBroom {
             bool convertibleTo(ValueType toType) const;
             ValueHolder* convertTo(ValueType toType) const;
             ValueHolder* clone() const;
+            ValueHolder* cloneInto(void* storage) const;
             void appendToStream(std::ostream& str, bool multiline, const String& indent) const;
         };
         
@@ -179,6 +187,7 @@ namespace TrenchBroom {
             bool convertibleTo(ValueType toType) const;
             ValueHolder* convertTo(ValueType toType) const;
             ValueHolder* clone() const;
+            ValueHolder* cloneInto(void* storage) const;
             void appendToStream(std::ostream& str, bool multiline, const String& indent) const;
         };
         
@@ -190,7 +199,17 @@ namespace TrenchBroom {
         private:
             typedef std::vector<size_t> IndexList;
             typedef std::shared_ptr<ValueHolder> ValuePtr;
-            ValuePtr m_value;
+            
+            /*
+             Booleans, numbers, null and short strings are stored in place, so creating and copying them does
+             not allocate. Longer strings, arrays, maps and ranges are shared between copies.
+             */
+            static const size_t MaxInlineStringLength = 15;
+            typedef std::aligned_storage<sizeof(StringValueHolder)>::type InlineStorage;
+            
+            InlineStorage m_storage;
+            ValuePtr m_shared;
+            ValueHolder* m_value;
             size_t m_line;
             size_t m_column;
         private:
@@ -222,13 +241,15 @@ namespace TrenchBroom {
             
             template <typename T>
             Value(const std::vector<T>& value, size_t line, size_t column) :
-            m_value(new ArrayValueHolder(makeArray(value))),
+            m_shared(new ArrayValueHolder(makeArray(value))),
+            m_value(m_shared.get()),
             m_line(line),
             m_column(column){}
             
             template <typename T>
             explicit Value(const std::vector<T>& value) :
-            m_value(new ArrayValueHolder(makeArray(value))),
+            m_shared(new ArrayValueHolder(makeArray(value))),
+            m_value(m_shared.get()),
             m_line(0),
             m_column(0) {}
             
@@ -237,13 +258,15 @@ namespace TrenchBroom {
             
             template <typename T, typename C>
             Value(const std::map<String, T, C>& value, size_t line, size_t column) :
-            m_value(new MapValueHolder(makeMap(value))),
+            m_shared(new MapValueHolder(makeMap(value))),
+            m_value(m_shared.get()),
             m_line(line),
             m_column(column) {}
             
             template <typename T, typename C>
             explicit Value(const std::map<String, T, C>& value) :
-            m_value(new MapValueHolder(makeMap(value))),
+            m_shared(new MapValueHolder(makeMap(value))),
+            m_value(m_shared.get()),
             m_line(0),
             m_column(0) {}
             
@@ -251,12 +274,20 @@ namespace TrenchBroom {
             explicit Value(const RangeType& value);
             
             Value(const Value& other, size_t line, size_t column);
+            Value(const Value& other);
             
             Value();
+            ~Value();
+            
+            Value& operator=(const Value& other);
             
             static Value ref(const StringType& value, size_t line, size_t column);
             static Value ref(const StringType& value);
         private:
+            ValueHolder* createStringHolder(const StringType& value);
+            ValueHolder* copyHolder(const Value& other);
+            void destroyHolder();
+            
             template <typename T>
             ArrayType makeArray(const std::vector<T>& value) {
                 ArrayType result;
@@ -0,0 +1,46 @@
+/*
+ Copyright (C) 2010-2016 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_BinaryNodeFormat
+#define TrenchBroom_BinaryNodeFormat
+
+namespace TrenchBroom {
+    namespace IO {
+        /**
+         * Layout of the binary node data used to copy and paste within TrenchBroom. The data starts with
+         * the magic string, the version, the map format, the content type and the number of top level
+         * records. Numbers are stored in native byte order, strings are prefixed with their length.
+         */
+        namespace BinaryNodeFormat {
+            static const char Magic[] = "TBNODES";
+            static const unsigned char Version = 1;
+            
+            typedef unsigned char Content;
+            static const Content Content_Nodes      = 0;
+            static const Content Content_BrushFaces = 1;
+            
+            typedef unsigned char Record;
+            static const Record Record_Group  = 0;
+            static const Record Record_Entity = 1;
+            static const Record Record_Brush  = 2;
+        }
+    }
+}
+
+#endif /* defined(TrenchBroom_BinaryNodeFormat) */
@@ -0,0 +1,210 @@
+/*
+ Copyright (C) 2010-2016 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BinaryNodeReader.h"
+
+#include "CollectionUtils.h"
+#include "Ensure.h"
+#include "IO/ParserStatus.h"
+#include "Model/Brush.h"
+#include "Model/BrushFace.h"
+#include "Model/BrushFaceAttributes.h"
+#include "Model/Entity.h"
+#include "Model/Group.h"
+#include "Model/ModelFactory.h"
+
+#include <cstdint>
+#include <cstring>
+
+namespace TrenchBroom {
+    namespace IO {
+        bool BinaryNodeReader::isBinaryNodeData(const String& data) {
+            const size_t magicLength = std::strlen(BinaryNodeFormat::Magic);
+            return data.size() > magicLength && data.compare(0, magicLength, BinaryNodeFormat::Magic) == 0;
+        }
+        
+        Model::NodeList BinaryNodeReader::readNodes(const String& data, Model::ModelFactory* factory, const BBox3& worldBounds, ParserStatus& status) {
+            BinaryNodeReader reader(data, factory, BinaryNodeFormat::Content_Nodes);
+            
+            Model::NodeList result;
+            result.reserve(reader.m_count);
+            try {
+                for (size_t i = 0; i < reader.m_count; ++i) {
+                    Model::Node* node = reader.readNode(worldBounds, status);
+                    if (node != NULL)
+                        result.push_back(node);
+                }
+            } catch (...) {
+                VectorUtils::clearAndDelete(result);
+                throw;
+            }
+            return result;
+        }
+        
+        Model::BrushFaceList BinaryNodeReader::readBrushFaces(const String& data, Model::ModelFactory* factory) {
+            BinaryNodeReader reader(data, factory, BinaryNodeFormat::Content_BrushFaces);
+            
+            Model::BrushFaceList result;
+            result.reserve(reader.m_count);
+            try {
+                for (size_t i = 0; i < reader.m_count; ++i)
+                    result.push_back(reader.readBrushFace());
+            } catch (...) {
+                VectorUtils::clearAndDelete(result);
+                throw;
+            }
+            return result;
+        }
+        
+        BinaryNodeReader::BinaryNodeReader(const String& data, Model::ModelFactory* factory, const BinaryNodeFormat::Content content) :
+        m_reader(data.data(), data.data() + data.size()),
+        m_factory(factory),
+        m_content(content),
+        m_count(0) {
+            ensure(m_factory != NULL, "factory is null");
+            
+            if (!isBinaryNodeData(data))
+                throw ParserException("Data is not binary node data");
+            m_reader.seekFromBegin(std::strlen(BinaryNodeFormat::Magic));
+            
+            const unsigned char version = read<unsigned char>();
+            if (version != BinaryNodeFormat::Version)
+                throw ParserException() << "Unsupported binary node data version " << static_cast<unsigned int>(version);
+            
+            const Model::MapFormat::Type format = static_cast<Model::MapFormat::Type>(read<uint32_t>());
+            if (format != m_factory->format())
+                throw ParserException("Binary node data was written for map format " + Model::formatName(format));
+            
+            if (read<BinaryNodeFormat::Content>() != m_content)
+                throw ParserException("Binary node data has unexpected content");
+            m_count = readCount();
+        }
+        
+        Model::Node* BinaryNodeReader::readNode(const BBox3& worldBounds, ParserStatus& status) {
+            const BinaryNodeFormat::Record record = read<BinaryNodeFormat::Record>();
+            switch (record) {
+                case BinaryNodeFormat::Record_Group:
+                    return readGroup(worldBounds, status);
+                case BinaryNodeFormat::Record_Entity:
+                    return readEntity(worldBounds, status);
+                case BinaryNodeFormat::Record_Brush:
+                    return readBrush(worldBounds, status);
+                default:
+                    throw ParserException() << "Unknown binary node record " << static_cast<unsigned int>(record);
+            }
+        }
+        
+        Model::Group* BinaryNodeReader::readGroup(const BBox3& worldBounds, ParserStatus& status) {
+            Model::Group* group = m_factory->createGroup(readString());
+            readChildren(group, worldBounds, status);
+            return group;
+        }
+        
+        Model::Entity* BinaryNodeReader::readEntity(const BBox3& worldBounds, ParserStatus& status) {
+            Model::EntityAttribute::List attributes;
+            const size_t attributeCount = readCount();
+            for (size_t i = 0; i < attributeCount; ++i) {
+                const String name = readString();
+                const String value = readString();
+                attributes.push_back(Model::EntityAttribute(name, value));
+            }
+            
+            Model::Entity* entity = m_factory->createEntity();
+            entity->setAttributes(attributes);
+            readChildren(entity, worldBounds, status);
+            return entity;
+        }
+        
+        void BinaryNodeReader::readChildren(Model::Node* parent, const BBox3& worldBounds, ParserStatus& status) {
+            try {
+                const size_t childCount = readCount();
+                for (size_t i = 0; i < childCount; ++i) {
+                    Model::Node* child = readNode(worldBounds, status);
+                    if (child != NULL)
+                        parent->addChild(child);
+                }
+            } catch (...) {
+                delete parent;
+                throw;
+            }
+        }
+        
+        Model::Brush* BinaryNodeReader::readBrush(const BBox3& worldBounds, ParserStatus& status) {
+            Model::BrushFaceList faces;
+            try {
+                const size_t faceCount = readCount();
+                faces.reserve(faceCount);
+                for (size_t i = 0; i < faceCount; ++i)
+                    faces.push_back(readBrushFace());
+            } catch (...) {
+                VectorUtils::clearAndDelete(faces);
+                throw;
+            }
+            
+            try {
+                return m_factory->createBrush(worldBounds, faces);
+            } catch (GeometryException& e) {
+                // the faces will have been deleted by the brush's constructor
+                StringStream msg;
+                msg << "Skipping brush: " << e.what();
+                status.error(0, msg.str());
+                return NULL;
+            }
+        }
+        
+        Model::BrushFace* BinaryNodeReader::readBrushFace() {
+            const Vec3 point1 = readVec();
+            const Vec3 point2 = readVec();
+            const Vec3 point3 = readVec();
+            
+            Model::BrushFaceAttributes attribs(readString());
+            attribs.setXOffset(read<float>());
+            attribs.setYOffset(read<float>());
+            attribs.setRotation(read<float>());
+            attribs.setXScale(read<float>());
+            attribs.setYScale(read<float>());
+            attribs.setSurfaceContents(static_cast<int>(read<int32_t>()));
+            attribs.setSurfaceFlags(static_cast<int>(read<int32_t>()));
+            attribs.setSurfaceValue(read<float>());
+            
+            const Vec3 texAxisX = readVec();
+            const Vec3 texAxisY = readVec();
+            
+            return m_factory->createFace(point1, point2, point3, attribs, texAxisX, texAxisY);
+        }
+        
+        size_t BinaryNodeReader::readCount() {
+            return static_cast<size_t>(read<uint32_t>());
+        }
+        
+        String BinaryNodeReader::readString() {
+            const size_t length = readCount();
+            if (!m_reader.canRead(length))
+                throw ParserException("Unexpected end of binary node data");
+            return m_reader.readString(length);
+        }
+        
+        Vec3 BinaryNodeReader::readVec() {
+            const double x = read<double>();
+            const double y = read<double>();
+            const double z = read<double>();
+            return Vec3(x, y, z);
+        }
+    }
+}
@@ -0,0 +1,79 @@
+/*
+ Copyright (C) 2010-2016 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_BinaryNodeReader
+#define TrenchBroom_BinaryNodeReader
+
+#include "Exceptions.h"
+#include "StringUtils.h"
+#include "TrenchBroom.h"
+#include "VecMath.h"
+#include "IO/BinaryNodeFormat.h"
+#include "IO/CharArrayReader.h"
+#include "Model/ModelTypes.h"
+
+namespace TrenchBroom {
+    namespace Model {
+        class ModelFactory;
+    }
+    
+    namespace IO {
+        class ParserStatus;
+        
+        /**
+         * Reads data written by BinaryNodeWriter. Throws a ParserException if the data is malformed or if it
+         * was written for a map format other than the format of the given factory. Brushes whose geometry
+         * cannot be built are skipped and reported to the parser status, like the text map reader does.
+         */
+        class BinaryNodeReader {
+        private:
+            CharArrayReader m_reader;
+            Model::ModelFactory* m_factory;
+            BinaryNodeFormat::Content m_content;
+            size_t m_count;
+        public:
+            static bool isBinaryNodeData(const String& data);
+            
+            static Model::NodeList readNodes(const String& data, Model::ModelFactory* factory, const BBox3& worldBounds, ParserStatus& status);
+            static Model::BrushFaceList readBrushFaces(const String& data, Model::ModelFactory* factory);
+        private:
+            BinaryNodeReader(const String& data, Model::ModelFactory* factory, BinaryNodeFormat::Content content);
+            
+            Model::Node* readNode(const BBox3& worldBounds, ParserStatus& status);
+            Model::Group* readGroup(const BBox3& worldBounds, ParserStatus& status);
+            Model::Entity* readEntity(const BBox3& worldBounds, ParserStatus& status);
+            void readChildren(Model::Node* parent, const BBox3& worldBounds, ParserStatus& status);
+            Model::Brush* readBrush(const BBox3& worldBounds, ParserStatus& status);
+            Model::BrushFace* readBrushFace();
+            
+            size_t readCount();
+            String readString();
+            Vec3 readVec();
+            
+            template <typename T>
+            T read() {
+                if (!m_reader.canRead(sizeof(T)))
+                    throw ParserException("Unexpected end of binary node data");
+                return m_reader.read<T,T>();
+            }
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_BinaryNodeReader) */
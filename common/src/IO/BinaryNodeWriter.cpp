@@ -0,0 +1,213 @@
+/*
+ Copyright (C) 2010-2016 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BinaryNodeWriter.h"
+
+#include "Model/Brush.h"
+#include "Model/BrushFace.h"
+#include "Model/Entity.h"
+#include "Model/Group.h"
+#include "Model/NodeVisitor.h"
+
+#include <cstdint>
+#include <cstring>
+
+namespace TrenchBroom {
+    namespace IO {
+        class BinaryNodeWriter::CollectNodes : public Model::NodeVisitor {
+        private:
+            class VisitParent : public Model::NodeVisitor {
+            private:
+                Model::Brush* m_brush;
+                EntityBrushesMap& m_entityBrushes;
+                Model::BrushList& m_worldBrushes;
+            public:
+                VisitParent(Model::Brush* brush, EntityBrushesMap& entityBrushes, Model::BrushList& worldBrushes) :
+                m_brush(brush),
+                m_entityBrushes(entityBrushes),
+                m_worldBrushes(worldBrushes) {}
+            private:
+                void doVisit(Model::World* world)   { m_worldBrushes.push_back(m_brush); }
+                void doVisit(Model::Layer* layer)   { m_worldBrushes.push_back(m_brush); }
+                void doVisit(Model::Group* group)   { m_worldBrushes.push_back(m_brush); }
+                void doVisit(Model::Entity* entity) { m_entityBrushes[entity].push_back(m_brush); }
+                void doVisit(Model::Brush* brush)   {}
+            };
+            
+            Model::BrushList m_worldBrushes;
+            EntityBrushesMap m_entityBrushes;
+            Model::GroupList m_groups;
+            Model::EntityList m_entities;
+        public:
+            const Model::BrushList& worldBrushes() const { return m_worldBrushes; }
+            const EntityBrushesMap& entityBrushes() const { return m_entityBrushes; }
+            const Model::GroupList& groups() const { return m_groups; }
+            const Model::EntityList& entities() const { return m_entities; }
+            
+            size_t count() const {
+                return m_worldBrushes.size() + m_entityBrushes.size() + m_groups.size() + m_entities.size();
+            }
+        private:
+            void doVisit(Model::World* world)   {}
+            void doVisit(Model::Layer* layer)   {}
+            void doVisit(Model::Group* group)   { m_groups.push_back(group); }
+            void doVisit(Model::Entity* entity) { m_entities.push_back(entity); }
+            
+            void doVisit(Model::Brush* brush)   {
+                Model::Node* parent = brush->parent();
+                if (parent == NULL) {
+                    m_worldBrushes.push_back(brush);
+                } else {
+                    VisitParent visitParent(brush, m_entityBrushes, m_worldBrushes);
+                    parent->accept(visitParent);
+                }
+            }
+        };
+        
+        class BinaryNodeWriter::WriteNode : public Model::ConstNodeVisitor {
+        private:
+            BinaryNodeWriter& m_writer;
+        public:
+            WriteNode(BinaryNodeWriter& writer) :
+            m_writer(writer) {}
+        private:
+            void doVisit(const Model::World* world)   {}
+            void doVisit(const Model::Layer* layer)   {}
+            void doVisit(const Model::Group* group)   { m_writer.writeGroup(group); }
+            void doVisit(const Model::Entity* entity) { m_writer.writeEntity(entity); }
+            void doVisit(const Model::Brush* brush)   { m_writer.writeBrush(brush); }
+        };
+        
+        String BinaryNodeWriter::writeNodes(const Model::MapFormat::Type format, const Model::NodeList& nodes) {
+            CollectNodes collect;
+            Model::Node::accept(std::begin(nodes), std::end(nodes), collect);
+            
+            BinaryNodeWriter writer(format, BinaryNodeFormat::Content_Nodes, collect.count());
+            for (const Model::Brush* brush : collect.worldBrushes())
+                writer.writeBrush(brush);
+            for (const auto& entry : collect.entityBrushes())
+                writer.writeEntity(entry.first, entry.second);
+            for (const Model::Group* group : collect.groups())
+                writer.writeGroup(group);
+            for (const Model::Entity* entity : collect.entities())
+                writer.writeEntity(entity);
+            return writer.m_data;
+        }
+        
+        String BinaryNodeWriter::writeBrushFaces(const Model::MapFormat::Type format, const Model::BrushFaceList& faces) {
+            BinaryNodeWriter writer(format, BinaryNodeFormat::Content_BrushFaces, faces.size());
+            for (const Model::BrushFace* face : faces)
+                writer.writeBrushFace(face);
+            return writer.m_data;
+        }
+        
+        BinaryNodeWriter::BinaryNodeWriter(const Model::MapFormat::Type format, const BinaryNodeFormat::Content content, const size_t count) {
+            m_data.append(BinaryNodeFormat::Magic, std::strlen(BinaryNodeFormat::Magic));
+            write<unsigned char>(BinaryNodeFormat::Version);
+            write<uint32_t>(static_cast<uint32_t>(format));
+            write<BinaryNodeFormat::Content>(content);
+            writeCount(count);
+        }
+        
+        void BinaryNodeWriter::writeGroup(const Model::Group* group) {
+            write<BinaryNodeFormat::Record>(BinaryNodeFormat::Record_Group);
+            writeString(group->name());
+            
+            const Model::NodeList& children = group->children();
+            writeCount(children.size());
+            
+            WriteNode visitor(*this);
+            Model::Node::accept(std::begin(children), std::end(children), visitor);
+        }
+        
+        void BinaryNodeWriter::writeEntity(const Model::Entity* entity) {
+            writeAttributes(entity);
+            
+            const Model::NodeList& children = entity->children();
+            writeCount(children.size());
+            
+            WriteNode visitor(*this);
+            Model::Node::accept(std::begin(children), std::end(children), visitor);
+        }
+        
+        void BinaryNodeWriter::writeEntity(const Model::Entity* entity, const Model::BrushList& brushes) {
+            writeAttributes(entity);
+            
+            writeCount(brushes.size());
+            for (const Model::Brush* brush : brushes)
+                writeBrush(brush);
+        }
+        
+        void BinaryNodeWriter::writeAttributes(const Model::Entity* entity) {
+            write<BinaryNodeFormat::Record>(BinaryNodeFormat::Record_Entity);
+            
+            const Model::EntityAttribute::List& attributes = entity->attributes();
+            writeCount(attributes.size());
+            for (const Model::EntityAttribute& attribute : attributes) {
+                writeString(attribute.name());
+                writeString(attribute.value());
+            }
+        }
+        
+        void BinaryNodeWriter::writeBrush(const Model::Brush* brush) {
+            write<BinaryNodeFormat::Record>(BinaryNodeFormat::Record_Brush);
+            
+            const Model::BrushFaceList& faces = brush->faces();
+            writeCount(faces.size());
+            for (const Model::BrushFace* face : faces)
+                writeBrushFace(face);
+        }
+        
+        void BinaryNodeWriter::writeBrushFace(const Model::BrushFace* face) {
+            const Model::BrushFace::Points& points = face->points();
+            writeVec(points[0]);
+            writeVec(points[1]);
+            writeVec(points[2]);
+            
+            const Model::BrushFaceAttributes& attribs = face->attribs();
+            writeString(attribs.textureName());
+            write<float>(attribs.xOffset());
+            write<float>(attribs.yOffset());
+            write<float>(attribs.rotation());
+            write<float>(attribs.xScale());
+            write<float>(attribs.yScale());
+            write<int32_t>(static_cast<int32_t>(attribs.surfaceContents()));
+            write<int32_t>(static_cast<int32_t>(attribs.surfaceFlags()));
+            write<float>(attribs.surfaceValue());
+            
+            writeVec(face->textureXAxis());
+            writeVec(face->textureYAxis());
+        }
+        
+        void BinaryNodeWriter::writeCount(const size_t count) {
+            write<uint32_t>(static_cast<uint32_t>(count));
+        }
+        
+        void BinaryNodeWriter::writeString(const String& str) {
+            writeCount(str.size());
+            m_data.append(str);
+        }
+        
+        void BinaryNodeWriter::writeVec(const Vec3& vec) {
+            write<double>(vec.x());
+            write<double>(vec.y());
+            write<double>(vec.z());
+        }
+    }
+}
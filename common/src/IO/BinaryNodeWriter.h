@@ -0,0 +1,70 @@
+/*
+ Copyright (C) 2010-2016 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_BinaryNodeWriter
+#define TrenchBroom_BinaryNodeWriter
+
+#include "StringUtils.h"
+#include "VecMath.h"
+#include "IO/BinaryNodeFormat.h"
+#include "Model/MapFormat.h"
+#include "Model/ModelTypes.h"
+
+#include <map>
+
+namespace TrenchBroom {
+    namespace IO {
+        /**
+         * Writes nodes and brush faces into the compact binary format described in BinaryNodeFormat.h.
+         * Unlike the text serializers, plane points and texture attributes are stored with full precision
+         * and without any formatting, so that copying and pasting within the editor is cheap and lossless.
+         */
+        class BinaryNodeWriter {
+        private:
+            typedef std::map<const Model::Entity*, Model::BrushList> EntityBrushesMap;
+            class CollectNodes;
+            class WriteNode;
+            
+            String m_data;
+        public:
+            static String writeNodes(Model::MapFormat::Type format, const Model::NodeList& nodes);
+            static String writeBrushFaces(Model::MapFormat::Type format, const Model::BrushFaceList& faces);
+        private:
+            BinaryNodeWriter(Model::MapFormat::Type format, BinaryNodeFormat::Content content, size_t count);
+            
+            void writeGroup(const Model::Group* group);
+            void writeEntity(const Model::Entity* entity);
+            void writeEntity(const Model::Entity* entity, const Model::BrushList& brushes);
+            void writeAttributes(const Model::Entity* entity);
+            void writeBrush(const Model::Brush* brush);
+            void writeBrushFace(const Model::BrushFace* face);
+            
+            void writeCount(size_t count);
+            void writeString(const String& str);
+            void writeVec(const Vec3& vec);
+            
+            template <typename T>
+            void write(const T value) {
+                m_data.append(reinterpret_cast<const char*>(&value), sizeof(T));
+            }
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_BinaryNodeWriter) */
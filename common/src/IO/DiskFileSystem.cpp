@@ -29,30 +29,118 @@
 
 namespace TrenchBroom {
     namespace IO {
+        DiskFileSystem::Directory::Directory() :
+        exists(false) {}
+
         DiskFileSystem::DiskFileSystem(const Path& root, const bool ensureExists) :
         m_root(Disk::fixPath(root)) {
             if (ensureExists && !Disk::directoryExists(m_root))
                 throw FileSystemException("Directory not found: '" + m_root.asString() + "'");
         }
         
+        DiskFileSystem::DiskFileSystem(const DiskFileSystem& other) :
+        FileSystem(other),
+        m_root(other.m_root) {}
+
+        void DiskFileSystem::invalidateIndex() {
+            std::lock_guard<std::mutex> lock(m_indexMutex);
+            m_index.clear();
+        }
+
+        bool DiskFileSystem::resolvePath(const Path& path, Path& result) const {
+            const Path relPath = path.makeCanonical();
+            if (!Disk::isCaseSensitive()) {
+                result = m_root + relPath;
+                return true;
+            }
+            
+            std::lock_guard<std::mutex> lock(m_indexMutex);
+            Path resolved;
+            if (!resolveRelativePath(relPath, resolved))
+                return false;
+            result = m_root + resolved;
+            return true;
+        }
+        
+        bool DiskFileSystem::resolveRelativePath(const Path& relPath, Path& result) const {
+            for (size_t i = 0; i < relPath.length(); ++i) {
+                const Directory& dir = directory(result);
+                const String name = relPath.subPath(i, 1).asString();
+                NameMap::const_iterator it = dir.names.find(name);
+                if (it == std::end(dir.names))
+                    it = dir.names.find(StringUtils::toLower(name));
+                if (it == std::end(dir.names))
+                    return false;
+                result = result + Path(it->second);
+            }
+            return true;
+        }
+        
+        const DiskFileSystem::Directory& DiskFileSystem::directory(const Path& relPath) const {
+            const String key = relPath.asString();
+            DirectoryIndex::iterator it = m_index.find(key);
+            if (it != std::end(m_index))
+                return it->second;
+            
+            Directory& dir = m_index[key];
+            try {
+                dir.contents = Disk::getDirectoryContents(m_root + relPath);
+                dir.exists = true;
+                // exact names take precedence over case insensitive matches
+                for (const Path& entry : dir.contents)
+                    dir.names[entry.asString()] = entry.asString();
+                for (const Path& entry : dir.contents)
+                    dir.names.insert(std::make_pair(StringUtils::toLower(entry.asString()), entry.asString()));
+            } catch (const FileSystemException&) {
+                // not a directory, remember that it has no entries
+            }
+            return dir;
+        }
+
         Path DiskFileSystem::doMakeAbsolute(const Path& relPath) const {
             return m_root + relPath.makeCanonical();
         }
         
         bool DiskFileSystem::doDirectoryExists(const Path& path) const {
-            return Disk::directoryExists(makeAbsolute(path));
+            Path absPath;
+            return resolvePath(path, absPath) && Disk::directoryExists(absPath);
         }
         
         bool DiskFileSystem::doFileExists(const Path& path) const {
-            return Disk::fileExists(makeAbsolute(path));
+            Path absPath;
+            return resolvePath(path, absPath) && Disk::fileExists(absPath);
+        }
+        
+        std::time_t DiskFileSystem::doModificationTime(const Path& path) const {
+            Path absPath;
+            if (!resolvePath(path, absPath))
+                return 0;
+            return Disk::modificationTime(absPath);
         }
         
         Path::List DiskFileSystem::doGetDirectoryContents(const Path& path) const {
-            return Disk::getDirectoryContents(makeAbsolute(path));
+            if (!Disk::isCaseSensitive())
+                return Disk::getDirectoryContents(makeAbsolute(path));
+            
+            std::lock_guard<std::mutex> lock(m_indexMutex);
+            Path relPath;
+            if (resolveRelativePath(path.makeCanonical(), relPath)) {
+                const Directory& dir = directory(relPath);
+                if (dir.exists)
+                    return dir.contents;
+            }
+            throw FileSystemException("Cannot open directory: '" + makeAbsolute(path).asString() + "'");
         }
         
         const MappedFile::Ptr DiskFileSystem::doOpenFile(const Path& path) const {
-            return Disk::openFile(makeAbsolute(path));
+            Path absPath;
+            if (!resolvePath(path, absPath))
+                throw FileNotFoundException("File not found: '" + makeAbsolute(path).asString() + "'");
+            return Disk::openFile(absPath);
+        }
+        
+        void DiskFileSystem::doRefresh() {
+            invalidateIndex();
         }
         
         WritableDiskFileSystem::WritableDiskFileSystem(const Path& root, const bool create) :
@@ -63,22 +151,27 @@ namespace TrenchBroom {
         
         void WritableDiskFileSystem::doCreateFile(const Path& path, const String& contents) {
             Disk::createFile(makeAbsolute(path), contents);
+            invalidateIndex();
         }
 
         void WritableDiskFileSystem::doCreateDirectory(const Path& path) {
             Disk::createDirectory(makeAbsolute(path));
+            invalidateIndex();
         }
         
         void WritableDiskFileSystem::doDeleteFile(const Path& path) {
             Disk::deleteFile(makeAbsolute(path));
+            invalidateIndex();
         }
         
         void WritableDiskFileSystem::doCopyFile(const Path& sourcePath, const Path& destPath, const bool overwrite) {
             Disk::copyFile(makeAbsolute(sourcePath), makeAbsolute(destPath), overwrite);
+            invalidateIndex();
         }
 
         void WritableDiskFileSystem::doMoveFile(const Path& sourcePath, const Path& destPath, const bool overwrite) {
             Disk::moveFile(makeAbsolute(sourcePath), makeAbsolute(destPath), overwrite);
+            invalidateIndex();
         }
     }
 }
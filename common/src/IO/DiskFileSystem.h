@@ -24,20 +24,51 @@
 #include "IO/FileSystem.h"
 #include "IO/Path.h"
 
+#include <mutex>
+#include <unordered_map>
+
 namespace TrenchBroom {
     namespace IO {
+        /**
+         * On case sensitive file systems, paths are resolved case insensitively against a lazily built index of
+         * the directories below the root. Each directory is listed at most once until the index is invalidated,
+         * which happens when this file system is written to or refreshed.
+         */
         class DiskFileSystem : public virtual FileSystem {
+        private:
+            typedef std::unordered_map<String, String> NameMap;
+            struct Directory {
+                bool exists;
+                Path::List contents;
+                NameMap names; // maps the actual and the lower case name of each entry to its actual name
+                
+                Directory();
+            };
+            typedef std::unordered_map<String, Directory> DirectoryIndex;
         protected:
             Path m_root;
+        private:
+            mutable DirectoryIndex m_index;
+            mutable std::mutex m_indexMutex;
         public:
             DiskFileSystem(const Path& root, bool ensureExists = true);
+            DiskFileSystem(const DiskFileSystem& other);
+            
+            void invalidateIndex();
         private:
+            bool resolvePath(const Path& path, Path& result) const;
+            bool resolveRelativePath(const Path& relPath, Path& result) const;
+            const Directory& directory(const Path& relPath) const;
+            
             Path doMakeAbsolute(const Path& relPath) const;
             bool doDirectoryExists(const Path& path) const;
             bool doFileExists(const Path& path) const;
+            std::time_t doModificationTime(const Path& path) const;
             
             Path::List doGetDirectoryContents(const Path& path) const;
             const MappedFile::Ptr doOpenFile(const Path& path) const;
+            
+            void doRefresh();
         };
         
 #ifdef _MSC_VER
@@ -107,6 +107,13 @@ namespace TrenchBroom {
                 return ::wxFileExists(fixedPath.asString());
             }
             
+            std::time_t modificationTime(const Path& path) {
+                const Path fixedPath = fixPath(path);
+                if (!::wxFileExists(fixedPath.asString()))
+                    return 0;
+                return ::wxFileModificationTime(fixedPath.asString());
+            }
+            
             String replaceForbiddenChars(const String& name) {
                 static const String forbidden = wxFileName::GetForbiddenChars().ToStdString();
                 return StringUtils::replaceChars(name, forbidden, "_");
@@ -26,6 +26,8 @@
 #include "IO/MappedFile.h"
 #include "IO/Path.h"
 
+#include <ctime>
+
 namespace TrenchBroom {
     namespace IO {
         namespace Disk {
@@ -35,6 +37,7 @@ namespace TrenchBroom {
             
             bool directoryExists(const Path& path);
             bool fileExists(const Path& path);
+            std::time_t modificationTime(const Path& path);
             
             String replaceForbiddenChars(const String& name);
             
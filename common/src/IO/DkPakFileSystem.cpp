@@ -24,7 +24,9 @@
 #include "IO/DiskFileSystem.h"
 #include "IO/IOUtils.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 
 namespace TrenchBroom {
     namespace IO {
@@ -35,13 +37,19 @@ namespace TrenchBroom {
             static const String HeaderMagic       = "PACK";
         }
         
-        DkPakFileSystem::CompressedFile::CompressedFile(MappedFile::Ptr file, const size_t uncompressedSize) :
+        DkPakFileSystem::CompressedFile::CompressedFile(MappedFile::Ptr file, const size_t uncompressedSize, MappedFileCache& cache) :
         m_file(file),
-        m_uncompressedSize(uncompressedSize) {}
+        m_uncompressedSize(uncompressedSize),
+        m_cache(cache) {}
 
         MappedFile::Ptr DkPakFileSystem::CompressedFile::doOpen() {
-            const char* data = decompress();
-            return MappedFile::Ptr(new MappedFileBuffer(m_file->path(), data, m_uncompressedSize));
+            MappedFile::Ptr result = m_cache.find(m_file->path());
+            if (result.get() == NULL) {
+                const char* data = decompress();
+                result = MappedFile::Ptr(new MappedFileBuffer(m_file->path(), data, m_uncompressedSize));
+                m_cache.insert(m_file->path(), result);
+            }
+            return result;
         }
 
         char* DkPakFileSystem::CompressedFile::decompress() const {
@@ -49,49 +57,77 @@ namespace TrenchBroom {
             
             char* result = new char[m_uncompressedSize];
             char* curTarget = result;
+            char* const end = result + m_uncompressedSize;
             
-            unsigned char x;
-            while (!reader.eof() && (x = reader.readUnsignedChar<unsigned char>()) < 0xFF) {
-                if (x < 0x40) {
-                    // x+1 bytes of uncompressed data follow (just read+write them as they are)
-                    const size_t len = static_cast<size_t>(x) + 1;
-                    reader.read(curTarget, len);
-                    curTarget += len;
-                } else if (x < 0x80) {
-                    // run-length encoded zeros, write (x - 62) zero-bytes to output
-                    const size_t len = static_cast<size_t>(x) - 62;
-                    memset(curTarget, 0, len);
-                    curTarget += len;
-                } else if (x < 0xC0) {
-                    // run-length encoded data, read one byte, write it (x-126) times to output
-                    const size_t len = static_cast<size_t>(x) - 126;
-                    const int data = reader.readInt<unsigned char>();
-                    memset(curTarget, data, len);
-                    curTarget += len;
-                } else if (x < 0xFE) {
-                    // this references previously uncompressed data
-                    // read one byte to get _offset_
-                    // read (x-190) bytes from the already uncompressed and written output data,
-                    // starting at (offset+2) bytes before the current write position (and add them to output, of course)
-                    const size_t len = static_cast<size_t>(x) - 190;
-                    const size_t offset = reader.readSize<unsigned char>();
-                    char* from = curTarget - offset + 2;
+            try {
+                unsigned char x;
+                while (!reader.eof() && (x = reader.readUnsignedChar<unsigned char>()) < 0xFF) {
+                    size_t len = 0;
+                    if (x < 0x40) {
+                        // x+1 bytes of uncompressed data follow (just read+write them as they are)
+                        len = static_cast<size_t>(x) + 1;
+                    } else if (x < 0x80) {
+                        // run-length encoded zeros, write (x - 62) zero-bytes to output
+                        len = static_cast<size_t>(x) - 62;
+                    } else if (x < 0xC0) {
+                        // run-length encoded data, read one byte, write it (x-126) times to output
+                        len = static_cast<size_t>(x) - 126;
+                    } else if (x < 0xFE) {
+                        // this references previously uncompressed data
+                        len = static_cast<size_t>(x) - 190;
+                    }
                     
-                    assert(from >= result);
-                    assert(from <  curTarget - len);
+                    if (len > static_cast<size_t>(end - curTarget))
+                        throw FileSystemException("Compressed entry '" + m_file->path().asString() + "' exceeds its uncompressed size");
                     
-                    memcpy(from, curTarget, len);
+                    const size_t operandSize = x < 0x40 ? len : (x < 0x80 ? 0 : 1);
+                    if (!reader.canRead(operandSize))
+                        throw FileSystemException("Compressed entry '" + m_file->path().asString() + "' is truncated");
+                    
+                    if (x < 0x40) {
+                        reader.read(curTarget, len);
+                    } else if (x < 0x80) {
+                        std::memset(curTarget, 0, len);
+                    } else if (x < 0xC0) {
+                        const int data = reader.readInt<unsigned char>();
+                        std::memset(curTarget, data, len);
+                    } else if (x < 0xFE) {
+                        // read one byte to get _offset_, then copy (x-190) bytes from the already uncompressed
+                        // output, starting at (offset+2) bytes before the current write position
+                        const size_t distance = reader.readSize<unsigned char>() + 2;
+                        if (distance > static_cast<size_t>(curTarget - result))
+                            throw FileSystemException("Compressed entry '" + m_file->path().asString() + "' references data before its start");
+                        
+                        // if the source overlaps the bytes being written, the last distance bytes repeat, so the
+                        // reference can be copied in chunks of at most distance bytes that never overlap
+                        const char* from = curTarget - distance;
+                        char* to = curTarget;
+                        size_t remaining = len;
+                        while (remaining > 0) {
+                            const size_t chunk = std::min(distance, remaining);
+                            std::memcpy(to, from, chunk);
+                            from += chunk;
+                            to += chunk;
+                            remaining -= chunk;
+                        }
+                    }
                     curTarget += len;
                 }
-
-                x = reader.readUnsignedChar<unsigned char>();
+            } catch (...) {
+                delete [] result;
+                throw;
             }
             
+            if (curTarget < end)
+                std::memset(curTarget, 0, static_cast<size_t>(end - curTarget));
             return result;
         }
         
-        DkPakFileSystem::DkPakFileSystem(const Path& path, MappedFile::Ptr file) :
-        ImageFileSystem(path, file) {
+        const size_t DkPakFileSystem::DefaultCacheCapacity = 32 * 1024 * 1024;
+        
+        DkPakFileSystem::DkPakFileSystem(const Path& path, MappedFile::Ptr file, const size_t cacheCapacity) :
+        ImageFileSystem(path, file),
+        m_cache(cacheCapacity) {
             initialize();
         }
         
@@ -118,9 +154,9 @@ namespace TrenchBroom {
                 MappedFile::Ptr entryFile(new MappedFileView(m_file, filePath, entryBegin, entryEnd));
                 
                 if (compressed)
-                    m_root.addFile(filePath, new SimpleFile(entryFile));
+                    m_root.addFile(filePath, new CompressedFile(entryFile, uncompressedSize, m_cache));
                 else
-                    m_root.addFile(filePath, new CompressedFile(entryFile, uncompressedSize));
+                    m_root.addFile(filePath, new SimpleFile(entryFile));
             }
         }
     }
@@ -22,6 +22,7 @@
 
 #include "StringUtils.h"
 #include "IO/ImageFileSystem.h"
+#include "IO/MappedFileCache.h"
 #include "IO/Path.h"
 
 #include <map>
@@ -34,14 +35,22 @@ namespace TrenchBroom {
             private:
                 MappedFile::Ptr m_file;
                 const size_t m_uncompressedSize;
+                MappedFileCache& m_cache;
             public:
-                CompressedFile(MappedFile::Ptr file, size_t uncompressedSize);
+                CompressedFile(MappedFile::Ptr file, size_t uncompressedSize, MappedFileCache& cache);
             private:
                 MappedFile::Ptr doOpen();
                 char* decompress() const;
             };
+            
+            MappedFileCache m_cache;
         public:
-            DkPakFileSystem(const Path& path, MappedFile::Ptr file);
+            /**
+             * The default capacity of the cache of decompressed entries in bytes.
+             */
+            static const size_t DefaultCacheCapacity;
+            
+            DkPakFileSystem(const Path& path, MappedFile::Ptr file, size_t cacheCapacity = DefaultCacheCapacity);
         private:
             void doReadDirectory();
             
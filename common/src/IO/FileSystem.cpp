@@ -33,6 +33,12 @@ namespace TrenchBroom {
 
         FileSystem& FileSystem::operator=(const FileSystem& other) { return *this; }
 
+        void FileSystem::refresh() {
+            doRefresh();
+        }
+        
+        void FileSystem::doRefresh() {}
+        
         Path FileSystem::makeAbsolute(const Path& relPath) const {
             return doMakeAbsolute(relPath);
         }
@@ -77,6 +83,18 @@ namespace TrenchBroom {
             }
         }
 
+        std::time_t FileSystem::modificationTime(const Path& path) const {
+            try {
+                if (path.isAbsolute())
+                    throw FileSystemException("Path is absolute: '" + path.asString() + "'");
+                if (!fileExists(path))
+                    return 0;
+                return doModificationTime(path);
+            } catch (const PathException& e) {
+                throw FileSystemException("Invalid path: '" + path.asString() + "'", e);
+            }
+        }
+        
         const MappedFile::Ptr FileSystem::openFile(const Path& path) const {
             try {
                 if (path.isAbsolute())
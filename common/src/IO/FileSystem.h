@@ -45,6 +45,11 @@ namespace TrenchBroom {
             
             bool directoryExists(const Path& path) const;
             bool fileExists(const Path& path) const;
+            
+            /**
+             * Returns the modification time of the given file, or 0 if it cannot be determined.
+             */
+            std::time_t modificationTime(const Path& path) const;
 
             template <class Matcher>
             Path::List findItems(const Path& path, const Matcher& matcher) const {
@@ -64,6 +69,12 @@ namespace TrenchBroom {
             
             Path::List getDirectoryContents(const Path& path) const;
             const MappedFile::Ptr openFile(const Path& path) const;
+            
+            /**
+             * Discards everything this file system has cached about its files, so that files which were added,
+             * removed or renamed outside the editor are found again.
+             */
+            void refresh();
         private:
             template <class M>
             void doFindItems(const Path& searchPath, const M& matcher, const bool recurse, Path::List& result) const {
@@ -79,10 +90,13 @@ namespace TrenchBroom {
             virtual Path doMakeAbsolute(const Path& relPath) const = 0;
             virtual bool doDirectoryExists(const Path& path) const = 0;
             virtual bool doFileExists(const Path& path) const = 0;
+            virtual std::time_t doModificationTime(const Path& path) const = 0;
             
             virtual Path::List doGetDirectoryContents(const Path& path) const = 0;
 
             virtual const MappedFile::Ptr doOpenFile(const Path& path) const = 0;
+            
+            virtual void doRefresh();
         };
         
         class WritableFileSystem : public virtual FileSystem {
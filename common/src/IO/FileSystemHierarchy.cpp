@@ -27,7 +27,8 @@
 
 namespace TrenchBroom {
     namespace IO {
-        FileSystemHierarchy::FileSystemHierarchy() {}
+        FileSystemHierarchy::FileSystemHierarchy() :
+        m_indexValid(false) {}
 
         FileSystemHierarchy::~FileSystemHierarchy() {
             clear();
@@ -36,10 +37,62 @@ namespace TrenchBroom {
         void FileSystemHierarchy::addFileSystem(FileSystem* fileSystem) {
             ensure(fileSystem != NULL, "fileSystem is null");
             m_fileSystems.push_back(fileSystem);
+            invalidateIndex();
         }
 
         void FileSystemHierarchy::clear() {
             VectorUtils::clearAndDelete(m_fileSystems);
+            invalidateIndex();
+        }
+
+        void FileSystemHierarchy::invalidateIndex() {
+            std::lock_guard<std::mutex> lock(m_indexMutex);
+            m_files.clear();
+            m_directories.clear();
+            m_indexValid = false;
+        }
+
+        String FileSystemHierarchy::indexKey(const Path& path) {
+            return path.makeCanonical().makeLowerCase().asString();
+        }
+        
+        void FileSystemHierarchy::validateIndex() const {
+            if (m_indexValid)
+                return;
+            
+            // later file systems replace the files of earlier ones
+            for (FileSystem* fileSystem : m_fileSystems) {
+                if (fileSystem->directoryExists(Path(""))) {
+                    m_directories[""];
+                    indexDirectory(fileSystem, Path(""));
+                }
+            }
+            
+            for (DirectoryIndex::value_type& entry : m_directories)
+                VectorUtils::sortAndRemoveDuplicates(entry.second);
+            m_indexValid = true;
+        }
+        
+        void FileSystemHierarchy::indexDirectory(FileSystem* fileSystem, const Path& path) const {
+            Path::List contents;
+            try {
+                contents = fileSystem->getDirectoryContents(path);
+            } catch (const FileSystemException&) {
+                return;
+            }
+            
+            Path::List& directoryContents = m_directories[indexKey(path)];
+            VectorUtils::append(directoryContents, contents);
+            
+            for (const Path& item : contents) {
+                const Path itemPath = path + item;
+                if (fileSystem->directoryExists(itemPath)) {
+                    m_directories[indexKey(itemPath)];
+                    indexDirectory(fileSystem, itemPath);
+                } else {
+                    m_files[indexKey(itemPath)] = fileSystem;
+                }
+            }
         }
 
         Path FileSystemHierarchy::doMakeAbsolute(const Path& relPath) const {
@@ -50,51 +103,57 @@ namespace TrenchBroom {
         }
 
         bool FileSystemHierarchy::doDirectoryExists(const Path& path) const {
-            for (auto it = m_fileSystems.rbegin(), end = m_fileSystems.rend(); it != end; ++it) {
-                const FileSystem* fileSystem = *it;
-                if (fileSystem->directoryExists(path))
-                    return true;
-            }
-            return false;
+            const String key = indexKey(path);
+            
+            std::lock_guard<std::mutex> lock(m_indexMutex);
+            validateIndex();
+            return m_directories.count(key) > 0;
         }
         
         bool FileSystemHierarchy::doFileExists(const Path& path) const {
             return (findFileSystemContaining(path)) != NULL;
         }
         
+        std::time_t FileSystemHierarchy::doModificationTime(const Path& path) const {
+            FileSystem* fileSystem = findFileSystemContaining(path);
+            if (fileSystem == NULL)
+                return 0;
+            return fileSystem->modificationTime(path);
+        }
+        
         FileSystem* FileSystemHierarchy::findFileSystemContaining(const Path& path) const {
-            for (auto it = m_fileSystems.rbegin(), end = m_fileSystems.rend(); it != end; ++it) {
-                FileSystem* fileSystem = *it;
-                if (fileSystem->fileExists(path))
-                    return fileSystem;
-            }
-            return NULL;
+            const String key = indexKey(path);
+            
+            std::lock_guard<std::mutex> lock(m_indexMutex);
+            validateIndex();
+            FileIndex::const_iterator it = m_files.find(key);
+            if (it == std::end(m_files))
+                return NULL;
+            return it->second;
         }
 
         Path::List FileSystemHierarchy::doGetDirectoryContents(const Path& path) const {
-            Path::List result;
-            for (auto it = m_fileSystems.rbegin(), end = m_fileSystems.rend(); it != end; ++it) {
-                const FileSystem* fileSystem = *it;
-                if (fileSystem->directoryExists(path)) {
-                    const Path::List contents = fileSystem->getDirectoryContents(path);
-                    VectorUtils::append(result, contents);
-                }
-            }
+            const String key = indexKey(path);
             
-            VectorUtils::sortAndRemoveDuplicates(result);
-            return result;
+            std::lock_guard<std::mutex> lock(m_indexMutex);
+            validateIndex();
+            DirectoryIndex::const_iterator it = m_directories.find(key);
+            if (it == std::end(m_directories))
+                return Path::List();
+            return it->second;
         }
         
         const MappedFile::Ptr FileSystemHierarchy::doOpenFile(const Path& path) const {
-            for (auto it = m_fileSystems.rbegin(), end = m_fileSystems.rend(); it != end; ++it) {
-                const FileSystem* fileSystem = *it;
-                if (fileSystem->fileExists(path)) {
-                    const MappedFile::Ptr file = fileSystem->openFile(path);
-                    if (file.get() != NULL)
-                        return file;
-                }
-            }
-            return MappedFile::Ptr();
+            const FileSystem* fileSystem = findFileSystemContaining(path);
+            if (fileSystem == NULL)
+                return MappedFile::Ptr();
+            return fileSystem->openFile(path);
+        }
+        
+        void FileSystemHierarchy::doRefresh() {
+            for (FileSystem* fileSystem : m_fileSystems)
+                fileSystem->refresh();
+            invalidateIndex();
         }
 
         WritableFileSystemHierarchy::WritableFileSystemHierarchy() :
@@ -118,26 +177,31 @@ namespace TrenchBroom {
         void WritableFileSystemHierarchy::doCreateFile(const Path& path, const String& contents) {
             ensure(m_writableFileSystem != NULL, "writableFileSystem is null");
             m_writableFileSystem->createFile(path, contents);
+            invalidateIndex();
         }
 
         void WritableFileSystemHierarchy::doCreateDirectory(const Path& path) {
             ensure(m_writableFileSystem != NULL, "writableFileSystem is null");
             m_writableFileSystem->createDirectory(path);
+            invalidateIndex();
         }
         
         void WritableFileSystemHierarchy::doDeleteFile(const Path& path) {
             ensure(m_writableFileSystem != NULL, "writableFileSystem is null");
             m_writableFileSystem->deleteFile(path);
+            invalidateIndex();
         }
         
         void WritableFileSystemHierarchy::doCopyFile(const Path& sourcePath, const Path& destPath, const bool overwrite) {
             ensure(m_writableFileSystem != NULL, "writableFileSystem is null");
             m_writableFileSystem->copyFile(sourcePath, destPath, overwrite);
+            invalidateIndex();
         }
         
         void WritableFileSystemHierarchy::doMoveFile(const Path& sourcePath, const Path& destPath, const bool overwrite) {
             ensure(m_writableFileSystem != NULL, "writableFileSystem is null");
             m_writableFileSystem->moveFile(sourcePath, destPath, overwrite);
+            invalidateIndex();
         }
     }
 }
@@ -26,30 +26,57 @@
 #include "IO/FileSystem.h"
 #include "IO/Path.h"
 
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom {
     namespace IO {
         class Path;
         
+        /**
+         * Merges the contents of several file systems, with later file systems hiding the files of earlier ones.
+         * All lookups go through an index of the merged contents that maps the lower case path of every file to
+         * the file system that provides it. The index is built on first use and rebuilt whenever the mounted file
+         * systems change or the hierarchy is refreshed. Refreshing the hierarchy also refreshes all of the mounted
+         * file systems.
+         */
         class FileSystemHierarchy : public virtual FileSystem {
         private:
             typedef std::vector<FileSystem*> FileSystemList;
+            typedef std::unordered_map<String, FileSystem*> FileIndex;
+            typedef std::unordered_map<String, Path::List> DirectoryIndex;
+            
             FileSystemList m_fileSystems;
+            
+            mutable FileIndex m_files;
+            mutable DirectoryIndex m_directories;
+            mutable bool m_indexValid;
+            mutable std::mutex m_indexMutex;
         public:
             FileSystemHierarchy();
             virtual ~FileSystemHierarchy();
             
             void addFileSystem(FileSystem* fileSystem);
             virtual void clear();
+        protected:
+            void invalidateIndex();
         private:
+            static String indexKey(const Path& path);
+            void validateIndex() const;
+            void indexDirectory(FileSystem* fileSystem, const Path& path) const;
+            
+
             Path doMakeAbsolute(const Path& relPath) const;
             bool doDirectoryExists(const Path& path) const;
             bool doFileExists(const Path& path) const;
+            std::time_t doModificationTime(const Path& path) const;
             FileSystem* findFileSystemContaining(const Path& path) const;
             
             Path::List doGetDirectoryContents(const Path& path) const;
             const MappedFile::Ptr doOpenFile(const Path& path) const;
+            
+            void doRefresh();
 
             deleteCopyAndAssignment(FileSystemHierarchy)
         };
@@ -155,6 +155,13 @@ namespace TrenchBroom {
             return m_root.fileExists(searchPath);
         }
         
+        std::time_t ImageFileSystem::doModificationTime(const Path& path) const {
+            // entries carry no timestamps of their own, so they change whenever the image file does
+            if (!m_path.isAbsolute())
+                return 0;
+            return Disk::modificationTime(m_path);
+        }
+        
         Path::List ImageFileSystem::doGetDirectoryContents(const Path& path) const {
             const Path searchPath = path.makeLowerCase();
             const Directory& directory = m_root.findDirectory(path);
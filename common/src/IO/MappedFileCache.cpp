@@ -0,0 +1,92 @@
+/*
+ Copyright (C) 2010-2016 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MappedFileCache.h"
+
+#include <cassert>
+
+namespace TrenchBroom {
+    namespace IO {
+        MappedFileCache::MappedFileCache(const size_t capacity) :
+        m_capacity(capacity),
+        m_size(0) {}
+        
+        size_t MappedFileCache::capacity() const {
+            return m_capacity;
+        }
+        
+        size_t MappedFileCache::size() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_size;
+        }
+        
+        size_t MappedFileCache::count() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_entries.size();
+        }
+
+        MappedFile::Ptr MappedFileCache::find(const Path& path) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            EntryMap::iterator it = m_index.find(path);
+            if (it == std::end(m_index))
+                return MappedFile::Ptr();
+            
+            EntryList::iterator entry = it->second;
+            m_entries.splice(std::begin(m_entries), m_entries, entry);
+            return entry->second;
+        }
+        
+        void MappedFileCache::insert(const Path& path, MappedFile::Ptr file) {
+            assert(file.get() != NULL);
+            
+            std::lock_guard<std::mutex> lock(m_mutex);
+            EntryMap::iterator it = m_index.find(path);
+            if (it != std::end(m_index)) {
+                m_size -= it->second->second->size();
+                m_entries.erase(it->second);
+                m_index.erase(it);
+            }
+            
+            if (file->size() > m_capacity)
+                return;
+            
+            m_entries.push_front(Entry(path, file));
+            m_index.insert(std::make_pair(path, std::begin(m_entries)));
+            m_size += file->size();
+            evict();
+        }
+        
+        void MappedFileCache::clear() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_entries.clear();
+            m_index.clear();
+            m_size = 0;
+        }
+
+        void MappedFileCache::evict() {
+            while (m_size > m_capacity) {
+                assert(!m_entries.empty());
+                const Entry& entry = m_entries.back();
+                m_size -= entry.second->size();
+                m_index.erase(entry.first);
+                m_entries.pop_back();
+            }
+        }
+    }
+}
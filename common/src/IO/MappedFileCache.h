@@ -0,0 +1,76 @@
+/*
+ Copyright (C) 2010-2016 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_MappedFileCache
+#define TrenchBroom_MappedFileCache
+
+#include "Macros.h"
+#include "IO/MappedFile.h"
+#include "IO/Path.h"
+
+#include <list>
+#include <map>
+#include <mutex>
+
+namespace TrenchBroom {
+    namespace IO {
+        /**
+         * A size bounded cache of files that are expensive to produce, such as decompressed archive entries. The
+         * least recently used files are evicted once the total size of the cached files exceeds the capacity. Since
+         * the files are shared, evicting a file does not invalidate any pointers that are still held by clients.
+         */
+        class MappedFileCache {
+        private:
+            typedef std::pair<Path, MappedFile::Ptr> Entry;
+            typedef std::list<Entry> EntryList;
+            typedef std::map<Path, EntryList::iterator> EntryMap;
+            
+            size_t m_capacity;
+            size_t m_size;
+            EntryList m_entries; // most recently used entries first
+            EntryMap m_index;
+            mutable std::mutex m_mutex;
+        public:
+            MappedFileCache(size_t capacity);
+            
+            size_t capacity() const;
+            size_t size() const;
+            size_t count() const;
+            
+            /**
+             * Returns the cached file with the given path and marks it as most recently used, or returns a null
+             * pointer if no such file is cached.
+             */
+            MappedFile::Ptr find(const Path& path);
+            
+            /**
+             * Adds the given file to this cache, replacing any file that is cached under the same path. Files that
+             * are larger than the capacity are not cached.
+             */
+            void insert(const Path& path, MappedFile::Ptr file);
+            void clear();
+        private:
+            void evict();
+            
+            deleteCopyAndAssignment(MappedFileCache)
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_MappedFileCache) */
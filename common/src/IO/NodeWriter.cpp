@@ -65,9 +65,14 @@ namespace TrenchBroom {
             }
             
             void addBrush(Model::Brush* brush) {
-                VisitParent visitParent(brush, m_entityBrushes, m_worldBrushes);
                 Model::Node* parent = brush->parent();
-                parent->accept(visitParent);
+                if (parent == NULL) {
+                    // brushes that were read from the clipboard have no parent yet
+                    m_worldBrushes.push_back(brush);
+                } else {
+                    VisitParent visitParent(brush, m_entityBrushes, m_worldBrushes);
+                    parent->accept(visitParent);
+                }
             }
         };
         
@@ -25,73 +25,123 @@
 #include "Model/BrushGeometry.h"
 
 #include <cassert>
+#include <cstdarg>
 
 namespace TrenchBroom {
     namespace IO {
+        const size_t ObjFileSerializer::ChunkedWriter::ChunkSize;
+        const size_t ObjFileSerializer::ChunkedWriter::MaxLineLength;
+        
+        ObjFileSerializer::ChunkedWriter::ChunkedWriter(FILE* stream) :
+        m_stream(stream),
+        m_chunk(ChunkSize),
+        m_size(0) {
+            ensure(m_stream != NULL, "stream is null");
+        }
+        
+        ObjFileSerializer::ChunkedWriter::~ChunkedWriter() {
+            flush();
+        }
+
+        void ObjFileSerializer::ChunkedWriter::print(const char* format, ...) {
+            if (ChunkSize - m_size < MaxLineLength)
+                flush();
+            
+            va_list arguments;
+            va_start(arguments, format);
+            const int length = std::vsnprintf(&m_chunk[m_size], ChunkSize - m_size, format, arguments);
+            va_end(arguments);
+            
+            assert(length >= 0);
+            if (static_cast<size_t>(length) < ChunkSize - m_size) {
+                m_size += static_cast<size_t>(length);
+            } else {
+                // the output did not fit into the remainder of the chunk, write it directly
+                flush();
+                va_start(arguments, format);
+                std::vfprintf(m_stream, format, arguments);
+                va_end(arguments);
+            }
+        }
+        
+        void ObjFileSerializer::ChunkedWriter::flush() {
+            if (m_size > 0) {
+                std::fwrite(&m_chunk[0], 1, m_size, m_stream);
+                m_size = 0;
+            }
+        }
+
         ObjFileSerializer::IndexedVertex::IndexedVertex(const size_t i_vertex, const size_t i_texCoords, const size_t i_normal) :
         vertex(i_vertex),
         texCoords(i_texCoords),
         normal(i_normal) {}
+        
+        ObjFileSerializer::Object::Object(const size_t i_entityNo, const size_t i_brushNo) :
+        entityNo(i_entityNo),
+        brushNo(i_brushNo),
+        faceCount(0) {}
 
         ObjFileSerializer::ObjFileSerializer(FILE* stream) :
-        m_stream(stream) {
-            ensure(m_stream != NULL, "stream is null");
-        }
+        m_writer(stream) {}
 
-        void ObjFileSerializer::doBeginFile() {}
+        void ObjFileSerializer::doBeginFile() {
+            m_writer.print("# vertices\n");
+        }
         
         void ObjFileSerializer::doEndFile() {
-            writeVertices();
-            std::fprintf(m_stream, "\n");
+            m_writer.print("\n");
             writeTexCoords();
-            std::fprintf(m_stream, "\n");
+            m_writer.print("\n");
             writeNormals();
-            std::fprintf(m_stream, "\n");
+            m_writer.print("\n");
             writeObjects();
+            m_writer.flush();
         }
 
-        void ObjFileSerializer::writeVertices() {
-            std::fprintf(m_stream, "# vertices\n");
-            for (const Vec3& elem : m_vertices.list())
-                std::fprintf(m_stream, "v %.17g %.17g %.17g\n", elem.x(), elem.z(), -elem.y()); // no idea why I have to switch Y and Z
+        void ObjFileSerializer::writeVertex(const Vec3& vertex) {
+            m_writer.print("v %.17g %.17g %.17g\n", vertex.x(), vertex.z(), -vertex.y()); // no idea why I have to switch Y and Z
         }
         
         void ObjFileSerializer::writeTexCoords() {
-            std::fprintf(m_stream, "# texture coordinates\n");
+            m_writer.print("# texture coordinates\n");
             for (const Vec2f& elem : m_texCoords.list())
-                std::fprintf(m_stream, "vt %.17g %.17g\n", elem.x(), elem.y());
+                m_writer.print("vt %.17g %.17g\n", elem.x(), elem.y());
         }
         
         void ObjFileSerializer::writeNormals() {
-            std::fprintf(m_stream, "# face normals\n");
+            m_writer.print("# face normals\n");
             for (const Vec3& elem : m_normals.list())
-                std::fprintf(m_stream, "vn %.17g %.17g %.17g\n", elem.x(), elem.z(), -elem.y()); // no idea why I have to switch Y and Z
+                m_writer.print("vn %.17g %.17g %.17g\n", elem.x(), elem.z(), -elem.y()); // no idea why I have to switch Y and Z
         }
         
         void ObjFileSerializer::writeObjects() {
-            std::fprintf(m_stream, "# objects\n");
+            m_writer.print("# objects\n");
+            
+            IndexedVertexList::const_iterator vertexIt = std::begin(m_faceVertices);
+            std::vector<size_t>::const_iterator faceSizeIt = std::begin(m_faceSizes);
+            
             for (const Object& object : m_objects) {
-            ObjectList::const_iterator fIt, fEnd;
-                std::fprintf(m_stream, "o entity%u_brush%u\n",
-                             static_cast<unsigned long>(object.entityNo),
-                             static_cast<unsigned long>(object.brushNo));
+                m_writer.print("o entity%lu_brush%lu\n",
+                               static_cast<unsigned long>(object.entityNo),
+                               static_cast<unsigned long>(object.brushNo));
                 
-                writeFaces(object.faces);
-                std::fprintf(m_stream, "\n");
-            }
-        }
-
-        void ObjFileSerializer::writeFaces(const FaceList& faces) {
-            for (const IndexedVertexList& face : faces) {
-                std::fprintf(m_stream, "f");
-                for (const IndexedVertex& vertex : face) {
-                    std::fprintf(m_stream, " %u/%u/%u",
-                                 static_cast<unsigned long>(vertex.vertex) + 1,
-                                 static_cast<unsigned long>(vertex.texCoords) + 1,
-                                 static_cast<unsigned long>(vertex.normal) + 1);
+                for (size_t i = 0; i < object.faceCount; ++i) {
+                    m_writer.print("f");
+                    const size_t faceSize = *faceSizeIt++;
+                    for (size_t j = 0; j < faceSize; ++j) {
+                        const IndexedVertex& vertex = *vertexIt++;
+                        m_writer.print(" %lu/%lu/%lu",
+                                       static_cast<unsigned long>(vertex.vertex) + 1,
+                                       static_cast<unsigned long>(vertex.texCoords) + 1,
+                                       static_cast<unsigned long>(vertex.normal) + 1);
+                    }
+                    m_writer.print("\n");
                 }
-                std::fprintf(m_stream, "\n");
+                m_writer.print("\n");
             }
+            
+            assert(vertexIt == std::end(m_faceVertices));
+            assert(faceSizeIt == std::end(m_faceSizes));
         }
 
         void ObjFileSerializer::doBeginEntity(const Model::Node* node) {}
@@ -99,35 +149,33 @@ namespace TrenchBroom {
         void ObjFileSerializer::doEntityAttribute(const Model::EntityAttribute& attribute) {}
         
         void ObjFileSerializer::doBeginBrush(const Model::Brush* brush) {
-            m_currentObject.entityNo = entityNo();
-            m_currentObject.brushNo = brushNo();
+            m_objects.push_back(Object(entityNo(), brushNo()));
         }
         
-        void ObjFileSerializer::doEndBrush(Model::Brush* brush) {
-            m_objects.push_back(m_currentObject);
-            m_currentObject.faces.clear();
-        }
+        void ObjFileSerializer::doEndBrush(Model::Brush* brush) {}
         
         void ObjFileSerializer::doBrushFace(Model::BrushFace* face) {
+            assert(!m_objects.empty());
+            
             const Vec3& normal = face->boundary().normal;
             const size_t normalIndex = m_normals.index(normal);
             
             const Model::BrushFace::VertexList vertices = face->vertices();
-            IndexedVertexList indexedVertices;
-            indexedVertices.reserve(vertices.size());
-            
             for (const Model::BrushVertex* vertex : vertices) {
-            Model::BrushFace::VertexList::const_iterator it, end;
                 const Vec3& position = vertex->position();
                 const Vec2f texCoords = face->textureCoords(position);
                 
-                const size_t vertexIndex = m_vertices.index(position);
-                const size_t texCoordsIndex = m_texCoords.index(texCoords);
+                bool newVertex;
+                const size_t vertexIndex = m_vertices.index(position, newVertex);
+                if (newVertex)
+                    writeVertex(position);
                 
-                indexedVertices.push_back(IndexedVertex(vertexIndex, texCoordsIndex, normalIndex));
+                const size_t texCoordsIndex = m_texCoords.index(texCoords);
+                m_faceVertices.push_back(IndexedVertex(vertexIndex, texCoordsIndex, normalIndex));
             }
             
-            m_currentObject.faces.push_back(indexedVertices);
+            m_faceSizes.push_back(vertices.size());
+            ++m_objects.back().faceCount;
         }
     }
 }
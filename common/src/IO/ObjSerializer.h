@@ -25,20 +25,41 @@
 #include "Model/ModelTypes.h"
 
 #include <cstdio>
-#include <list>
-#include <map>
+#include <functional>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom {
     namespace IO {
+        /**
+         * Writes brush geometry as a Wavefront OBJ file. Vertex positions are written as soon as they are first
+         * encountered, while texture coordinates, normals and faces are kept in contiguous buffers until the end
+         * of the file, since the file lists them in separate sections after the vertices.
+         */
         class ObjFileSerializer : public NodeSerializer {
         private:
+            /**
+             * Hashes vectors by their exact component values. Negative zero is hashed like positive zero since
+             * the two compare equal.
+             */
+            template <typename V>
+            struct VecHash {
+                size_t operator()(const V& v) const {
+                    typedef typename V::Type T;
+                    std::hash<T> hash;
+                    size_t result = 0;
+                    for (size_t i = 0; i < V::Size; ++i)
+                        result ^= hash(v[i] + static_cast<T>(0.0)) + 0x9e3779b9 + (result << 6) + (result >> 2);
+                    return result;
+                }
+            };
+            
             template <typename V>
             class IndexMap {
             public:
                 typedef std::vector<V> List;
             private:
-                typedef std::map<V, size_t> Map;
+                typedef std::unordered_map<V, size_t, VecHash<V> > Map;
                 Map m_map;
                 List m_list;
             public:
@@ -46,14 +67,42 @@ namespace TrenchBroom {
                     return m_list;
                 }
                 
-                size_t index(const V& v) {
-                    typename Map::iterator indexIt = MapUtils::findOrInsert(m_map, v, m_list.size());
-                    const size_t index = indexIt->second;
-                    if (index == m_list.size())
+                /**
+                 * Returns the index of the given value and sets inserted to true if the value was not known yet.
+                 */
+                size_t index(const V& v, bool& inserted) {
+                    const std::pair<typename Map::iterator, bool> result = m_map.insert(std::make_pair(v, m_list.size()));
+                    inserted = result.second;
+                    if (inserted)
                         m_list.push_back(v);
-                    return index;
+                    return result.first->second;
+                }
+                
+                size_t index(const V& v) {
+                    bool inserted;
+                    return index(v, inserted);
                 }
             };
+            
+            /**
+             * Collects formatted output in a fixed size chunk and writes it to the stream whenever the chunk is
+             * full, which avoids the overhead of calling fprintf for every line.
+             */
+            class ChunkedWriter {
+            private:
+                static const size_t ChunkSize = 64 * 1024;
+                static const size_t MaxLineLength = 256;
+                
+                FILE* m_stream;
+                std::vector<char> m_chunk;
+                size_t m_size;
+            public:
+                ChunkedWriter(FILE* stream);
+                ~ChunkedWriter();
+                
+                void print(const char* format, ...);
+                void flush();
+            };
 
             struct IndexedVertex {
                 size_t vertex;
@@ -64,23 +113,26 @@ namespace TrenchBroom {
             };
             
             typedef std::vector<IndexedVertex> IndexedVertexList;
-            typedef std::list<IndexedVertexList> FaceList;
 
             struct Object {
                 size_t entityNo;
                 size_t brushNo;
-                FaceList faces;
+                size_t faceCount;
+                
+                Object(size_t i_entityNo, size_t i_brushNo);
             };
             
-            typedef std::list<Object> ObjectList;
+            typedef std::vector<Object> ObjectList;
             
-            FILE* m_stream;
+            ChunkedWriter m_writer;
 
             IndexMap<Vec3> m_vertices;
             IndexMap<Vec2f> m_texCoords;
             IndexMap<Vec3> m_normals;
 
-            Object m_currentObject;
+            // the vertices of all faces, and the number of vertices of each face
+            IndexedVertexList m_faceVertices;
+            std::vector<size_t> m_faceSizes;
             ObjectList m_objects;
         public:
             ObjFileSerializer(FILE* stream);
@@ -88,11 +140,10 @@ namespace TrenchBroom {
             void doBeginFile();
             void doEndFile();
             
-            void writeVertices();
+            void writeVertex(const Vec3& vertex);
             void writeTexCoords();
             void writeNormals();
             void writeObjects();
-            void writeFaces(const FaceList& faces);
             
             void doBeginEntity(const Model::Node* node);
             void doEndEntity(Model::Node* node);
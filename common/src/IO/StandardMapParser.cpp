@@ -21,6 +21,7 @@
 
 #include "Logger.h"
 #include "SetAny.h"
+#include "Assets/TextureName.h"
 #include "Model/BrushFace.h"
 
 namespace TrenchBroom {
@@ -342,11 +343,10 @@ namespace TrenchBroom {
             expect(QuakeMapToken::CParenthesis, token = m_tokenizer.nextToken());
             
             // texture names can contain braces etc, so we just read everything until the next opening bracket or number
-            String textureName = m_tokenizer.readAnyString(QuakeMapTokenizer::Whitespace());
-            if (textureName == Model::BrushFace::NoTextureName)
-                textureName = "";
+            const String textureName = m_tokenizer.readAnyString(QuakeMapTokenizer::Whitespace());
             
-            Model::BrushFaceAttributes attribs(textureName);
+            // intern the name here so that all faces share it
+            Model::BrushFaceAttributes attribs(Assets::TextureName(textureName == Model::BrushFace::NoTextureName ? "" : textureName));
             if (m_format == Model::MapFormat::Valve) {
                 expect(QuakeMapToken::OBracket, m_tokenizer.nextToken());
                 texAxisX = parseVector();
@@ -36,6 +36,10 @@ namespace TrenchBroom {
         m_brushContentTypeBuilder(brushContentTypeBuilder),
         m_world(NULL) {}
         
+        void WorldReader::setWorldspawnCallback(const WorldspawnCallback& worldspawnCallback) {
+            m_worldspawnCallback = worldspawnCallback;
+        }
+        
         Model::World* WorldReader::read(Model::MapFormat::Type format, const BBox3& worldBounds, ParserStatus& status) {
             readEntities(format, worldBounds, status);
             return m_world;
@@ -50,6 +54,8 @@ namespace TrenchBroom {
         Model::Node* WorldReader::onWorldspawn(const Model::EntityAttribute::List& attributes, const ExtraAttributes& extraAttributes, ParserStatus& status) {
             m_world->setAttributes(attributes);
             setExtraAttributes(m_world, extraAttributes);
+            if (m_worldspawnCallback)
+                m_worldspawnCallback(m_world);
             return m_world->defaultLayer();
         }
 
@@ -22,6 +22,8 @@
 
 #include "IO/MapReader.h"
 
+#include <functional>
+
 namespace TrenchBroom {
     namespace Model {
         class BrushContentTypeBuilder;
@@ -31,12 +33,21 @@ namespace TrenchBroom {
         class ParserStatus;
         
         class WorldReader : public MapReader {
+        public:
+            typedef std::function<void(const Model::World* world)> WorldspawnCallback;
         private:
             const Model::BrushContentTypeBuilder* m_brushContentTypeBuilder;
             Model::World* m_world;
+            WorldspawnCallback m_worldspawnCallback;
         public:
             WorldReader(const char* begin, const char* end, const Model::BrushContentTypeBuilder* brushContentTypeBuilder);
             WorldReader(const String& str, const Model::BrushContentTypeBuilder* brushContentTypeBuilder);
+            
+            /**
+             * Sets a callback that is called once the attributes of the worldspawn entity are known, before any of
+             * the brushes and entities that follow it are read.
+             */
+            void setWorldspawnCallback(const WorldspawnCallback& worldspawnCallback);
 
             Model::World* read(Model::MapFormat::Type format, const BBox3& worldBounds, ParserStatus& status);
         private: // implement MapReader interface
@@ -21,6 +21,7 @@
 #define TrenchBroom_Mat_h
 
 #include "Quat.h"
+#include "SIMD.h"
 #include "Vec.h"
 
 #include <algorithm>
@@ -206,9 +207,9 @@ public:
     }
     
     const typename Vec<T,C-1>::List operator*(const typename Vec<T,C-1>::List& right) const {
-        typename Vec<T,C-1>::List result;
-        result.reserve(right.size());
-        std::transform(std::begin(right), std::end(right), std::back_inserter(result), [this](const Vec<T,C-1>& elem) { return *this * elem; });
+        typename Vec<T,C-1>::List result(right.size());
+        if (!right.empty())
+            transformPoints(*this, &right.front(), right.size(), &result.front());
         return result;
     }
     
@@ -325,6 +326,65 @@ typename Vec<T,R-1>::List& operator*= (typename Vec<T,R-1>::List& left, const Ma
     return left;
 }
 
+// Transforms the given points by the given matrix, treating each point as a homogeneous vector whose last component
+// is 1. The result array may be the same as the points array.
+template <typename T, size_t S>
+void transformPoints(const Mat<T,S+1,S+1>& mat, const Vec<T,S>* points, const size_t count, Vec<T,S>* result) {
+    for (size_t i = 0; i < count; ++i)
+        result[i] = mat * points[i];
+}
+
+#ifdef TB_SIMD_SSE2
+// Computes the same sums in the same order as the generic implementation, so the results are identical.
+inline void transformPoints(const Mat<double,4,4>& mat, const Vec<double,3>* points, const size_t count, Vec<double,3>* result) {
+    __m128d columnsXY[4], columnsZW[4];
+    for (size_t c = 0; c < 4; ++c) {
+        columnsXY[c] = _mm_loadu_pd(&mat[c][0]);
+        columnsZW[c] = _mm_loadu_pd(&mat[c][2]);
+    }
+    
+    for (size_t i = 0; i < count; ++i) {
+        const __m128d x = _mm_set1_pd(points[i][0]);
+        const __m128d y = _mm_set1_pd(points[i][1]);
+        const __m128d z = _mm_set1_pd(points[i][2]);
+        
+        __m128d xy = _mm_add_pd(_mm_setzero_pd(), _mm_mul_pd(columnsXY[0], x));
+        xy = _mm_add_pd(xy, _mm_mul_pd(columnsXY[1], y));
+        xy = _mm_add_pd(xy, _mm_mul_pd(columnsXY[2], z));
+        xy = _mm_add_pd(xy, columnsXY[3]);
+        
+        __m128d zw = _mm_add_pd(_mm_setzero_pd(), _mm_mul_pd(columnsZW[0], x));
+        zw = _mm_add_pd(zw, _mm_mul_pd(columnsZW[1], y));
+        zw = _mm_add_pd(zw, _mm_mul_pd(columnsZW[2], z));
+        zw = _mm_add_pd(zw, columnsZW[3]);
+        
+        const __m128d w = _mm_unpackhi_pd(zw, zw);
+        _mm_storeu_pd(&result[i][0], _mm_div_pd(xy, w));
+        _mm_store_sd(&result[i][2], _mm_div_sd(zw, w));
+    }
+}
+
+inline void transformPoints(const Mat<float,4,4>& mat, const Vec<float,3>* points, const size_t count, Vec<float,3>* result) {
+    __m128 columns[4];
+    for (size_t c = 0; c < 4; ++c)
+        columns[c] = _mm_loadu_ps(&mat[c][0]);
+    
+    for (size_t i = 0; i < count; ++i) {
+        const __m128 x = _mm_set1_ps(points[i][0]);
+        const __m128 y = _mm_set1_ps(points[i][1]);
+        const __m128 z = _mm_set1_ps(points[i][2]);
+        
+        __m128 xyzw = _mm_add_ps(_mm_setzero_ps(), _mm_mul_ps(columns[0], x));
+        xyzw = _mm_add_ps(xyzw, _mm_mul_ps(columns[1], y));
+        xyzw = _mm_add_ps(xyzw, _mm_mul_ps(columns[2], z));
+        xyzw = _mm_add_ps(xyzw, columns[3]);
+        
+        const __m128 w = _mm_shuffle_ps(xyzw, xyzw, _MM_SHUFFLE(3, 3, 3, 3));
+        SIMD::store3(&result[i][0], _mm_div_ps(xyzw, w));
+    }
+}
+#endif
+
 template <typename T, size_t S>
 Mat<T,S,S>& transposeMatrix(Mat<T,S,S>& mat) {
     using std::swap;
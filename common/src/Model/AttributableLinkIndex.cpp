@@ -0,0 +1,98 @@
+/*
+ Copyright (C) 2010-2016 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AttributableLinkIndex.h"
+
+#include "CollectionUtils.h"
+#include "Model/EntityAttributes.h"
+
+#include <algorithm>
+
+namespace TrenchBroom {
+    namespace Model {
+        void AttributableLinkIndex::addAttribute(AttributableNode* attributable, const AttributeName& name, const AttributeValue& value) {
+            NodeMap* map = nodeMap(name);
+            if (map != NULL && !value.empty())
+                add(*map, attributable, value);
+        }
+        
+        void AttributableLinkIndex::removeAttribute(AttributableNode* attributable, const AttributeName& name, const AttributeValue& value) {
+            NodeMap* map = nodeMap(name);
+            if (map != NULL && !value.empty())
+                remove(*map, attributable, value);
+        }
+        
+        void AttributableLinkIndex::findNodesWithTargetname(const AttributeValue& value, AttributableNodeList& result) const {
+            find(m_targetnames, value, result);
+        }
+        
+        void AttributableLinkIndex::findNodesWithTarget(const AttributeValue& value, AttributableNodeList& result) const {
+            find(m_targets, value, result);
+        }
+        
+        void AttributableLinkIndex::findNodesWithKilltarget(const AttributeValue& value, AttributableNodeList& result) const {
+            find(m_killtargets, value, result);
+        }
+        
+        AttributableLinkIndex::NodeMap* AttributableLinkIndex::nodeMap(const AttributeName& name) {
+            if (name == AttributeNames::Targetname)
+                return &m_targetnames;
+            if (isNumberedAttribute(AttributeNames::Target, name))
+                return &m_targets;
+            if (isNumberedAttribute(AttributeNames::Killtarget, name))
+                return &m_killtargets;
+            return NULL;
+        }
+        
+        void AttributableLinkIndex::add(NodeMap& map, AttributableNode* attributable, const AttributeValue& value) {
+            // a node is listed once per attribute, e.g. twice if both target and target2 have the same value
+            map[value].push_back(attributable);
+        }
+        
+        void AttributableLinkIndex::remove(NodeMap& map, AttributableNode* attributable, const AttributeValue& value) {
+            NodeMap::iterator it = map.find(value);
+            if (it == std::end(map))
+                return;
+            
+            AttributableNodeList& nodes = it->second;
+            AttributableNodeList::iterator nodeIt = std::find(std::begin(nodes), std::end(nodes), attributable);
+            if (nodeIt != std::end(nodes)) {
+                *nodeIt = nodes.back();
+                nodes.pop_back();
+            }
+            if (nodes.empty())
+                map.erase(it);
+        }
+        
+        void AttributableLinkIndex::find(const NodeMap& map, const AttributeValue& value, AttributableNodeList& result) {
+            NodeMap::const_iterator it = map.find(value);
+            if (it == std::end(map))
+                return;
+            
+            const AttributableNodeList& nodes = it->second;
+            if (nodes.size() == 1) {
+                result.push_back(nodes.front());
+            } else {
+                AttributableNodeList unique = nodes;
+                VectorUtils::sortAndRemoveDuplicates(unique);
+                VectorUtils::append(result, unique);
+            }
+        }
+    }
+}
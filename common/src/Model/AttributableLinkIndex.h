@@ -0,0 +1,58 @@
+/*
+ Copyright (C) 2010-2016 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_AttributableLinkIndex
+#define TrenchBroom_AttributableLinkIndex
+
+#include "Model/ModelTypes.h"
+
+#include <map>
+
+namespace TrenchBroom {
+    namespace Model {
+        /**
+         * Maps the values of the attributes that define entity links (targetname and the numbered target and
+         * killtarget attributes) to the nodes that carry them. This lets the nodes find their link partners
+         * with a single lookup instead of querying the general attribute index.
+         */
+        class AttributableLinkIndex {
+        private:
+            typedef std::map<AttributeValue, AttributableNodeList> NodeMap;
+            
+            NodeMap m_targetnames;
+            NodeMap m_targets;
+            NodeMap m_killtargets;
+        public:
+            void addAttribute(AttributableNode* attributable, const AttributeName& name, const AttributeValue& value);
+            void removeAttribute(AttributableNode* attributable, const AttributeName& name, const AttributeValue& value);
+            
+            void findNodesWithTargetname(const AttributeValue& value, AttributableNodeList& result) const;
+            void findNodesWithTarget(const AttributeValue& value, AttributableNodeList& result) const;
+            void findNodesWithKilltarget(const AttributeValue& value, AttributableNodeList& result) const;
+        private:
+            NodeMap* nodeMap(const AttributeName& name);
+            
+            static void add(NodeMap& map, AttributableNode* attributable, const AttributeValue& value);
+            static void remove(NodeMap& map, AttributableNode* attributable, const AttributeValue& value);
+            static void find(const NodeMap& map, const AttributeValue& value, AttributableNodeList& result);
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_AttributableLinkIndex) */
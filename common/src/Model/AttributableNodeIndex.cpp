@@ -20,10 +20,14 @@
 #include "AttributableNodeIndex.h"
 
 #include "CollectionUtils.h"
+#include "Exceptions.h"
 #include "Macros.h"
+#include "StringPool.h"
 #include "Model/AttributableNode.h"
 
+#include <algorithm>
 #include <cassert>
+#include <functional>
 
 namespace TrenchBroom {
     namespace Model {
@@ -43,28 +47,22 @@ namespace TrenchBroom {
             return AttributableNodeIndexQuery(Type_Any);
         }
         
-        AttributableNodeSet AttributableNodeIndexQuery::execute(const AttributableNodeStringIndex& index) const {
-            switch (m_type) {
-                case Type_Exact:
-                    return index.queryExactMatches(m_pattern);
-                case Type_Prefix:
-                    return index.queryPrefixMatches(m_pattern);
-                case Type_Numbered:
-                    return index.queryNumberedMatches(m_pattern);
-                case Type_Any:
-                    return EmptyAttributableNodeSet;
-                switchDefault()
-            }
+        AttributableNodeIndexQuery::Type AttributableNodeIndexQuery::type() const {
+            return m_type;
         }
         
-        bool AttributableNodeIndexQuery::execute(const AttributableNode* node, const String& value) const {
+        const String& AttributableNodeIndexQuery::pattern() const {
+            return m_pattern;
+        }
+
+        bool AttributableNodeIndexQuery::matches(const AttributeName& name) const {
             switch (m_type) {
                 case Type_Exact:
-                    return node->hasAttribute(m_pattern, value);
+                    return name == m_pattern;
                 case Type_Prefix:
-                    return node->hasAttributeWithPrefix(m_pattern, value);
+                    return StringUtils::isPrefix(name, m_pattern);
                 case Type_Numbered:
-                    return node->hasNumberedAttribute(m_pattern, value);
+                    return isNumberedAttribute(m_pattern, name);
                 case Type_Any:
                     return true;
                 switchDefault()
@@ -75,6 +73,33 @@ namespace TrenchBroom {
         m_type(type),
         m_pattern(pattern) {}
 
+        size_t AttributableNodeIndex::KeyHash::operator()(const Key& key) const {
+            const std::hash<const String*> hash;
+            return hash(key.first) * 31 + hash(key.second);
+        }
+        
+        struct CompareNames {
+            bool operator()(const String* lhs, const String* rhs) const {
+                return *lhs < *rhs;
+            }
+            
+            bool operator()(const String* lhs, const String& rhs) const {
+                return *lhs < rhs;
+            }
+        };
+        
+        AttributableNodeIndex::AttributableNodeIndex() {}
+        
+        AttributableNodeIndex::~AttributableNodeIndex() {
+            StringPool& pool = StringPool::instance();
+            for (const NodeMap::value_type& entry : m_nodes) {
+                for (size_t i = 0; i < entry.second.size(); ++i) {
+                    pool.release(entry.first.first);
+                    pool.release(entry.first.second);
+                }
+            }
+        }
+
         void AttributableNodeIndex::addAttributableNode(AttributableNode* attributable) {
             for (const EntityAttribute& attribute : attributable->attributes())
                 addAttribute(attributable, attribute.name(), attribute.value());
@@ -86,35 +111,98 @@ namespace TrenchBroom {
         }
 
         void AttributableNodeIndex::addAttribute(AttributableNode* attributable, const AttributeName& name, const AttributeValue& value) {
-            m_nameIndex.insert(name, attributable);
-            m_valueIndex.insert(value, attributable);
+            StringPool& pool = StringPool::instance();
+            const String* internedName = pool.intern(name);
+            const String* internedValue = pool.intern(value);
+            
+            m_nodes[Key(internedName, internedValue)].push_back(attributable);
+            addName(internedName);
         }
         
         void AttributableNodeIndex::removeAttribute(AttributableNode* attributable, const AttributeName& name, const AttributeValue& value) {
-            m_nameIndex.remove(name, attributable);
-            m_valueIndex.remove(value, attributable);
+            StringPool& pool = StringPool::instance();
+            const String* internedName = pool.find(name);
+            const String* internedValue = pool.find(value);
+            
+            NodeMap::iterator it = m_nodes.end();
+            if (internedName != NULL && internedValue != NULL)
+                it = m_nodes.find(Key(internedName, internedValue));
+            if (it == std::end(m_nodes))
+                throw Exception("Cannot remove attribute from index");
+            
+            AttributableNodeList& nodes = it->second;
+            AttributableNodeList::iterator nIt = std::find(std::begin(nodes), std::end(nodes), attributable);
+            if (nIt == std::end(nodes))
+                throw Exception("Cannot remove attribute from index");
+            
+            nodes.erase(nIt);
+            if (nodes.empty())
+                m_nodes.erase(it);
+            
+            removeName(internedName);
+            pool.release(internedName);
+            pool.release(internedValue);
         }
 
         AttributableNodeList AttributableNodeIndex::findAttributableNodes(const AttributableNodeIndexQuery& nameQuery, const AttributeValue& value) const {
-            const AttributableNodeSet nameResult = nameQuery.execute(m_nameIndex);
-            const AttributableNodeSet valueResult = m_valueIndex.queryExactMatches(value);
+            if (nameQuery.type() == AttributableNodeIndexQuery::Type_Any)
+                return EmptyAttributableNodeList;
             
-            if (nameResult.empty() || valueResult.empty())
+            const StringPool& pool = StringPool::instance();
+            const String* internedValue = pool.find(value);
+            if (internedValue == NULL)
                 return EmptyAttributableNodeList;
-
+            
             AttributableNodeList result;
-            SetUtils::intersection(nameResult, valueResult, result);
+            if (nameQuery.type() == AttributableNodeIndexQuery::Type_Exact) {
+                const String* internedName = pool.find(nameQuery.pattern());
+                if (internedName != NULL)
+                    findNodes(internedName, internedValue, result);
+                return result;
+            }
             
-            AttributableNodeList::iterator it = std::begin(result);
-            while (it != std::end(result)) {
-                const AttributableNode* node = *it;
-                if (!nameQuery.execute(node, value))
-                    it = result.erase(it);
-                else
-                    ++it;
+            // all names that match a prefix or numbered query are in a contiguous range of the sorted name list
+            size_t matchedNames = 0;
+            NameList::const_iterator it = std::lower_bound(std::begin(m_names), std::end(m_names), nameQuery.pattern(), CompareNames());
+            while (it != std::end(m_names) && StringUtils::isPrefix(**it, nameQuery.pattern())) {
+                if (nameQuery.matches(**it) && findNodes(*it, internedValue, result))
+                    ++matchedNames;
+                ++it;
             }
             
+            // a node may carry the value in more than one matching attribute
+            if (matchedNames > 1)
+                VectorUtils::sortAndRemoveDuplicates(result);
             return result;
         }
+        
+        void AttributableNodeIndex::addName(const String* name) {
+            NameCountMap::iterator it = m_nameCounts.insert(std::make_pair(name, 0u)).first;
+            if (it->second++ == 0) {
+                NameList::iterator pos = std::lower_bound(std::begin(m_names), std::end(m_names), name, CompareNames());
+                m_names.insert(pos, name);
+            }
+        }
+        
+        void AttributableNodeIndex::removeName(const String* name) {
+            NameCountMap::iterator it = m_nameCounts.find(name);
+            assert(it != std::end(m_nameCounts));
+            if (--it->second == 0) {
+                m_nameCounts.erase(it);
+                
+                NameList::iterator pos = std::lower_bound(std::begin(m_names), std::end(m_names), name, CompareNames());
+                assert(pos != std::end(m_names) && *pos == name);
+                m_names.erase(pos);
+            }
+        }
+
+        bool AttributableNodeIndex::findNodes(const String* name, const String* value, AttributableNodeList& result) const {
+            NodeMap::const_iterator it = m_nodes.find(Key(name, value));
+            if (it == std::end(m_nodes))
+                return false;
+            
+            VectorUtils::append(result, it->second);
+            return true;
+        }
     }
 }
@@ -20,17 +20,16 @@
 #ifndef TrenchBroom_EntityAttributeIndex
 #define TrenchBroom_EntityAttributeIndex
 
+#include "Macros.h"
 #include "StringUtils.h"
 #include "Model/ModelTypes.h"
-#include "StringMap.h"
 
-#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace TrenchBroom {
     namespace Model {
-        typedef StringMultiMapValueContainer<AttributableNode*> AttributableNodeIndexValueContainer;
-        typedef StringMap<AttributableNode*, AttributableNodeIndexValueContainer> AttributableNodeStringIndex;
-        
         class AttributableNodeIndexQuery {
         public:
             typedef enum {
@@ -48,17 +47,36 @@ namespace TrenchBroom {
             static AttributableNodeIndexQuery numbered(const String& pattern);
             static AttributableNodeIndexQuery any();
 
-            AttributableNodeSet execute(const AttributableNodeStringIndex& index) const;
-            bool execute(const AttributableNode* node, const String& value) const;
+            Type type() const;
+            const String& pattern() const;
+            bool matches(const AttributeName& name) const;
         private:
             AttributableNodeIndexQuery(Type type, const String& pattern = "");
         };
         
+        /**
+         * Indexes the attributes of attributable nodes by name and value. Names and values are interned in the
+         * global string pool, and the nodes are stored in a hash map keyed by the interned name and value pair.
+         * Prefix and numbered queries find the matching names in a list of all indexed names that is sorted by
+         * content.
+         */
         class AttributableNodeIndex {
         private:
-            AttributableNodeStringIndex m_nameIndex;
-            AttributableNodeStringIndex m_valueIndex;
+            typedef std::pair<const String*, const String*> Key;
+            struct KeyHash {
+                size_t operator()(const Key& key) const;
+            };
+            typedef std::unordered_map<Key, AttributableNodeList, KeyHash> NodeMap;
+            typedef std::vector<const String*> NameList;
+            typedef std::unordered_map<const String*, size_t> NameCountMap;
+            
+            NodeMap m_nodes;
+            NameList m_names;
+            NameCountMap m_nameCounts;
         public:
+            AttributableNodeIndex();
+            ~AttributableNodeIndex();
+            
             void addAttributableNode(AttributableNode* attributable);
             void removeAttributableNode(AttributableNode* attributable);
             
@@ -66,6 +84,12 @@ namespace TrenchBroom {
             void removeAttribute(AttributableNode* attributable, const AttributeName& name, const AttributeValue& value);
             
             AttributableNodeList findAttributableNodes(const AttributableNodeIndexQuery& keyQuery, const AttributeValue& value) const;
+        private:
+            void addName(const String* name);
+            void removeName(const String* name);
+            bool findNodes(const String* name, const String* value, AttributableNodeList& result) const;
+            
+            deleteCopyAndAssignment(AttributableNodeIndex)
         };
     }
 }
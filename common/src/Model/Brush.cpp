@@ -380,6 +380,17 @@ namespace TrenchBroom {
             }
         }
 
+        Brush::Brush(const BrushFaceList& faces, BrushGeometry* geometry) :
+        m_geometry(geometry),
+        m_contentTypeBuilder(NULL),
+        m_contentType(0),
+        m_transparent(false),
+        m_contentTypeValid(true) {
+            ensure(m_geometry != NULL, "geometry is null");
+            addFaces(faces);
+            nodeBoundsDidChange();
+        }
+
         Brush::~Brush() {
             cleanup();
         }
@@ -467,6 +478,20 @@ namespace TrenchBroom {
             rebuildGeometry(worldBounds);
         }
 
+        void Brush::setFaces(const BrushFaceList& faces, BrushGeometry* geometry) {
+            ensure(geometry != NULL, "geometry is null");
+            
+            const NotifyNodeChange nodeChange(this);
+            detachFaces(m_faces);
+            VectorUtils::clearAndDelete(m_faces);
+            addFaces(faces);
+            
+            delete m_geometry;
+            m_geometry = geometry;
+            assert(checkGeometry());
+            nodeBoundsDidChange();
+        }
+
         bool Brush::fullySpecified() const {
             ensure(m_geometry != NULL, "geometry is null");
             
@@ -565,6 +590,69 @@ namespace TrenchBroom {
             }
         }
 
+        BrushGeometry* Brush::clipGeometry(const Plane3& plane) const {
+            BrushGeometry* geometry = new BrushGeometry(*m_geometry);
+            
+            // The copy contains the faces in the same order as the original, but without their payloads. We let the
+            // copied faces point to this brush's faces so that createClippedBrush knows which ones to clone, and the
+            // default callback makes sure that clipping doesn't touch them.
+            const BrushFaceGeometry* originalFace = m_geometry->faces().front();
+            BrushFaceGeometry* copiedFace = geometry->faces().front();
+            do {
+                copiedFace->setPayload(originalFace->payload());
+                originalFace = originalFace->next();
+                copiedFace = copiedFace->next();
+            } while (originalFace != m_geometry->faces().front());
+            
+            const BrushGeometry::ClipResult result = geometry->clip(plane);
+            if (result.success()) {
+                // same post processing as when the face is added in rebuildGeometry
+                if (geometry->healEdges()) {
+                    geometry->correctVertexPositions();
+                    if (geometry->healEdges())
+                        return geometry;
+                }
+            } else if (result.unchanged()) {
+                return geometry;
+            }
+            
+            delete geometry;
+            return NULL;
+        }
+        
+        Brush* Brush::createClippedBrush(BrushGeometry* geometry, BrushFace* clipFace) const {
+            ensure(geometry != NULL, "geometry is null");
+            ensure(clipFace != NULL, "clipFace is null");
+            
+            BrushFaceList faces;
+            faces.reserve(geometry->faceCount());
+            
+            bool clipFaceUsed = false;
+            for (BrushFaceGeometry* faceGeometry : geometry->faces()) {
+                const BrushFace* original = faceGeometry->payload();
+                BrushFace* face = NULL;
+                if (original == NULL) {
+                    assert(!clipFaceUsed);
+                    face = clipFace;
+                    clipFaceUsed = true;
+                } else {
+                    face = original->clone();
+                }
+                
+                faceGeometry->setPayload(face);
+                face->setGeometry(faceGeometry);
+                faces.push_back(face);
+            }
+            
+            if (!clipFaceUsed)
+                delete clipFace;
+            
+            Brush* brush = new Brush(faces, geometry);
+            brush->setContentTypeBuilder(m_contentTypeBuilder);
+            cloneAttributes(brush);
+            return brush;
+        }
+
         bool Brush::canMoveBoundary(const BBox3& worldBounds, const BrushFace* face, const Vec3& delta) const {
             BrushFace* testFace = face->clone();
             testFace->transform(translationMatrix(delta), false);
@@ -1045,12 +1133,18 @@ namespace TrenchBroom {
         }
 
         BrushList Brush::subtract(const ModelFactory& factory, const BBox3& worldBounds, const String& defaultTextureName, const Brush* subtrahend) const {
-            const BrushGeometry::SubtractResult result = m_geometry->subtract(*subtrahend->m_geometry);
-            
+            return createBrushes(factory, worldBounds, defaultTextureName, subtractGeometry(subtrahend), subtrahend);
+        }
+        
+        BrushGeometry::SubtractResult Brush::subtractGeometry(const Brush* subtrahend) const {
+            return m_geometry->subtract(*subtrahend->m_geometry);
+        }
+        
+        BrushList Brush::createBrushes(const ModelFactory& factory, const BBox3& worldBounds, const String& defaultTextureName, const BrushGeometry::SubtractResult& geometries, const Brush* subtrahend) const {
             BrushList brushes(0);
-            brushes.reserve(result.size());
+            brushes.reserve(geometries.size());
             
-            for (const BrushGeometry& geometry : result) {
+            for (const BrushGeometry& geometry : geometries) {
                 Brush* brush = createBrush(factory, worldBounds, defaultTextureName, geometry, subtrahend);
                 brushes.push_back(brush);
             }
@@ -1136,6 +1230,35 @@ namespace TrenchBroom {
             rebuildGeometry(worldBounds);
         }
 
+        BrushGeometry* Brush::copyGeometry(const BrushFaceList& faceClones) const {
+            ensure(m_geometry != NULL, "geometry is null");
+            assert(faceClones.size() == m_faces.size());
+            
+            BrushGeometry* geometry = new BrushGeometry(*m_geometry);
+            
+            // the copy contains the faces in the same order as the original
+            const BrushGeometry::FaceList& originalFaces = m_geometry->faces();
+            const BrushGeometry::FaceList& copiedFaces = geometry->faces();
+            assert(originalFaces.size() == copiedFaces.size());
+            
+            const BrushFaceGeometry* originalFace = originalFaces.front();
+            BrushFaceGeometry* copiedFace = copiedFaces.front();
+            do {
+                // the faces are usually in the order of the geometry, so this search is short
+                const size_t index = VectorUtils::indexOf(m_faces, originalFace->payload());
+                ensure(index < faceClones.size(), "face geometry has no matching face");
+                
+                BrushFace* faceClone = faceClones[index];
+                copiedFace->setPayload(faceClone);
+                faceClone->setGeometry(copiedFace);
+                
+                originalFace = originalFace->next();
+                copiedFace = copiedFace->next();
+            } while (originalFace != originalFaces.front());
+            
+            return geometry;
+        }
+
         bool Brush::checkGeometry() const {
             for (const BrushFace* face : m_faces) {
                 if (face->geometry() == NULL)
@@ -1202,6 +1325,10 @@ namespace TrenchBroom {
             ensure(m_geometry != NULL, "geometry is null");
             return m_geometry->bounds();
         }
+        
+        void Brush::doNodeBoundsDidChange() {
+            m_facePlanes.update(m_faces);
+        }
 
         Node* Brush::doClone(const BBox3& worldBounds) const {
             BrushFaceList faceClones;
@@ -1210,7 +1337,7 @@ namespace TrenchBroom {
             for (const BrushFace* face : m_faces)
                 faceClones.push_back(face->clone());
             
-            Brush* brush = new Brush(worldBounds, faceClones);
+            Brush* brush = new Brush(faceClones, copyGeometry(faceClones));
             brush->setContentTypeBuilder(m_contentTypeBuilder);
             cloneAttributes(brush);
             return brush;
@@ -1275,12 +1402,12 @@ namespace TrenchBroom {
             if (Math::isnan(bounds().intersectWithRay(ray)))
                 return BrushFaceHit();
             
-            for (BrushFace* face : m_faces) {
-                const FloatType distance = face->intersectWithRay(ray);
-                if (!Math::isnan(distance))
-                    return BrushFaceHit(face, distance);
-            }
-            return BrushFaceHit();
+            assert(m_facePlanes.size() == m_faces.size());
+            FloatType distance;
+            const size_t index = m_facePlanes.intersectWithRay(ray, distance);
+            if (index == m_facePlanes.size())
+                return BrushFaceHit();
+            return BrushFaceHit(m_faces[index], distance);
         }
 
         Node* Brush::doGetContainer() const {
@@ -26,6 +26,7 @@
 #include "ProjectingSequence.h"
 #include "Polyhedron_Matcher.h"
 #include "Model/BrushContentType.h"
+#include "Model/BrushFacePlanes.h"
 #include "Model/BrushGeometry.h"
 #include "Model/Node.h"
 #include "Model/Object.h"
@@ -39,6 +40,7 @@ namespace TrenchBroom {
         
         class Brush : public Node, public Object {
         private:
+            friend class BrushSnapshot;
             friend class SetTempFaceLinks;
         public:
             static const Hit::HitType BrushHit;
@@ -66,6 +68,7 @@ namespace TrenchBroom {
         private:
             BrushFaceList m_faces;
             BrushGeometry* m_geometry;
+            BrushFacePlanes m_facePlanes; // parallel to m_faces, updated whenever the geometry changes
             
             const BrushContentTypeBuilder* m_contentTypeBuilder;
             mutable BrushContentType::FlagType m_contentType;
@@ -75,6 +78,7 @@ namespace TrenchBroom {
             Brush(const BBox3& worldBounds, const BrushFaceList& faces);
             ~Brush();
         private:
+            Brush(const BrushFaceList& faces, BrushGeometry* geometry);
             void cleanup();
         public:
             Brush* clone(const BBox3& worldBounds) const;
@@ -89,7 +93,9 @@ namespace TrenchBroom {
             size_t faceCount() const;
             const BrushFaceList& faces() const;
             void setFaces(const BBox3& worldBounds, const BrushFaceList& faces);
-            
+        private:
+            void setFaces(const BrushFaceList& faces, BrushGeometry* geometry);
+        public:
             bool fullySpecified() const;
             
             void faceDidChange();
@@ -128,6 +134,19 @@ namespace TrenchBroom {
             void cloneInvertedFaceAttributesFrom(const Brush* brush);
         public: // clipping
             bool clip(const BBox3& worldBounds, BrushFace* face);
+            
+            /**
+             * Clips a copy of this brush's geometry by the given plane without touching any faces, so this can be
+             * called from worker threads. Returns NULL if nothing remains of the brush.
+             */
+            BrushGeometry* clipGeometry(const Plane3& plane) const;
+            
+            /**
+             * Creates a brush from geometry returned by clipGeometry, cloning the faces of this brush that remain and
+             * using the given face for the new side. Takes ownership of both arguments. Since cloning faces binds
+             * their textures, this must be called on the main thread.
+             */
+            Brush* createClippedBrush(BrushGeometry* geometry, BrushFace* clipFace) const;
         public: // move face along normal
             bool canMoveBoundary(const BBox3& worldBounds, const BrushFace* face, const Vec3& delta) const;
             void moveBoundary(const BBox3& worldBounds, BrushFace* face, const Vec3& delta, const bool lockTexture);
@@ -197,6 +216,14 @@ namespace TrenchBroom {
         public:
             // CSG operations
             BrushList subtract(const ModelFactory& factory, const BBox3& worldBounds, const String& defaultTextureName, const Brush* subtrahend) const;
+            
+            /**
+             * The two halves of subtract: subtractGeometry only computes polyhedra and can be called from worker
+             * threads, whereas createBrushes creates the faces and must be called on the main thread.
+             */
+            BrushGeometry::SubtractResult subtractGeometry(const Brush* subtrahend) const;
+            BrushList createBrushes(const ModelFactory& factory, const BBox3& worldBounds, const String& defaultTextureName, const BrushGeometry::SubtractResult& geometries, const Brush* subtrahend) const;
+            
             void intersect(const BBox3& worldBounds, const Brush* brush);
         private:
             Brush* createBrush(const ModelFactory& factory, const BBox3& worldBounds, const String& defaultTextureName, const BrushGeometry& geometry, const Brush* subtrahend) const;
@@ -207,6 +234,11 @@ namespace TrenchBroom {
             void rebuildGeometry(const BBox3& worldBounds);
             void findIntegerPlanePoints(const BBox3& worldBounds);
         private:
+            /**
+             * Copies the half edge structure of this brush's geometry and links its faces to the given clones of this
+             * brush's faces, which is much cheaper than intersecting the face planes again.
+             */
+            BrushGeometry* copyGeometry(const BrushFaceList& faceClones) const;
             bool checkGeometry() const;
         public: // content type
             bool transparent() const;
@@ -220,6 +252,7 @@ namespace TrenchBroom {
         private: // implement Node interface
             const String& doGetName() const;
             const BBox3& doGetBounds() const;
+            void doNodeBoundsDidChange();
             
             Node* doClone(const BBox3& worldBounds) const;
             NodeSnapshot* doTakeSnapshot();
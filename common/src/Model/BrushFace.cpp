@@ -146,8 +146,10 @@ namespace TrenchBroom {
         }
 
         bool BrushFace::arePointsOnPlane(const Plane3& plane) const {
+            Math::PointStatus::Type statuses[3];
+            classifyPoints(plane, m_points, 3, statuses);
             for (size_t i = 0; i < 3; i++)
-                if (plane.pointStatus(m_points[i]) != Math::PointStatus::PSInside)
+                if (statuses[i] != Math::PointStatus::PSInside)
                     return false;
             return true;
         }
@@ -291,7 +293,7 @@ namespace TrenchBroom {
 
         void BrushFace::updateTexture(Assets::TextureManager* textureManager) {
             ensure(textureManager != NULL, "textureManager is null");
-            Assets::Texture* texture = textureManager->texture(textureName());
+            Assets::Texture* texture = textureManager->texture(m_attribs.internedTextureName());
             setTexture(texture);
             invalidateVertexCache();
         }
@@ -421,8 +423,7 @@ namespace TrenchBroom {
             m_texCoordSystem->transform(m_boundary, transform, m_attribs, lockTexture, invariant);
 
             m_boundary.transform(transform);
-            for (size_t i = 0; i < 3; ++i)
-                m_points[i] = transform * m_points[i];
+            transformPoints(transform, m_points, 3, m_points);
             if (crossed(m_points[2] - m_points[0], m_points[1] - m_points[0]).dot(m_boundary.normal) < 0.0)
                 swap(m_points[1], m_points[2]);
             correctPoints();
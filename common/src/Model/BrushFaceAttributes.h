@@ -23,6 +23,7 @@
 #include "TrenchBroom.h"
 #include "VecMath.h"
 #include "StringUtils.h"
+#include "Assets/TextureName.h"
 
 namespace TrenchBroom {
     namespace Assets {
@@ -32,7 +33,7 @@ namespace TrenchBroom {
     namespace Model {
         class BrushFaceAttributes {
         private:
-            String m_textureName;
+            Assets::TextureName m_textureName;
             Assets::Texture* m_texture;
             
             Vec2f m_offset;
@@ -44,6 +45,7 @@ namespace TrenchBroom {
             float m_surfaceValue;
         public:
             BrushFaceAttributes(const String& textureName);
+            BrushFaceAttributes(const Assets::TextureName& textureName);
             BrushFaceAttributes(const BrushFaceAttributes& other);
             ~BrushFaceAttributes();
             BrushFaceAttributes& operator=(BrushFaceAttributes other);
@@ -52,6 +54,7 @@ namespace TrenchBroom {
             BrushFaceAttributes takeSnapshot() const;
             
             const String& textureName() const;
+            const Assets::TextureName& internedTextureName() const;
             Assets::Texture* texture() const;
             Vec2f textureSize() const;
             
@@ -0,0 +1,88 @@
+/*
+ Copyright (C) 2010-2016 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BrushFacePlanes.h"
+
+#include "Model/BrushFace.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace TrenchBroom {
+    namespace Model {
+        BrushFacePlanes::BrushFacePlanes() :
+        m_count(0) {}
+        
+        void BrushFacePlanes::update(const BrushFaceList& faces) {
+            m_count = faces.size();
+            m_components.resize(4 * m_count);
+            
+            FloatType* normalX = m_components.data();
+            FloatType* normalY = normalX + m_count;
+            FloatType* normalZ = normalY + m_count;
+            FloatType* distance = normalZ + m_count;
+            
+            for (size_t i = 0; i < m_count; ++i) {
+                const Plane3& boundary = faces[i]->boundary();
+                normalX[i] = boundary.normal.x();
+                normalY[i] = boundary.normal.y();
+                normalZ[i] = boundary.normal.z();
+                distance[i] = boundary.distance;
+            }
+        }
+        
+        size_t BrushFacePlanes::size() const {
+            return m_count;
+        }
+        
+        size_t BrushFacePlanes::intersectWithRay(const Ray3& ray, FloatType& distance) const {
+            const FloatType* normalX = m_components.data();
+            const FloatType* normalY = normalX + m_count;
+            const FloatType* normalZ = normalY + m_count;
+            const FloatType* distances = normalZ + m_count;
+            
+            FloatType enter = -std::numeric_limits<FloatType>::max();
+            FloatType exit  =  std::numeric_limits<FloatType>::max();
+            size_t enterIndex = m_count;
+            
+            for (size_t i = 0; i < m_count; ++i) {
+                const FloatType dot = normalX[i] * ray.direction.x() + normalY[i] * ray.direction.y() + normalZ[i] * ray.direction.z();
+                const FloatType originDistance = normalX[i] * ray.origin.x() + normalY[i] * ray.origin.y() + normalZ[i] * ray.origin.z() - distances[i];
+                
+                if (dot < 0.0) {
+                    const FloatType t = -originDistance / dot;
+                    if (t > enter) {
+                        enter = t;
+                        enterIndex = i;
+                    }
+                } else if (dot > 0.0) {
+                    exit = std::min(exit, -originDistance / dot);
+                } else if (originDistance > 0.0) {
+                    return m_count; // the ray is parallel to this plane and runs above it
+                }
+            }
+            
+            if (enterIndex == m_count || Math::neg(enter) || Math::gt(enter, exit))
+                return m_count;
+            
+            distance = enter;
+            return enterIndex;
+        }
+    }
+}
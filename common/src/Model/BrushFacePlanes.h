@@ -0,0 +1,55 @@
+/*
+ Copyright (C) 2010-2016 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_BrushFacePlanes
+#define TrenchBroom_BrushFacePlanes
+
+#include "TrenchBroom.h"
+#include "VecMath.h"
+#include "Model/ModelTypes.h"
+
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        /**
+         * The boundary planes of a brush's faces, stored as separate arrays of normal components and distances so
+         * that a ray can be intersected with the brush without touching the faces or their polygons.
+         */
+        class BrushFacePlanes {
+        private:
+            size_t m_count;
+            std::vector<FloatType> m_components; // all normal x, then all normal y, all normal z, all distances
+        public:
+            BrushFacePlanes();
+            
+            void update(const BrushFaceList& faces);
+            size_t size() const;
+            
+            /**
+             * Clips the given ray against all planes and returns the index of the plane through which the ray enters
+             * the convex volume bounded by the planes, storing the distance to the entry point in the given
+             * distance. Returns size() if the ray misses the volume or if its origin is inside the volume.
+             */
+            size_t intersectWithRay(const Ray3& ray, FloatType& distance) const;
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_BrushFacePlanes) */
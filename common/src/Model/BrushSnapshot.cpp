@@ -26,11 +26,13 @@
 namespace TrenchBroom {
     namespace Model {
         BrushSnapshot::BrushSnapshot(Brush* brush) :
-        m_brush(brush) {
+        m_brush(brush),
+        m_geometry(NULL) {
             takeSnapshot(brush);
         }
 
         BrushSnapshot::~BrushSnapshot() {
+            delete m_geometry;
             VectorUtils::clearAndDelete(m_faces);
         }
 
@@ -40,11 +42,13 @@ namespace TrenchBroom {
                 faceClone->setTexture(nullptr);
                 m_faces.push_back(faceClone);
             }
+            m_geometry = brush->copyGeometry(m_faces);
         }
         
         void BrushSnapshot::doRestore(const BBox3& worldBounds) {
-            m_brush->setFaces(worldBounds, m_faces);
+            m_brush->setFaces(m_faces, m_geometry);
             m_faces.clear();
+            m_geometry = NULL;
         }
     }
 }
@@ -20,6 +20,7 @@
 #ifndef TrenchBroom_BrushSnapshot
 #define TrenchBroom_BrushSnapshot
 
+#include "Model/BrushGeometry.h"
 #include "Model/ModelTypes.h"
 #include "Model/NodeSnapshot.h"
 
@@ -34,6 +35,7 @@ namespace TrenchBroom {
         private:
             Brush* m_brush;
             BrushFaceList m_faces;
+            BrushGeometry* m_geometry;
         public:
             BrushSnapshot(Brush* brush);
             ~BrushSnapshot();
@@ -40,7 +40,8 @@ namespace TrenchBroom {
         Entity::Entity() :
         AttributableNode(),
         Object(),
-        m_boundsValid(false) {}
+        m_boundsValid(false),
+        m_modelSpecificationValid(false) {}
 
         bool Entity::brushEntity() const {
             return !pointEntity();
@@ -82,11 +83,10 @@ namespace TrenchBroom {
             EntityRotationPolicy::applyRotation(this, transformation);
         }
 
-        Assets::ModelSpecification Entity::modelSpecification() const {
-            if (m_definition == NULL || !pointEntity())
-                return Assets::ModelSpecification();
-            Assets::PointEntityDefinition* pointDefinition = static_cast<Assets::PointEntityDefinition*>(m_definition);
-            return pointDefinition->model(m_attributes);
+        const Assets::ModelSpecification& Entity::modelSpecification() const {
+            if (!m_modelSpecificationValid)
+                validateModelSpecification();
+            return m_modelSpecification;
         }
 
         const BBox3& Entity::doGetBounds() const {
@@ -213,6 +213,8 @@ namespace TrenchBroom {
         }
 
         void Entity::doAttributesDidChange() {
+            // also called when the definition changes
+            invalidateModelSpecification();
             nodeBoundsDidChange();
         }
         
@@ -317,5 +319,19 @@ namespace TrenchBroom {
             }
             m_boundsValid = true;
         }
+        
+        void Entity::invalidateModelSpecification() {
+            m_modelSpecificationValid = false;
+        }
+        
+        void Entity::validateModelSpecification() const {
+            if (m_definition == NULL || !pointEntity()) {
+                m_modelSpecification = Assets::ModelSpecification();
+            } else {
+                const Assets::PointEntityDefinition* pointDefinition = static_cast<const Assets::PointEntityDefinition*>(m_definition);
+                m_modelSpecification = pointDefinition->model(m_attributes);
+            }
+            m_modelSpecificationValid = true;
+        }
     }
 }
@@ -24,6 +24,7 @@
 #include "VecMath.h"
 #include "Hit.h"
 #include "Assets/AssetTypes.h"
+#include "Assets/ModelDefinition.h"
 #include "Model/AttributableNode.h"
 #include "Model/EntityRotationPolicy.h"
 #include "Model/Object.h"
@@ -39,6 +40,8 @@ namespace TrenchBroom {
             static const BBox3 DefaultBounds;
             mutable BBox3 m_bounds;
             mutable bool m_boundsValid;
+            mutable Assets::ModelSpecification m_modelSpecification;
+            mutable bool m_modelSpecificationValid;
         public:
             Entity();
             
@@ -52,7 +55,7 @@ namespace TrenchBroom {
             void setOrigin(const Vec3& origin);
             void applyRotation(const Mat4x4& transformation);
         public: // entity model
-            Assets::ModelSpecification modelSpecification() const;
+            const Assets::ModelSpecification& modelSpecification() const;
         private: // implement Node interface
             const BBox3& doGetBounds() const;
 
@@ -95,6 +98,9 @@ namespace TrenchBroom {
         private:
             void invalidateBounds();
             void validateBounds() const;
+            
+            void invalidateModelSpecification();
+            void validateModelSpecification() const;
         private:
             Entity(const Entity&);
             Entity& operator=(const Entity&);
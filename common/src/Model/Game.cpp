@@ -52,6 +52,10 @@ namespace TrenchBroom {
         void Game::setAdditionalSearchPaths(const IO::Path::List& searchPaths) {
             doSetAdditionalSearchPaths(searchPaths);
         }
+        
+        void Game::refreshFileSystem() {
+            doRefreshFileSystem();
+        }
 
         CompilationConfig& Game::compilationConfig() {
             return doCompilationConfig();
@@ -66,7 +70,11 @@ namespace TrenchBroom {
         }
         
         World* Game::loadMap(const MapFormat::Type format, const BBox3& worldBounds, const IO::Path& path, Logger* logger) const {
-            return doLoadMap(format, worldBounds, path, logger);
+            return doLoadMap(format, worldBounds, path, logger, WorldspawnCallback());
+        }
+        
+        World* Game::loadMap(const MapFormat::Type format, const BBox3& worldBounds, const IO::Path& path, Logger* logger, const WorldspawnCallback& worldspawnCallback) const {
+            return doLoadMap(format, worldBounds, path, logger, worldspawnCallback);
         }
 
         void Game::writeMap(World* world, const IO::Path& path) const {
@@ -103,6 +111,10 @@ namespace TrenchBroom {
             doLoadTextureCollections(world, documentPath, textureManager);
         }
 
+        Assets::TextureCollectionList Game::readTextureCollections(const EL::VariableStore& variables, const IO::Path& documentPath, const IO::Path::List& paths, Logger* logger) const {
+            return doReadTextureCollections(variables, documentPath, paths, logger);
+        }
+
         bool Game::isTextureCollection(const IO::Path& path) const {
             return doIsTextureCollection(path);
         }
@@ -34,9 +34,15 @@
 #include "Model/MapFormat.h"
 #include "Model/ModelTypes.h"
 
+#include <functional>
+
 namespace TrenchBroom {
     class Logger;
     
+    namespace EL {
+        class VariableStore;
+    }
+    
     namespace Assets {
         class TextureManager;
     }
@@ -54,6 +60,8 @@ namespace TrenchBroom {
                 TP_File,
                 TP_Directory
             } TexturePackageType;
+            
+            typedef std::function<void(const World* world)> WorldspawnCallback;
         private:
             mutable BrushContentTypeBuilder* m_brushContentTypeBuilder;
         protected:
@@ -68,12 +76,23 @@ namespace TrenchBroom {
             void setGamePath(const IO::Path& gamePath);
             void setAdditionalSearchPaths(const IO::Path::List& searchPaths);
             
+            /**
+             * Makes the game file system pick up files that were added, removed or renamed outside the editor.
+             */
+            void refreshFileSystem();
+            
             CompilationConfig& compilationConfig();
             
             size_t maxPropertyLength() const;
         public: // loading and writing map files
             World* newMap(MapFormat::Type format, const BBox3& worldBounds) const;
             World* loadMap(MapFormat::Type format, const BBox3& worldBounds, const IO::Path& path, Logger* logger) const;
+            
+            /**
+             * Loads a map and calls the given callback as soon as the attributes of the worldspawn entity have been
+             * read, while the remainder of the file is still being parsed. The callback must not modify the world.
+             */
+            World* loadMap(MapFormat::Type format, const BBox3& worldBounds, const IO::Path& path, Logger* logger, const WorldspawnCallback& worldspawnCallback) const;
             void writeMap(World* world, const IO::Path& path) const;
             void exportMap(World* world, Model::ExportFormat format, const IO::Path& path) const;
         public: // parsing and serializing objects
@@ -85,6 +104,13 @@ namespace TrenchBroom {
         public: // texture collection handling
             TexturePackageType texturePackageType() const;
             void loadTextureCollections(World* world, const IO::Path& documentPath, Assets::TextureManager& textureManager) const;
+            
+            /**
+             * Reads the texture collections with the given paths without modifying any world or texture manager,
+             * so this can be called from a worker thread as long as the game's search paths are not changed in the
+             * meantime. Collections that cannot be read are returned unloaded, and the error is logged.
+             */
+            Assets::TextureCollectionList readTextureCollections(const EL::VariableStore& variables, const IO::Path& documentPath, const IO::Path::List& paths, Logger* logger) const;
             bool isTextureCollection(const IO::Path& path) const;
             IO::Path::List findTextureCollections() const;
             IO::Path::List extractTextureCollections(const World* world) const;
@@ -109,12 +135,13 @@ namespace TrenchBroom {
             virtual IO::Path doGamePath() const = 0;
             virtual void doSetGamePath(const IO::Path& gamePath) = 0;
             virtual void doSetAdditionalSearchPaths(const IO::Path::List& searchPaths) = 0;
+            virtual void doRefreshFileSystem() = 0;
             
             virtual CompilationConfig& doCompilationConfig() = 0;
             virtual size_t doMaxPropertyLength() const = 0;
             
             virtual World* doNewMap(MapFormat::Type format, const BBox3& worldBounds) const = 0;
-            virtual World* doLoadMap(MapFormat::Type format, const BBox3& worldBounds, const IO::Path& path, Logger* logger) const = 0;
+            virtual World* doLoadMap(MapFormat::Type format, const BBox3& worldBounds, const IO::Path& path, Logger* logger, const WorldspawnCallback& worldspawnCallback) const = 0;
             virtual void doWriteMap(World* world, const IO::Path& path) const = 0;
             virtual void doExportMap(World* world, Model::ExportFormat format, const IO::Path& path) const = 0;
             
@@ -125,6 +152,7 @@ namespace TrenchBroom {
             
             virtual TexturePackageType doTexturePackageType() const = 0;
             virtual void doLoadTextureCollections(World* world, const IO::Path& documentPath, Assets::TextureManager& textureManager) const = 0;
+            virtual Assets::TextureCollectionList doReadTextureCollections(const EL::VariableStore& variables, const IO::Path& documentPath, const IO::Path::List& paths, Logger* logger) const = 0;
             virtual bool doIsTextureCollection(const IO::Path& path) const = 0;
             virtual IO::Path::List doFindTextureCollections() const = 0;
             virtual IO::Path::List doExtractTextureCollections(const World* world) const = 0;
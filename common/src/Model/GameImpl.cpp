@@ -19,8 +19,10 @@
 
 #include "GameImpl.h"
 
+#include "Logger.h"
 #include "Macros.h"
 #include "Assets/Palette.h"
+#include "Assets/TextureCollection.h"
 #include "IO/BrushFaceReader.h"
 #include "IO/Bsp29Parser.h"
 #include "IO/DefParser.h"
@@ -61,6 +63,9 @@ namespace TrenchBroom {
         }
 
         void GameImpl::initializeFileSystem() {
+            // the palettes may now resolve to different files
+            Assets::Palette::clearCache();
+            
             try {
                 const GameConfig::FileSystemConfig& fileSystemConfig = m_config.fileSystemConfig();
                 if (!m_gamePath.isEmpty() && IO::Disk::directoryExists(m_gamePath)) {
@@ -116,6 +121,10 @@ namespace TrenchBroom {
             m_gameFS.clear();
             initializeFileSystem();
         }
+        
+        void GameImpl::doRefreshFileSystem() {
+            m_gameFS.refresh();
+        }
 
         CompilationConfig& GameImpl::doCompilationConfig() {
             return m_config.compilationConfig();
@@ -129,10 +138,11 @@ namespace TrenchBroom {
             return new World(format, brushContentTypeBuilder(), worldBounds);
         }
 
-        World* GameImpl::doLoadMap(const MapFormat::Type format, const BBox3& worldBounds, const IO::Path& path, Logger* logger) const {
+        World* GameImpl::doLoadMap(const MapFormat::Type format, const BBox3& worldBounds, const IO::Path& path, Logger* logger, const WorldspawnCallback& worldspawnCallback) const {
             IO::SimpleParserStatus parserStatus(logger);
             const IO::MappedFile::Ptr file = IO::Disk::openFile(IO::Disk::fixPath(path));
             IO::WorldReader reader(file->begin(), file->end(), brushContentTypeBuilder());
+            reader.setWorldspawnCallback(worldspawnCallback);
             return reader.read(format, worldBounds, parserStatus);
         }
 
@@ -200,6 +210,28 @@ namespace TrenchBroom {
             textureLoader.loadTextures(paths, textureManager);
         }
 
+        Assets::TextureCollectionList GameImpl::doReadTextureCollections(const EL::VariableStore& variables, const IO::Path& documentPath, const IO::Path::List& paths, Logger* logger) const {
+            const IO::Path::List fileSearchPaths = textureCollectionSearchPaths(documentPath);
+            IO::TextureLoader textureLoader(variables, m_gameFS, fileSearchPaths, m_config.textureConfig());
+            
+            Assets::TextureCollectionList result;
+            result.reserve(paths.size());
+            
+            for (const IO::Path& path : paths) {
+                try {
+                    result.push_back(textureLoader.loadTextureCollection(path));
+                    if (logger != NULL)
+                        logger->info("Loaded texture collection '" + path.asString() + "'");
+                } catch (const Exception& e) {
+                    result.push_back(new Assets::TextureCollection(path));
+                    if (logger != NULL)
+                        logger->error("Could not load texture collection '" + path.asString() + "': " + e.what());
+                }
+            }
+            
+            return result;
+        }
+
         IO::Path::List GameImpl::textureCollectionSearchPaths(const IO::Path& documentPath) const {
             IO::Path::List result;
             result.push_back(documentPath);
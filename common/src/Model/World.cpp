@@ -198,19 +198,30 @@ namespace TrenchBroom {
         }
         
         void World::doFindAttributableNodesWithAttribute(const AttributeName& name, const AttributeValue& value, AttributableNodeList& result) const {
-            VectorUtils::append(result, m_attributableIndex.findAttributableNodes(AttributableNodeIndexQuery::exact(name), value));
+            // the link index only knows non-empty values
+            if (name == AttributeNames::Targetname && !value.empty())
+                m_linkIndex.findNodesWithTargetname(value, result);
+            else
+                VectorUtils::append(result, m_attributableIndex.findAttributableNodes(AttributableNodeIndexQuery::exact(name), value));
         }
         
         void World::doFindAttributableNodesWithNumberedAttribute(const AttributeName& prefix, const AttributeValue& value, AttributableNodeList& result) const {
-            VectorUtils::append(result, m_attributableIndex.findAttributableNodes(AttributableNodeIndexQuery::numbered(prefix), value));
+            if (prefix == AttributeNames::Target && !value.empty())
+                m_linkIndex.findNodesWithTarget(value, result);
+            else if (prefix == AttributeNames::Killtarget && !value.empty())
+                m_linkIndex.findNodesWithKilltarget(value, result);
+            else
+                VectorUtils::append(result, m_attributableIndex.findAttributableNodes(AttributableNodeIndexQuery::numbered(prefix), value));
         }
         
         void World::doAddToIndex(AttributableNode* attributable, const AttributeName& name, const AttributeValue& value) {
             m_attributableIndex.addAttribute(attributable, name, value);
+            m_linkIndex.addAttribute(attributable, name, value);
         }
         
         void World::doRemoveFromIndex(AttributableNode* attributable, const AttributeName& name, const AttributeValue& value) {
             m_attributableIndex.removeAttribute(attributable, name, value);
+            m_linkIndex.removeAttribute(attributable, name, value);
         }
 
         void World::doAttributesDidChange() {}
@@ -23,6 +23,7 @@
 #include "TrenchBroom.h"
 #include "VecMath.h"
 #include "Model/AttributableNode.h"
+#include "Model/AttributableLinkIndex.h"
 #include "Model/AttributableNodeIndex.h"
 #include "Model/IssueGeneratorRegistry.h"
 #include "Model/MapFormat.h"
@@ -40,6 +41,7 @@ namespace TrenchBroom {
             ModelFactoryImpl m_factory;
             Layer* m_defaultLayer;
             AttributableNodeIndex m_attributableIndex;
+            AttributableLinkIndex m_linkIndex;
             IssueGeneratorRegistry m_issueGeneratorRegistry;
             bool m_issuesMustBeValidated;
         public:
@@ -0,0 +1,197 @@
+/*
+ Copyright (C) 2010-2016 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_ParallelUtils_h
+#define TrenchBroom_ParallelUtils_h
+
+#include "Macros.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ParallelUtils {
+    inline size_t workerCount(const size_t taskCount) {
+        const size_t hardwareThreads = std::max(static_cast<size_t>(std::thread::hardware_concurrency()), static_cast<size_t>(1));
+        return std::min(hardwareThreads, taskCount);
+    }
+    
+    /**
+     A fixed set of worker threads that run submitted tasks in submission order. The threads are started once and
+     reused, so handing work to them is much cheaper than starting new threads. Tasks that are still queued when
+     the pool is destroyed are dropped.
+     */
+    class ThreadPool {
+    public:
+        typedef std::function<void()> Task;
+    private:
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        std::deque<Task> m_tasks;
+        std::vector<std::thread> m_threads;
+        bool m_stopping;
+    public:
+        explicit ThreadPool(const size_t threadCount) :
+        m_stopping(false) {
+            m_threads.reserve(threadCount);
+            for (size_t i = 0; i < threadCount; ++i)
+                m_threads.push_back(std::thread([this]() { run(); }));
+        }
+        
+        ~ThreadPool() {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stopping = true;
+                m_tasks.clear();
+            }
+            m_condition.notify_all();
+            for (std::thread& thread : m_threads)
+                thread.join();
+        }
+        
+        /**
+         The pool shared by the whole application. Together with the calling thread, its workers occupy every
+         hardware thread.
+         */
+        static ThreadPool& instance() {
+            static ThreadPool pool(std::max(static_cast<size_t>(std::thread::hardware_concurrency()), static_cast<size_t>(2)) - 1);
+            return pool;
+        }
+        
+        size_t threadCount() const {
+            return m_threads.size();
+        }
+        
+        void submit(const Task& task) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_tasks.push_back(task);
+            }
+            m_condition.notify_one();
+        }
+    private:
+        void run() {
+            while (true) {
+                Task task;
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_condition.wait(lock, [this]() { return m_stopping || !m_tasks.empty(); });
+                    if (m_stopping)
+                        return;
+                    task = m_tasks.front();
+                    m_tasks.pop_front();
+                }
+                task();
+            }
+        }
+        
+        deleteCopyAndAssignment(ThreadPool)
+    };
+    
+    /**
+     Calls func(i) for every i in [0, count) on the calling thread and at most threadCount - 1 workers of the
+     shared thread pool, all of which pull indices from a shared counter. Returns once all calls have completed.
+     If any call throws, the first exception is rethrown in the calling thread after all workers have finished.
+     
+     The calling thread does not wait for workers that have not picked up their task by the time all indices have
+     been handed out, so this may be called from a pool worker without deadlocking.
+     
+     The calls must not touch shared mutable state without synchronization.
+     */
+    template <typename F>
+    void parallelFor(const size_t count, const size_t threadCount, F func) {
+        if (threadCount <= 1 || count <= 1) {
+            for (size_t i = 0; i < count; ++i)
+                func(i);
+            return;
+        }
+        
+        std::atomic<size_t> next(0);
+        std::atomic<bool> failed(false);
+        std::exception_ptr exception;
+        
+        auto work = [&]() {
+            size_t i;
+            while (!failed && (i = next++) < count) {
+                try {
+                    func(i);
+                } catch (...) {
+                    if (!failed.exchange(true))
+                        exception = std::current_exception();
+                }
+            }
+        };
+        
+        // The helpers may outlive this call if they are picked up late, so they share this state with it. A helper
+        // only touches the local variables above if it has registered as active before the call was closed.
+        struct Helpers {
+            std::mutex mutex;
+            std::condition_variable finished;
+            size_t active;
+            bool closed;
+            
+            Helpers() : active(0), closed(false) {}
+        };
+        std::shared_ptr<Helpers> helpers(new Helpers());
+        
+        ThreadPool& pool = ThreadPool::instance();
+        const size_t helperCount = std::min(threadCount - 1, pool.threadCount());
+        for (size_t i = 0; i < helperCount; ++i) {
+            pool.submit([helpers, &work]() {
+                {
+                    std::lock_guard<std::mutex> lock(helpers->mutex);
+                    if (helpers->closed)
+                        return;
+                    ++helpers->active;
+                }
+                work();
+                {
+                    std::lock_guard<std::mutex> lock(helpers->mutex);
+                    if (--helpers->active == 0)
+                        helpers->finished.notify_all();
+                }
+            });
+        }
+        work();
+        
+        {
+            std::unique_lock<std::mutex> lock(helpers->mutex);
+            helpers->closed = true;
+            helpers->finished.wait(lock, [&helpers]() { return helpers->active == 0; });
+        }
+        
+        if (exception)
+            std::rethrow_exception(exception);
+    }
+    
+    template <typename F>
+    void parallelFor(const size_t count, F func) {
+        parallelFor(count, workerCount(count), func);
+    }
+}
+
+#endif
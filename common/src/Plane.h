@@ -24,6 +24,7 @@ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
 #include "MathUtils.h"
 #include "Mat.h"
 #include "Ray.h"
+#include "SIMD.h"
 #include "Vec.h"
 #include <vector>
 
@@ -248,6 +249,79 @@ public:
     }
 };
 
+// Classifies the given points against the given plane and stores the status of each point in the result array.
+template <typename T, size_t S>
+void classifyPoints(const Plane<T,S>& plane, const Vec<T,S>* points, const size_t count, Math::PointStatus::Type* result, const T epsilon = Math::Constants<T>::pointStatusEpsilon()) {
+    for (size_t i = 0; i < count; ++i)
+        result[i] = plane.pointStatus(points[i], epsilon);
+}
+
+#ifdef TB_SIMD_SSE2
+inline Math::PointStatus::Type pointStatusFromMasks(const int aboveMask, const int belowMask, const size_t lane) {
+    if ((aboveMask >> lane) & 1)
+        return Math::PointStatus::PSAbove;
+    if ((belowMask >> lane) & 1)
+        return Math::PointStatus::PSBelow;
+    return Math::PointStatus::PSInside;
+}
+
+// Computes the same distances in the same order as Plane::pointDistance, so the results are identical.
+inline void classifyPoints(const Plane<double,3>& plane, const Vec<double,3>* points, const size_t count, Math::PointStatus::Type* result, const double epsilon = Math::Constants<double>::pointStatusEpsilon()) {
+    const __m128d normalX = _mm_set1_pd(plane.normal[0]);
+    const __m128d normalY = _mm_set1_pd(plane.normal[1]);
+    const __m128d normalZ = _mm_set1_pd(plane.normal[2]);
+    const __m128d distance = _mm_set1_pd(plane.distance);
+    const __m128d above = _mm_set1_pd(epsilon);
+    const __m128d below = _mm_set1_pd(-epsilon);
+    
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        const Vec<double,3>& p0 = points[i];
+        const Vec<double,3>& p1 = points[i + 1];
+        
+        __m128d dist = _mm_add_pd(_mm_setzero_pd(), _mm_mul_pd(_mm_set_pd(p1[0], p0[0]), normalX));
+        dist = _mm_add_pd(dist, _mm_mul_pd(_mm_set_pd(p1[1], p0[1]), normalY));
+        dist = _mm_add_pd(dist, _mm_mul_pd(_mm_set_pd(p1[2], p0[2]), normalZ));
+        dist = _mm_sub_pd(dist, distance);
+        
+        const int aboveMask = _mm_movemask_pd(_mm_cmpgt_pd(dist, above));
+        const int belowMask = _mm_movemask_pd(_mm_cmplt_pd(dist, below));
+        for (size_t j = 0; j < 2; ++j)
+            result[i + j] = pointStatusFromMasks(aboveMask, belowMask, j);
+    }
+    
+    for (; i < count; ++i)
+        result[i] = plane.pointStatus(points[i], epsilon);
+}
+
+inline void classifyPoints(const Plane<float,3>& plane, const Vec<float,3>* points, const size_t count, Math::PointStatus::Type* result, const float epsilon = Math::Constants<float>::pointStatusEpsilon()) {
+    const __m128 normalX = _mm_set1_ps(plane.normal[0]);
+    const __m128 normalY = _mm_set1_ps(plane.normal[1]);
+    const __m128 normalZ = _mm_set1_ps(plane.normal[2]);
+    const __m128 distance = _mm_set1_ps(plane.distance);
+    const __m128 above = _mm_set1_ps(epsilon);
+    const __m128 below = _mm_set1_ps(-epsilon);
+    
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const Vec<float,3>* p = points + i;
+        
+        __m128 dist = _mm_add_ps(_mm_setzero_ps(), _mm_mul_ps(_mm_set_ps(p[3][0], p[2][0], p[1][0], p[0][0]), normalX));
+        dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set_ps(p[3][1], p[2][1], p[1][1], p[0][1]), normalY));
+        dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set_ps(p[3][2], p[2][2], p[1][2], p[0][2]), normalZ));
+        dist = _mm_sub_ps(dist, distance);
+        
+        const int aboveMask = _mm_movemask_ps(_mm_cmpgt_ps(dist, above));
+        const int belowMask = _mm_movemask_ps(_mm_cmplt_ps(dist, below));
+        for (size_t j = 0; j < 4; ++j)
+            result[i + j] = pointStatusFromMasks(aboveMask, belowMask, j);
+    }
+    
+    for (; i < count; ++i)
+        result[i] = plane.pointStatus(points[i], epsilon);
+}
+#endif
+
 template <typename T>
 bool setPlanePoints(Plane<T,3>& plane, const Vec<T,3>* points) {
     return setPlanePoints(plane, points[0], points[1], points[2]);
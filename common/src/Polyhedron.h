@@ -396,6 +396,11 @@ public: // Convex hull; adding and removing points
 private:
     template <typename I> void addPoints(I cur, I end);
     template <typename I> void addPoints(I cur, I end, Callback& callback);
+    
+    class ConflictTracker;
+    void quickHull(typename V::List points, Callback& callback);
+    static void removeDuplicatePoints(typename V::List& points);
+    static bool findInitialTetrahedron(const typename V::List& points, size_t indices[4]);
 public:
     Vertex* addPoint(const V& position);
     Vertex* addPoint(const V& position, Callback& callback);
@@ -69,23 +69,35 @@ typename Polyhedron<T,FP,VP>::ClipResult Polyhedron<T,FP,VP>::checkIntersects(co
     size_t below = 0;
     size_t inside = 0;
 
+    // classify the vertex positions in blocks so that they can be processed by the batch kernel
+    static const size_t BlockSize = 32;
+    Vec<T,3> positions[BlockSize];
+    Math::PointStatus::Type statuses[BlockSize];
+    
     const Vertex* firstVertex = m_vertices.front();
     const Vertex* currentVertex = firstVertex;
     do {
-        const Math::PointStatus::Type status = plane.pointStatus(currentVertex->position());
-        switch (status) {
-            case Math::PointStatus::PSAbove:
-                ++above;
-                break;
-            case Math::PointStatus::PSBelow:
-                ++below;
-                break;
-            case Math::PointStatus::PSInside:
-                ++inside;
-                break;
-            switchDefault()
+        size_t count = 0;
+        do {
+            positions[count++] = currentVertex->position();
+            currentVertex = currentVertex->next();
+        } while (count < BlockSize && currentVertex != firstVertex);
+        
+        classifyPoints(plane, positions, count, statuses);
+        for (size_t i = 0; i < count; ++i) {
+            switch (statuses[i]) {
+                case Math::PointStatus::PSAbove:
+                    ++above;
+                    break;
+                case Math::PointStatus::PSBelow:
+                    ++below;
+                    break;
+                case Math::PointStatus::PSInside:
+                    ++inside;
+                    break;
+                switchDefault()
+            }
         }
-        currentVertex = currentVertex->next();
     } while (currentVertex != firstVertex);
     
     assert(above + below + inside == m_vertices.size());
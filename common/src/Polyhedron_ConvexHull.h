@@ -20,7 +20,9 @@
 #ifndef TrenchBroom_Polyhedron_ConvexHull_h
 #define TrenchBroom_Polyhedron_ConvexHull_h
 
+#include <algorithm>
 #include <list>
+#include <map>
 
 template <typename T, typename FP, typename VP>
 class Polyhedron<T,FP,VP>::Seam {
@@ -174,8 +176,321 @@ void Polyhedron<T,FP,VP>::addPoints(I cur, I end) {
 
 template <typename T, typename FP, typename VP> template <typename I>
 void Polyhedron<T,FP,VP>::addPoints(I cur, I end, Callback& callback) {
-    while (cur != end)
-        addPoint(*cur++, callback);
+    if (empty()) {
+        quickHull(typename V::List(cur, end), callback);
+    } else {
+        while (cur != end)
+            addPoint(*cur++, callback);
+    }
+}
+
+/*
+ Tracks the outside sets of the faces of a polyhedron while points are added to it. Every point in the outside set
+ of a face is above that face. When a face is deleted or changed, its outside set is orphaned and must be reassigned
+ to the faces that have changed or were created since the last reassignment. Orphaned points that are not above any
+ of these faces are inside the polyhedron and are dropped.
+ 
+ Faces are identified by the order in which the tracker first sees them rather than by their addresses, so that the
+ order in which the outside sets are processed, and hence the resulting hull, does not depend on memory layout.
+ 
+ All callbacks are forwarded to the wrapped callback.
+ */
+template <typename T, typename FP, typename VP>
+class Polyhedron<T,FP,VP>::ConflictTracker : public Polyhedron<T,FP,VP>::Callback {
+private:
+    struct OutsideSet {
+        Plane<T,3> plane;
+        typename V::List points;
+    };
+    typedef std::map<Face*, size_t> FaceIds;
+    typedef std::map<size_t, OutsideSet> OutsideSets;
+    typedef std::map<size_t, Face*> ChangedFaces;
+    
+    Callback& m_callback;
+    FaceIds m_faceIds;
+    size_t m_nextFaceId;
+    OutsideSets m_outsideSets;
+    ChangedFaces m_changedFaces;
+    typename V::List m_orphans;
+public:
+    ConflictTracker(Callback& callback) :
+    m_callback(callback),
+    m_nextFaceId(0) {}
+    
+    void initialize(const FaceList& faces, const typename V::List& points) {
+        m_changedFaces.clear();
+        m_orphans = points;
+        
+        const Face* firstFace = faces.front();
+        const Face* currentFace = firstFace;
+        do {
+            changed(const_cast<Face*>(currentFace));
+            currentFace = currentFace->next();
+        } while (currentFace != firstFace);
+        
+        reassignOrphans();
+    }
+    
+    bool hasOutsidePoints() const {
+        return !m_outsideSets.empty();
+    }
+    
+    // Removes and returns the point that is furthest above its face from the first nonempty outside set.
+    V takeFurthestPoint() {
+        assert(hasOutsidePoints());
+        typename OutsideSets::iterator it = std::begin(m_outsideSets);
+        OutsideSet& outsideSet = it->second;
+        typename V::List& points = outsideSet.points;
+        
+        size_t furthest = 0;
+        T furthestDistance = outsideSet.plane.pointDistance(points[0]);
+        for (size_t i = 1; i < points.size(); ++i) {
+            const T distance = outsideSet.plane.pointDistance(points[i]);
+            if (distance > furthestDistance) {
+                furthest = i;
+                furthestDistance = distance;
+            }
+        }
+        
+        const V result = points[furthest];
+        points[furthest] = points.back();
+        points.pop_back();
+        if (points.empty())
+            m_outsideSets.erase(it);
+        return result;
+    }
+    
+    void reassignOrphans() {
+        std::vector<std::pair<size_t, Plane<T,3> > > candidates;
+        candidates.reserve(m_changedFaces.size());
+        
+        for (const auto& entry : m_changedFaces) {
+            Face* face = entry.second;
+            orphan(face);
+            candidates.push_back(std::make_pair(entry.first, plane(face)));
+        }
+        m_changedFaces.clear();
+        
+        const T epsilon = Math::Constants<T>::pointStatusEpsilon();
+        for (const V& point : m_orphans) {
+            const Plane<T,3>* bestPlane = nullptr;
+            size_t bestFaceId = 0;
+            T bestDistance = epsilon;
+            
+            for (const auto& candidate : candidates) {
+                const T distance = candidate.second.pointDistance(point);
+                if (distance > bestDistance) {
+                    bestPlane = &candidate.second;
+                    bestFaceId = candidate.first;
+                    bestDistance = distance;
+                }
+            }
+            
+            if (bestPlane != nullptr) {
+                OutsideSet& outsideSet = m_outsideSets[bestFaceId];
+                outsideSet.plane = *bestPlane;
+                outsideSet.points.push_back(point);
+            }
+        }
+        m_orphans.clear();
+    }
+public:
+    void vertexWasCreated(Vertex* vertex) {
+        m_callback.vertexWasCreated(vertex);
+    }
+    
+    void vertexWillBeDeleted(Vertex* vertex) {
+        m_callback.vertexWillBeDeleted(vertex);
+    }
+    
+    void vertexWasAdded(Vertex* vertex) {
+        m_callback.vertexWasAdded(vertex);
+    }
+    
+    void vertexWillBeRemoved(Vertex* vertex) {
+        m_callback.vertexWillBeRemoved(vertex);
+    }
+    
+    Plane<T,3> plane(const Face* face) const {
+        return m_callback.plane(face);
+    }
+    
+    void faceWasCreated(Face* face) {
+        m_callback.faceWasCreated(face);
+        changed(face);
+    }
+    
+    void faceWillBeDeleted(Face* face) {
+        m_callback.faceWillBeDeleted(face);
+        forget(face);
+    }
+    
+    void faceDidChange(Face* face) {
+        m_callback.faceDidChange(face);
+        changed(face);
+    }
+    
+    void faceWasFlipped(Face* face) {
+        m_callback.faceWasFlipped(face);
+        changed(face);
+    }
+    
+    void faceWasSplit(Face* original, Face* clone) {
+        m_callback.faceWasSplit(original, clone);
+        changed(original);
+        changed(clone);
+    }
+    
+    void facesWillBeMerged(Face* remaining, Face* toDelete) {
+        m_callback.facesWillBeMerged(remaining, toDelete);
+        forget(toDelete);
+        changed(remaining);
+    }
+private:
+    size_t faceId(Face* face) {
+        typename FaceIds::iterator it = m_faceIds.find(face);
+        if (it == std::end(m_faceIds))
+            it = m_faceIds.insert(std::make_pair(face, m_nextFaceId++)).first;
+        return it->second;
+    }
+    
+    void changed(Face* face) {
+        m_changedFaces[faceId(face)] = face;
+    }
+    
+    // The face is about to be deleted, so its address may be reused for a new face.
+    void forget(Face* face) {
+        typename FaceIds::iterator it = m_faceIds.find(face);
+        if (it != std::end(m_faceIds)) {
+            orphan(face);
+            m_changedFaces.erase(it->second);
+            m_faceIds.erase(it);
+        }
+    }
+    
+    void orphan(Face* face) {
+        typename FaceIds::const_iterator idIt = m_faceIds.find(face);
+        if (idIt == std::end(m_faceIds))
+            return;
+        
+        typename OutsideSets::iterator it = m_outsideSets.find(idIt->second);
+        if (it != std::end(m_outsideSets)) {
+            const typename V::List& points = it->second.points;
+            m_orphans.insert(std::end(m_orphans), std::begin(points), std::end(points));
+            m_outsideSets.erase(it);
+        }
+    }
+};
+
+/*
+ Computes the convex hull of the given points using quickhull. Duplicate points are removed first, then the hull is
+ initialized with a tetrahedron of extreme points. The remaining points are added furthest point first, and points
+ that end up inside the hull are discarded without ever being tested against the entire hull.
+ 
+ If the points are degenerate (fewer than four distinct points, or all points are colinear or coplanar), they are
+ added one at a time.
+ */
+template <typename T, typename FP, typename VP>
+void Polyhedron<T,FP,VP>::quickHull(typename V::List points, Callback& callback) {
+    assert(empty());
+    removeDuplicatePoints(points);
+    
+    size_t indices[4];
+    if (!findInitialTetrahedron(points, indices)) {
+        for (const V& point : points)
+            addPoint(point, callback);
+        return;
+    }
+    
+    ConflictTracker tracker(callback);
+    for (size_t i = 0; i < 4; ++i)
+        addPoint(points[indices[i]], tracker);
+    assert(polyhedron());
+    
+    std::sort(indices, indices + 4);
+    for (size_t i = 0; i < 4; ++i) {
+        // remove the tetrahedron's points, starting with the last one so that the remaining indices stay valid
+        const size_t index = indices[3 - i];
+        points[index] = points.back();
+        points.pop_back();
+    }
+    
+    tracker.initialize(m_faces, points);
+    while (tracker.hasOutsidePoints()) {
+        addPoint(tracker.takeFurthestPoint(), tracker);
+        tracker.reassignOrphans();
+    }
+}
+
+template <typename T, typename FP, typename VP>
+void Polyhedron<T,FP,VP>::removeDuplicatePoints(typename V::List& points) {
+    const typename V::LexicographicOrder cmp;
+    std::sort(std::begin(points), std::end(points), cmp);
+    
+    typename V::List::iterator last = std::unique(std::begin(points), std::end(points), [&cmp](const V& lhs, const V& rhs) {
+        return !cmp(lhs, rhs) && !cmp(rhs, lhs);
+    });
+    points.erase(last, std::end(points));
+}
+
+template <typename T, typename FP, typename VP>
+bool Polyhedron<T,FP,VP>::findInitialTetrahedron(const typename V::List& points, size_t indices[4]) {
+    if (points.size() < 4)
+        return false;
+    
+    const T epsilon = Math::Constants<T>::pointStatusEpsilon();
+    
+    // the points with minimal and maximal coordinates on each axis
+    size_t extremes[6] = { 0, 0, 0, 0, 0, 0 };
+    for (size_t i = 1; i < points.size(); ++i) {
+        for (size_t j = 0; j < 3; ++j) {
+            if (points[i][j] < points[extremes[2 * j]][j])
+                extremes[2 * j] = i;
+            if (points[i][j] > points[extremes[2 * j + 1]][j])
+                extremes[2 * j + 1] = i;
+        }
+    }
+    
+    // the two extreme points which are furthest apart
+    T bestDistance = static_cast<T>(0.0);
+    for (size_t i = 0; i < 6; ++i) {
+        for (size_t j = i + 1; j < 6; ++j) {
+            const T distance = points[extremes[i]].squaredDistanceTo(points[extremes[j]]);
+            if (distance > bestDistance) {
+                indices[0] = extremes[i];
+                indices[1] = extremes[j];
+                bestDistance = distance;
+            }
+        }
+    }
+    if (bestDistance <= epsilon * epsilon)
+        return false;
+    
+    // the point furthest from the line through the first two points
+    const V& p0 = points[indices[0]];
+    const V direction = (points[indices[1]] - p0).normalized();
+    bestDistance = static_cast<T>(0.0);
+    for (size_t i = 0; i < points.size(); ++i) {
+        const T distance = crossed(points[i] - p0, direction).squaredLength();
+        if (distance > bestDistance) {
+            indices[2] = i;
+            bestDistance = distance;
+        }
+    }
+    if (bestDistance <= epsilon * epsilon)
+        return false;
+    
+    // the point furthest from the plane through the first three points
+    const V normal = crossed(points[indices[1]] - p0, points[indices[2]] - p0).normalized();
+    bestDistance = static_cast<T>(0.0);
+    for (size_t i = 0; i < points.size(); ++i) {
+        const T distance = std::abs((points[i] - p0).dot(normal));
+        if (distance > bestDistance) {
+            indices[3] = i;
+            bestDistance = distance;
+        }
+    }
+    return bestDistance > epsilon;
 }
 
 template <typename T, typename FP, typename VP>
@@ -19,8 +19,10 @@
 
 #include "EntityLinkRenderer.h"
 
+#include "CollectionUtils.h"
 #include "Macros.h"
 #include "Model/AttributableNode.h"
+#include "Model/Brush.h"
 #include "Model/CollectMatchingNodesVisitor.h"
 #include "Model/EditorContext.h"
 #include "Model/Entity.h"
@@ -41,7 +43,8 @@ namespace TrenchBroom {
         m_document(document),
         m_defaultColor(0.5f, 1.0f, 0.5f, 1.0f),
         m_selectedColor(1.0f, 0.0f, 0.0f, 1.0f),
-        m_valid(false) {}
+        m_valid(false),
+        m_segmentsValid(false) {}
         
         void EntityLinkRenderer::setDefaultColor(const Color& color) {
             if (color == m_defaultColor)
@@ -63,6 +66,51 @@ namespace TrenchBroom {
 
         void EntityLinkRenderer::invalidate() {
             m_valid = false;
+            m_segmentsValid = false;
+        }
+        
+        class EntityLinkRenderer::CollectChangedEntitiesVisitor : public Model::NodeVisitor {
+        private:
+            Model::AttributableNodeSet& m_entities;
+        public:
+            CollectChangedEntitiesVisitor(Model::AttributableNodeSet& entities) :
+            m_entities(entities) {}
+        private:
+            void doVisit(Model::World* world)   { stopRecursion(); }
+            void doVisit(Model::Layer* layer)   { stopRecursion(); }
+            void doVisit(Model::Group* group)   {}
+            void doVisit(Model::Entity* entity) {
+                m_entities.insert(entity);
+                stopRecursion();
+            }
+            void doVisit(Model::Brush* brush)   {
+                // a brush entity's anchors depend on its brushes
+                Model::Node* parent = brush->parent();
+                if (parent != NULL)
+                    parent->accept(*this);
+            }
+        };
+        
+        void EntityLinkRenderer::invalidate(const Model::NodeList& nodes) {
+            m_valid = false;
+            if (!m_segmentsValid)
+                return;
+            
+            Model::AttributableNodeSet changed;
+            CollectChangedEntitiesVisitor visitor(changed);
+            Model::Node::acceptAndRecurse(std::begin(nodes), std::end(nodes), visitor);
+            
+            for (Model::AttributableNode* entity : changed) {
+                // the entity's own links, the cached links ending at it, and the links that end at it now
+                m_invalidSources.insert(entity);
+                
+                SourceMap::const_iterator it = m_sources.find(entity);
+                if (it != std::end(m_sources))
+                    m_invalidSources.insert(std::begin(it->second), std::end(it->second));
+                
+                m_invalidSources.insert(std::begin(entity->linkSources()), std::end(entity->linkSources()));
+                m_invalidSources.insert(std::begin(entity->killSources()), std::end(entity->killSources()));
+            }
         }
 
         void EntityLinkRenderer::doPrepareVertices(Vbo& vertexVbo) {
@@ -226,9 +274,14 @@ namespace TrenchBroom {
             }
         };
         
-        void EntityLinkRenderer::getLinks(Vertex::List& links) const {
+        void EntityLinkRenderer::getLinks(Vertex::List& links) {
             View::MapDocumentSPtr document = lock(m_document);
             const Model::EditorContext& editorContext = document->editorContext();
+            
+            // the segment cache only tracks changes while all links are shown
+            if (editorContext.entityLinkMode() != Model::EditorContext::EntityLinkMode_All)
+                m_segmentsValid = false;
+            
             switch (editorContext.entityLinkMode()) {
                 case Model::EditorContext::EntityLinkMode_All:
                     getAllLinks(links);
@@ -245,15 +298,75 @@ namespace TrenchBroom {
             }
         }
         
-        void EntityLinkRenderer::getAllLinks(Vertex::List& links) const {
+        void EntityLinkRenderer::getAllLinks(Vertex::List& links) {
+            validateSegments();
+            
+            size_t count = 0;
+            for (const SegmentMap::value_type& entry : m_segments)
+                count += entry.second.vertices.size();
+            
+            links.reserve(count);
+            for (const SegmentMap::value_type& entry : m_segments)
+                VectorUtils::append(links, entry.second.vertices);
+        }
+        
+        void EntityLinkRenderer::validateSegments() {
+            if (m_segmentsValid) {
+                for (Model::AttributableNode* source : m_invalidSources)
+                    updateSegment(source);
+            } else {
+                m_segments.clear();
+                m_sources.clear();
+                
+                View::MapDocumentSPtr document = lock(m_document);
+                Model::World* world = document->world();
+                if (world != NULL) {
+                    CollectEntitiesVisitor collectEntities;
+                    world->acceptAndRecurse(collectEntities);
+                    
+                    for (Model::Node* node : collectEntities.nodes())
+                        updateSegment(static_cast<Model::Entity*>(node));
+                }
+                m_segmentsValid = true;
+            }
+            m_invalidSources.clear();
+        }
+        
+        void EntityLinkRenderer::updateSegment(Model::AttributableNode* source) {
+            removeSegment(source);
+            
             View::MapDocumentSPtr document = lock(m_document);
             const Model::EditorContext& editorContext = document->editorContext();
             
-            CollectAllLinksVisitor collectLinks(editorContext, m_defaultColor, m_selectedColor, links);
+            Segment segment;
+            CollectAllLinksVisitor collectLinks(editorContext, m_defaultColor, m_selectedColor, segment.vertices);
+            source->accept(collectLinks);
+            
+            // remember all targets, including invisible ones, so that changes to them invalidate this segment
+            VectorUtils::append(segment.targets, source->linkTargets());
+            VectorUtils::append(segment.targets, source->killTargets());
+            if (segment.targets.empty())
+                return;
             
-            Model::World* world = document->world();
-            if (world != NULL)
-                world->acceptAndRecurse(collectLinks);
+            for (Model::AttributableNode* target : segment.targets)
+                m_sources[target].insert(source);
+            m_segments[source] = segment;
+        }
+        
+        void EntityLinkRenderer::removeSegment(Model::AttributableNode* source) {
+            SegmentMap::iterator it = m_segments.find(source);
+            if (it == std::end(m_segments))
+                return;
+            
+            for (Model::AttributableNode* target : it->second.targets) {
+                SourceMap::iterator sIt = m_sources.find(target);
+                if (sIt != std::end(m_sources)) {
+                    sIt->second.erase(source);
+                    if (sIt->second.empty())
+                        m_sources.erase(sIt);
+                }
+            }
+            m_segments.erase(it);
         }
         
         void EntityLinkRenderer::getTransitiveSelectedLinks(Vertex::List& links) const {
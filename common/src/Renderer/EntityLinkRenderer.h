@@ -27,6 +27,8 @@
 #include "Renderer/VertexArray.h"
 #include "View/ViewTypes.h"
 
+#include <map>
+
 namespace TrenchBroom {
     namespace Model {
         class EditorContext;
@@ -40,6 +42,17 @@ namespace TrenchBroom {
         private:
             typedef VertexSpecs::P3C4::Vertex Vertex;
             
+            /**
+             * The links starting at a single source node, cached so that only the links of changed nodes have to be
+             * recomputed when all links are shown.
+             */
+            struct Segment {
+                Vertex::List vertices;
+                Model::AttributableNodeList targets;
+            };
+            typedef std::map<Model::AttributableNode*, Segment> SegmentMap;
+            typedef std::map<Model::AttributableNode*, Model::AttributableNodeSet> SourceMap;
+            
             View::MapDocumentWPtr m_document;
             
             Color m_defaultColor;
@@ -47,6 +60,11 @@ namespace TrenchBroom {
             
             VertexArray m_entityLinks;
             bool m_valid;
+            
+            SegmentMap m_segments;
+            SourceMap m_sources; // maps each cached link target to the sources that link to it
+            Model::AttributableNodeSet m_invalidSources;
+            bool m_segmentsValid;
         public:
             EntityLinkRenderer(View::MapDocumentWPtr document);
             
@@ -55,6 +73,7 @@ namespace TrenchBroom {
             
             void render(RenderContext& renderContext, RenderBatch& renderBatch);
             void invalidate();
+            void invalidate(const Model::NodeList& nodes);
         private:
             void doPrepareVertices(Vbo& vertexVbo);
             void doRender(RenderContext& renderContext);
@@ -63,14 +82,18 @@ namespace TrenchBroom {
             
             class MatchEntities;
             class CollectEntitiesVisitor;
+            class CollectChangedEntitiesVisitor;
             
             class CollectLinksVisitor;
             class CollectAllLinksVisitor;
             class CollectTransitiveSelectedLinksVisitor;
             class CollectDirectSelectedLinksVisitor;
 
-            void getLinks(Vertex::List& links) const;
-            void getAllLinks(Vertex::List& links) const;
+            void getLinks(Vertex::List& links);
+            void getAllLinks(Vertex::List& links);
+            void validateSegments();
+            void updateSegment(Model::AttributableNode* source);
+            void removeSegment(Model::AttributableNode* source);
             void getTransitiveSelectedLinks(Vertex::List& links) const;
             void getDirectSelectedLinks(Vertex::List& links) const;
             void collectSelectedLinks(CollectLinksVisitor& collectLinks) const;
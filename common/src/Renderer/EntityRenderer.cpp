@@ -39,10 +39,20 @@
 #include "Renderer/ShaderManager.h"
 #include "Renderer/Shaders.h"
 #include "Renderer/TextAnchor.h"
+#include "Renderer/TextRenderer.h"
 #include "Renderer/VertexSpec.h"
 
+#include <algorithm>
+
 namespace TrenchBroom {
     namespace Renderer {
+        static Vec3f classnamePosition(const Model::Entity* entity) {
+            Vec3f position = entity->bounds().center();
+            position[2] = float(entity->bounds().max.z());
+            position[2] += 2.0f;
+            return position;
+        }
+        
         class EntityRenderer::EntityClassnameAnchor : public TextAnchor3D {
         private:
             const Model::Entity* m_entity;
@@ -51,10 +61,7 @@ namespace TrenchBroom {
             m_entity(entity) {}
         private:
             Vec3f basePosition() const {
-                Vec3f position = m_entity->bounds().center();
-                position[2] = float(m_entity->bounds().max.z());
-                position[2] += 2.0f;
-                return position;
+                return classnamePosition(m_entity);
             }
             
             TextAlignment::Type alignment() const {
@@ -192,20 +199,57 @@ namespace TrenchBroom {
         
         void EntityRenderer::renderClassnames(RenderContext& renderContext, RenderBatch& renderBatch) {
             if (m_showOverlays && renderContext.showEntityClassnames()) {
+                const ClassnameList classnames = collectVisibleClassnames(renderContext);
+                if (classnames.empty())
+                    return;
+                
                 Renderer::RenderService renderService(renderContext, renderBatch);
                 renderService.setForegroundColor(m_overlayTextColor);
                 renderService.setBackgroundColor(m_overlayBackgroundColor);
+                renderService.setDeclutterStrings(true);
+                if (m_showOccludedOverlays)
+                    renderService.setShowOccludedObjects();
+                else
+                    renderService.setHideOccludedObjects();
                 
-                for (const Model::Entity* entity : m_entities) {
-                    if (m_showHiddenEntities || m_editorContext.visible(entity)) {
-                        if (m_showOccludedOverlays)
-                            renderService.setShowOccludedObjects();
-                        else
-                            renderService.setHideOccludedObjects();
-                        renderService.renderString(entityString(entity), EntityClassnameAnchor(entity));
-                    }
-                }
+                // the classnames are sorted by distance, so the nearest ones win when decluttering
+                for (const ClassnameEntry& entry : classnames)
+                    renderService.renderString(entityString(entry.second), EntityClassnameAnchor(entry.second));
+            }
+        }
+        
+        EntityRenderer::ClassnameList EntityRenderer::collectVisibleClassnames(const RenderContext& renderContext) const {
+            // Roughly the width of a long classname in pixels. Classnames whose anchor is further than that from the
+            // view frustum cannot be visible.
+            static const float MaxHalfLabelSize = 160.0f;
+            
+            const Camera& camera = renderContext.camera();
+            const float maxDistance = TextRenderer::defaultMaxViewDistance();
+            
+            Plane3f planes[4];
+            camera.frustumPlanes(planes[0], planes[1], planes[2], planes[3]);
+            
+            ClassnameList result;
+            for (const Model::Entity* entity : m_entities) {
+                if (!m_showHiddenEntities && !m_editorContext.visible(entity))
+                    continue;
+                
+                const Vec3f position = classnamePosition(entity);
+                const float distance = camera.perpendicularDistanceTo(position);
+                if (renderContext.render3D() && (distance <= 0.0f || distance > maxDistance))
+                    continue;
+                
+                const float margin = MaxHalfLabelSize * camera.perspectiveScalingFactor(position);
+                bool inside = true;
+                for (size_t i = 0; i < 4 && inside; ++i)
+                    inside = planes[i].pointDistance(position) <= margin;
+                
+                if (inside)
+                    result.push_back(std::make_pair(distance, entity));
             }
+            
+            std::sort(std::begin(result), std::end(result), CompareClassnamesByDistance());
+            return result;
         }
         
         void EntityRenderer::renderAngles(RenderContext& renderContext, RenderBatch& renderBatch) {
@@ -31,6 +31,7 @@
 #include "Renderer/Vbo.h"
 
 #include <map>
+#include <vector>
 
 namespace TrenchBroom {
     namespace Assets {
@@ -105,6 +106,17 @@ namespace TrenchBroom {
             void renderSolidBounds(RenderBatch& renderBatch);
             void renderModels(RenderContext& renderContext, RenderBatch& renderBatch);
             void renderClassnames(RenderContext& renderContext, RenderBatch& renderBatch);
+            
+            typedef std::pair<float, const Model::Entity*> ClassnameEntry;
+            typedef std::vector<ClassnameEntry> ClassnameList;
+            
+            struct CompareClassnamesByDistance {
+                bool operator()(const ClassnameEntry& lhs, const ClassnameEntry& rhs) const {
+                    return lhs.first < rhs.first;
+                }
+            };
+            
+            ClassnameList collectVisibleClassnames(const RenderContext& renderContext) const;
             void renderAngles(RenderContext& renderContext, RenderBatch& renderBatch);
             Vec3f::List arrowHead(float length, float width) const;
             
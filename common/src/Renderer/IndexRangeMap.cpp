@@ -68,54 +68,131 @@ namespace TrenchBroom {
             }
         }
         
+        IndexRangeMap::Size::Size() :
+        m_polygonIndexCount(0) {}
+        
         void IndexRangeMap::Size::inc(const PrimType primType, const size_t count) {
             PrimTypeToSize::iterator primIt = MapUtils::findOrInsert(m_sizes, primType, 0);
             primIt->second += count;
         }
         
-        void IndexRangeMap::Size::initialize(PrimTypeToIndexData& data) const {
+        void IndexRangeMap::Size::incPolygon(const size_t vertexCount) {
+            assert(vertexCount >= 3);
+            m_polygonIndexCount += 3 * (vertexCount - 2);
+        }
+
+        bool IndexRangeMap::Size::empty() const {
+            return m_sizes.empty() && m_polygonIndexCount == 0;
+        }
+        
+        void IndexRangeMap::Size::initialize(Data& data) const {
             for (const auto& entry : m_sizes) {
                 const PrimType primType = entry.first;
                 const size_t size = entry.second;
-                data[primType].reserve(size);
+                data.ranges[primType].reserve(size);
             }
+            data.polygonIndices.reserve(m_polygonIndexCount);
         }
         
         IndexRangeMap::IndexRangeMap() :
-        m_data(new PrimTypeToIndexData()),
-        m_dynamicGrowth(true) {}
+        m_dynamicGrowth(true),
+        m_single(false),
+        m_singlePrimType(GL_POINTS),
+        m_singleIndex(0),
+        m_singleCount(0) {}
 
         IndexRangeMap::IndexRangeMap(const Size& size) :
-        m_data(new PrimTypeToIndexData()),
-        m_dynamicGrowth(false) {
-            size.initialize(*m_data);
+        m_dynamicGrowth(false),
+        m_single(false),
+        m_singlePrimType(GL_POINTS),
+        m_singleIndex(0),
+        m_singleCount(0) {
+            if (!size.empty())
+                size.initialize(data());
         }
 
         IndexRangeMap::IndexRangeMap(const PrimType primType, const size_t index, const size_t count) :
-        m_data(new PrimTypeToIndexData()),
-        m_dynamicGrowth(false) {
-            m_data->insert(std::make_pair(primType, IndicesAndCounts(index, count)));
-        }
+        m_dynamicGrowth(false),
+        m_single(true),
+        m_singlePrimType(primType),
+        m_singleIndex(index),
+        m_singleCount(count) {}
         
         void IndexRangeMap::add(const PrimType primType, const size_t index, const size_t count) {
-            PrimTypeToIndexData::iterator it = m_data->end();
+            if (m_single) {
+                if (primType == m_singlePrimType && index == m_singleIndex + m_singleCount) {
+                    switch (primType) {
+                        case GL_POINTS:
+                        case GL_LINES:
+                        case GL_TRIANGLES:
+                        case GL_QUADS:
+                            m_singleCount += count;
+                            return;
+                        default:
+                            break;
+                    }
+                }
+                spillSingle();
+            }
+            
+            PrimTypeToIndexData& ranges = data().ranges;
+            PrimTypeToIndexData::iterator it = ranges.end();
             if (m_dynamicGrowth)
-                it = MapUtils::findOrInsert(*m_data, primType);
+                it = MapUtils::findOrInsert(ranges, primType);
             else
-                it = m_data->find(primType);
-            assert(it != m_data->end());
+                it = ranges.find(primType);
+            assert(it != ranges.end());
             
             IndicesAndCounts& indicesAndCounts = it->second;
             indicesAndCounts.add(primType, index, count, m_dynamicGrowth);
         }
 
+        void IndexRangeMap::addPolygon(const size_t index, const size_t count) {
+            assert(count >= 3);
+            
+            GLIndices& indices = data().polygonIndices;
+            assert(m_dynamicGrowth || indices.capacity() >= indices.size() + 3 * (count - 2));
+            
+            const GLint first = static_cast<GLint>(index);
+            for (size_t i = 1; i < count - 1; ++i) {
+                indices.push_back(first);
+                indices.push_back(static_cast<GLint>(index + i));
+                indices.push_back(static_cast<GLint>(index + i + 1));
+            }
+        }
+
         void IndexRangeMap::render(VertexArray& vertexArray) const {
-            for (const auto& entry : *m_data) {
+            if (m_single) {
+                vertexArray.render(m_singlePrimType, static_cast<GLint>(m_singleIndex), static_cast<GLsizei>(m_singleCount));
+                return;
+            }
+            
+            if (m_data.get() == NULL)
+                return;
+            
+            for (const auto& entry : m_data->ranges) {
                 const PrimType primType = entry.first;
                 const IndicesAndCounts& indicesAndCounts = entry.second;
                 const GLsizei primCount = static_cast<GLsizei>(indicesAndCounts.size());
-                vertexArray.render(primType, indicesAndCounts.indices, indicesAndCounts.counts, primCount);
+                if (primCount > 0)
+                    vertexArray.render(primType, indicesAndCounts.indices, indicesAndCounts.counts, primCount);
             }
+            
+            const GLIndices& polygonIndices = m_data->polygonIndices;
+            if (!polygonIndices.empty())
+                vertexArray.render(GL_TRIANGLES, polygonIndices, static_cast<GLsizei>(polygonIndices.size()));
+        }
+
+        IndexRangeMap::Data& IndexRangeMap::data() {
+            if (m_data.get() == NULL)
+                m_data = DataPtr(new Data());
+            return *m_data;
+        }
+        
+        void IndexRangeMap::spillSingle() {
+            assert(m_single);
+            data().ranges.insert(std::make_pair(m_singlePrimType, IndicesAndCounts(m_singleIndex, m_singleCount)));
+            m_single = false;
         }
     }
 }
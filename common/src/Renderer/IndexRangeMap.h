@@ -43,7 +43,13 @@ namespace TrenchBroom {
             };
             
             typedef std::map<PrimType, IndicesAndCounts> PrimTypeToIndexData;
-            typedef std::shared_ptr<PrimTypeToIndexData> PrimTypeToIndexDataPtr;
+            
+            struct Data {
+                PrimTypeToIndexData ranges;
+                GLIndices polygonIndices;
+            };
+            
+            typedef std::shared_ptr<Data> DataPtr;
         public:
             class Size {
             private:
@@ -51,14 +57,27 @@ namespace TrenchBroom {
                 
                 typedef std::map<PrimType, size_t> PrimTypeToSize;
                 PrimTypeToSize m_sizes;
+                size_t m_polygonIndexCount;
             public:
+                Size();
+                
                 void inc(const PrimType primType, size_t count = 1);
+                void incPolygon(size_t vertexCount);
             private:
-                void initialize(PrimTypeToIndexData& data) const;
+                bool empty() const;
+                void initialize(Data& data) const;
             };
         private:
-            PrimTypeToIndexDataPtr m_data;
+            /*
+             * The index data is only allocated once it is needed. A map that consists of a single range, such as
+             * the ones created by the range constructor, keeps that range inline instead.
+             */
+            DataPtr m_data;
             bool m_dynamicGrowth;
+            bool m_single;
+            PrimType m_singlePrimType;
+            size_t m_singleIndex;
+            size_t m_singleCount;
         public:
             IndexRangeMap();
             IndexRangeMap(const Size& size);
@@ -66,7 +85,17 @@ namespace TrenchBroom {
             
             void add(PrimType primType, size_t index, size_t count);
             
+            /**
+             * Adds a convex polygon whose vertices are stored at the given range. The polygon is triangulated into
+             * an indexed triangle list which is shared by all polygons in this map, so that all of them are
+             * rendered with a single draw call.
+             */
+            void addPolygon(size_t index, size_t count);
+            
             void render(VertexArray& vertexArray) const;
+        private:
+            Data& data();
+            void spillSingle();
         };
     }
 }
@@ -110,7 +110,8 @@ namespace TrenchBroom {
             }
             
             void addPolygon(const VertexList& vertices) {
-                add(GL_POLYGON, m_vertexListBuilder.addPolygon(vertices));
+                const IndexData data = m_vertexListBuilder.addPolygon(vertices);
+                m_indexRange.addPolygon(data.index, data.count);
             }
         private:
             void add(const PrimType primType, const IndexData& data) {
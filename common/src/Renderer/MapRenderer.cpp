@@ -442,7 +442,6 @@ namespace TrenchBroom {
                                              collect.lockedNodes().entities(),
                                              collect.lockedNodes().brushes());
             }
-            invalidateEntityLinkRenderer();
         }
         
         void MapRenderer::invalidateRenderers(Renderer renderers) {
@@ -458,6 +457,10 @@ namespace TrenchBroom {
             m_entityLinkRenderer->invalidate();
         }
 
+        void MapRenderer::invalidateEntityLinkRenderer(const Model::NodeList& nodes) {
+            m_entityLinkRenderer->invalidate(nodes);
+        }
+
         void MapRenderer::reloadEntityModels() {
             m_defaultRenderer->reloadModels();
             m_selectionRenderer->reloadModels();
@@ -522,35 +525,42 @@ namespace TrenchBroom {
         void MapRenderer::documentWasNewedOrLoaded(View::MapDocument* document) {
             clear();
             updateRenderers(Renderer_All);
+            invalidateEntityLinkRenderer();
         }
         
         void MapRenderer::nodesWereAdded(const Model::NodeList& nodes) {
             updateRenderers(Renderer_Default);
+            invalidateEntityLinkRenderer();
         }
         
         void MapRenderer::nodesWereRemoved(const Model::NodeList& nodes) {
             updateRenderers(Renderer_Default);
+            invalidateEntityLinkRenderer();
         }
         
         void MapRenderer::nodesDidChange(const Model::NodeList& nodes) {
             invalidateRenderers(Renderer_Selection);
-            invalidateEntityLinkRenderer();
+            invalidateEntityLinkRenderer(nodes);
         }
         
         void MapRenderer::nodeVisibilityDidChange(const Model::NodeList& nodes) {
             updateRenderers(Renderer_All);
+            invalidateEntityLinkRenderer();
         }
         
         void MapRenderer::nodeLockingDidChange(const Model::NodeList& nodes) {
             updateRenderers(Renderer_Default_Locked);
+            invalidateEntityLinkRenderer();
         }
         
         void MapRenderer::groupWasOpened(Model::Group* group) {
             updateRenderers(Renderer_Default_Selection);
+            invalidateEntityLinkRenderer();
         }
         
         void MapRenderer::groupWasClosed(Model::Group* group) {
             updateRenderers(Renderer_Default_Selection);
+            invalidateEntityLinkRenderer();
         }
 
         void MapRenderer::brushFacesDidChange(const Model::BrushFaceList& faces) {
@@ -559,6 +569,10 @@ namespace TrenchBroom {
         
         void MapRenderer::selectionDidChange(const View::Selection& selection) {
             updateRenderers(Renderer_All); // need to update locked objects also because a selected object may have been reparented into a locked layer before deselection
+            
+            // only the links of the entities whose selection state changed need to be recolored
+            invalidateEntityLinkRenderer(VectorUtils::concatenate(selection.partiallySelectedNodes(), selection.partiallyDeselectedNodes()));
+            invalidateEntityLinkRenderer(VectorUtils::concatenate(selection.selectedNodes(), selection.deselectedNodes()));
         }
         
         Model::BrushSet MapRenderer::collectBrushes(const Model::BrushFaceList& faces) {
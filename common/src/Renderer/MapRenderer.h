@@ -102,6 +102,7 @@ namespace TrenchBroom {
             void updateRenderers(Renderer renderers);
             void invalidateRenderers(Renderer renderers);
             void invalidateEntityLinkRenderer();
+            void invalidateEntityLinkRenderer(const Model::NodeList& nodes);
             void reloadEntityModels();
         private: // notification
             void bindObservers();
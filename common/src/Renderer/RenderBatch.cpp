@@ -50,13 +50,46 @@ namespace TrenchBroom {
             }
         };
         
-        RenderBatch::RenderBatch(Vbo& vertexVbo, Vbo& indexVbo) :
+        class RenderBatch::StreamedRenderableWrapper : public Renderable {
+        private:
+            Vbo& m_vertexVbo;
+            Vbo& m_streamVbo;
+            Renderable* m_wrappee;
+        public:
+            StreamedRenderableWrapper(Vbo& vertexVbo, Vbo& streamVbo, Renderable* wrappee) :
+            m_vertexVbo(vertexVbo),
+            m_streamVbo(streamVbo),
+            m_wrappee(wrappee) {
+                ensure(m_wrappee != NULL, "wrappee is null");
+            }
+        private:
+            void doRender(RenderContext& renderContext) {
+                // The vertex vbo is bound while the batch is rendered, but the vertices of this renderable live in
+                // the streaming vbo, so we have to swap the bindings.
+                const bool vertexVboWasActive = m_vertexVbo.active();
+                if (vertexVboWasActive)
+                    m_vertexVbo.deactivate();
+                
+                {
+                    ActivateVbo activate(m_streamVbo);
+                    m_wrappee->render(renderContext);
+                }
+                
+                if (vertexVboWasActive)
+                    m_vertexVbo.activate();
+            }
+        };
+        
+        RenderBatch::RenderBatch(Vbo& vertexVbo, Vbo& indexVbo, Vbo& streamVbo) :
         m_vertexVbo(vertexVbo),
-        m_indexVbo(indexVbo) {}
+        m_indexVbo(indexVbo),
+        m_streamVbo(streamVbo) {}
         
         RenderBatch::~RenderBatch() {
             ListUtils::clearAndDelete(m_oneshots);
+            ListUtils::clearAndDelete(m_streamWrappers);
             ListUtils::clearAndDelete(m_indexedRenderables);
+            ListUtils::clearAndDelete(m_streamedIndexedRenderables);
         }
         
         void RenderBatch::add(Renderable* renderable) {
@@ -93,6 +126,25 @@ namespace TrenchBroom {
             m_oneshots.push_back(renderable);
         }
         
+        void RenderBatch::addStreamed(DirectRenderable* renderable) {
+            StreamedRenderableWrapper* wrapper = new StreamedRenderableWrapper(m_vertexVbo, m_streamVbo, renderable);
+            
+            doAdd(wrapper);
+            m_streamedDirectRenderables.push_back(renderable);
+            m_streamWrappers.push_back(wrapper);
+            m_oneshots.push_back(renderable);
+        }
+        
+        void RenderBatch::addStreamed(IndexedRenderable* renderable) {
+            IndexedRenderableWrapper* indexedWrapper = new IndexedRenderableWrapper(m_indexVbo, renderable);
+            StreamedRenderableWrapper* wrapper = new StreamedRenderableWrapper(m_vertexVbo, m_streamVbo, indexedWrapper);
+
+            doAdd(wrapper);
+            m_streamedIndexedRenderables.push_back(indexedWrapper);
+            m_streamWrappers.push_back(wrapper);
+            m_oneshots.push_back(renderable);
+        }
+        
         void RenderBatch::render(RenderContext& renderContext) {
             ActivateVbo activate(m_vertexVbo);
 
@@ -107,6 +159,7 @@ namespace TrenchBroom {
 
         void RenderBatch::prepareRenderables() {
             prepareVertices();
+            prepareStreamedVertices();
             prepareIndices();
         }
         
@@ -120,11 +173,34 @@ namespace TrenchBroom {
                 renderable->prepareVertices(m_vertexVbo);
         }
         
+        void RenderBatch::prepareStreamedVertices() {
+            if (m_streamedDirectRenderables.empty() && m_streamedIndexedRenderables.empty())
+                return;
+            
+            // the vertex vbo is bound for the entire batch, so we temporarily unbind it
+            m_vertexVbo.deactivate();
+            {
+                ActivateVbo activate(m_streamVbo);
+                
+                for (DirectRenderable* renderable : m_streamedDirectRenderables)
+                    renderable->prepareVertices(m_streamVbo);
+                
+                for (IndexedRenderable* renderable : m_streamedIndexedRenderables)
+                    renderable->prepareVertices(m_streamVbo);
+                
+                m_streamVbo.flush();
+            }
+            m_vertexVbo.activate();
+        }
+        
         void RenderBatch::prepareIndices() {
             ActivateVbo activate(m_indexVbo);
             
             for (IndexedRenderable* renderable : m_indexedRenderables)
                 renderable->prepareIndices(m_indexVbo);
+            
+            for (IndexedRenderable* renderable : m_streamedIndexedRenderables)
+                renderable->prepareIndices(m_indexVbo);
         }
 
         void RenderBatch::renderRenderables(RenderContext& renderContext) {
@@ -34,12 +34,19 @@ namespace TrenchBroom {
         class RenderContext;
         class Vbo;
         
+        /**
+         * Collects renderables and renders them in the order in which they were added. The vertices of streamed
+         * renderables are written to the given streaming vbo rather than to the long lived vertex vbo, so that data
+         * which is rebuilt for every frame does not fragment the latter.
+         */
         class RenderBatch {
         private:
             Vbo& m_vertexVbo;
             Vbo& m_indexVbo;
+            Vbo& m_streamVbo;
 
             class IndexedRenderableWrapper;
+            class StreamedRenderableWrapper;
             
             typedef std::list<Renderable*> RenderableList;
             typedef std::list<DirectRenderable*> DirectRenderableList;
@@ -48,10 +55,14 @@ namespace TrenchBroom {
             DirectRenderableList m_directRenderables;
             IndexedRenderableList m_indexedRenderables;
             
+            DirectRenderableList m_streamedDirectRenderables;
+            IndexedRenderableList m_streamedIndexedRenderables;
+            RenderableList m_streamWrappers;
+            
             RenderableList m_batch;
             RenderableList m_oneshots;
         public:
-            RenderBatch(Vbo& vertexVbo, Vbo& indexVbo);
+            RenderBatch(Vbo& vertexVbo, Vbo& indexVbo, Vbo& streamVbo);
             ~RenderBatch();
             
             void add(Renderable* renderable);
@@ -62,12 +73,21 @@ namespace TrenchBroom {
             void addOneShot(DirectRenderable* renderable);
             void addOneShot(IndexedRenderable* renderable);
             
+            /**
+             * Adds a one shot renderable whose vertices are written to the streaming vbo. Only use this for
+             * renderables that own their vertex data and rebuild it for every frame; renderables that draw shared,
+             * persistent vertex arrays must be added with addOneShot.
+             */
+            void addStreamed(DirectRenderable* renderable);
+            void addStreamed(IndexedRenderable* renderable);
+            
             void render(RenderContext& renderContext);
         private:
             void doAdd(Renderable* renderable);
             
             void prepareRenderables();
             void prepareVertices();
+            void prepareStreamedVertices();
             void prepareIndices();
             
             void renderRenderables(RenderContext& renderContext);
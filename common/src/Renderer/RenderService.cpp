@@ -94,6 +94,10 @@ namespace TrenchBroom {
             m_occlusionPolicy = PrimitiveRenderer::OP_Hide;
         }
 
+        void RenderService::setDeclutterStrings(const bool declutter) {
+            m_textRenderer->setDeclutter(declutter);
+        }
+
         void RenderService::renderString(const AttrString& string, const Vec3f& position) {
             renderString(string, SimpleTextAnchor(position, TextAlignment::Bottom, Vec2f(0.0f, 16.0f)));
         }
@@ -215,9 +219,9 @@ namespace TrenchBroom {
         }
         
         void RenderService::flush() {
-            m_renderBatch.addOneShot(m_primitiveRenderer);
-            m_renderBatch.addOneShot(m_pointHandleRenderer);
-            m_renderBatch.addOneShot(m_textRenderer);
+            m_renderBatch.addStreamed(m_primitiveRenderer);
+            m_renderBatch.addStreamed(m_pointHandleRenderer);
+            m_renderBatch.addStreamed(m_textRenderer);
         }
     }
 }
@@ -65,6 +65,11 @@ namespace TrenchBroom {
             void setShowOccludedObjectsTransparent();
             void setHideOccludedObjects();
             
+            /**
+             * Drops strings that would overlap a previously rendered string on screen.
+             */
+            void setDeclutterStrings(bool declutter);
+            
             void renderString(const AttrString& string, const Vec3f& position);
             void renderString(const AttrString& string, const TextAnchor& position);
             void renderHeadsUp(const AttrString& string);
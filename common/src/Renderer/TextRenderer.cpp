@@ -30,6 +30,8 @@
 #include "Renderer/TextAnchor.h"
 #include "Renderer/TextureFont.h"
 
+#include <cmath>
+
 namespace TrenchBroom {
     namespace Renderer {
         const float TextRenderer::DefaultMaxViewDistance = 768.0f;
@@ -37,6 +39,18 @@ namespace TrenchBroom {
         const Vec2f TextRenderer::DefaultInset = Vec2f(4.0f, 4.0f);
         const size_t TextRenderer::RectCornerSegments = 3;
         const float TextRenderer::RectCornerRadius = 3.0f;
+        const float TextRenderer::DeclutterCellSize = 64.0f;
+        
+        TextRenderer::LabelRect::LabelRect(const float i_x, const float i_y, const float i_w, const float i_h) :
+        x(i_x),
+        y(i_y),
+        w(i_w),
+        h(i_h) {}
+        
+        bool TextRenderer::LabelRect::intersects(const LabelRect& other) const {
+            return (x < other.x + other.w && other.x < x + w &&
+                    y < other.y + other.h && other.y < y + h);
+        }
         
         TextRenderer::Entry::Entry(Vec2f::List& i_vertices, const Vec2f& i_size, const Vec3f& i_offset, const Color& i_textColor, const Color& i_backgroundColor) :
         size(i_size),
@@ -55,7 +69,16 @@ namespace TrenchBroom {
         m_fontDescriptor(fontDescriptor),
         m_maxViewDistance(maxViewDistance),
         m_minZoomFactor(minZoomFactor),
-        m_inset(inset) {}
+        m_inset(inset),
+        m_declutter(false) {}
+
+        float TextRenderer::defaultMaxViewDistance() {
+            return DefaultMaxViewDistance;
+        }
+
+        void TextRenderer::setDeclutter(const bool declutter) {
+            m_declutter = declutter;
+        }
 
         void TextRenderer::renderString(RenderContext& renderContext, const Color& textColor, const Color& backgroundColor, const AttrString& string, const TextAnchor& position) {
             renderString(renderContext, textColor, backgroundColor, string, position, false);
@@ -78,11 +101,16 @@ namespace TrenchBroom {
             FontManager& fontManager = renderContext.fontManager();
             TextureFont& font = fontManager.font(m_fontDescriptor);
 
-            Vec2f::List vertices = font.quads(string, true);
-            const float alphaFactor = computeAlphaFactor(renderContext, distance, onTop);
             const Vec2f size = font.measure(string);
             const Vec3f offset = position.offset(camera, size);
             
+            if (m_declutter && !placeLabel(LabelRect(offset.x() - m_inset.x(), offset.y() - m_inset.y(),
+                                                     size.x() + 2.0f * m_inset.x(), size.y() + 2.0f * m_inset.y())))
+                return;
+            
+            Vec2f::List vertices = font.quads(string, true);
+            const float alphaFactor = computeAlphaFactor(renderContext, distance, onTop);
+            
             if (onTop)
                 addEntry(m_entriesOnTop, Entry(vertices, size, offset,
                                                Color(textColor, alphaFactor * textColor.a()),
@@ -135,6 +163,31 @@ namespace TrenchBroom {
             collection.rectVertexCount += roundedRect2DVertexCount(RectCornerSegments);
         }
         
+        bool TextRenderer::placeLabel(const LabelRect& rect) {
+            const int minX = static_cast<int>(std::floor(rect.x / DeclutterCellSize));
+            const int maxX = static_cast<int>(std::floor((rect.x + rect.w) / DeclutterCellSize));
+            const int minY = static_cast<int>(std::floor(rect.y / DeclutterCellSize));
+            const int maxY = static_cast<int>(std::floor((rect.y + rect.h) / DeclutterCellSize));
+            
+            for (int x = minX; x <= maxX; ++x) {
+                for (int y = minY; y <= maxY; ++y) {
+                    const LabelGrid::const_iterator it = m_labelGrid.find(std::make_pair(x, y));
+                    if (it != m_labelGrid.end()) {
+                        for (const LabelRect& other : it->second) {
+                            if (rect.intersects(other))
+                                return false;
+                        }
+                    }
+                }
+            }
+            
+            for (int x = minX; x <= maxX; ++x) {
+                for (int y = minY; y <= maxY; ++y)
+                    m_labelGrid[std::make_pair(x, y)].push_back(rect);
+            }
+            return true;
+        }
+        
         Vec2f TextRenderer::stringSize(RenderContext& renderContext, const AttrString& string) const {
             FontManager& fontManager = renderContext.fontManager();
             TextureFont& font = fontManager.font(m_fontDescriptor);
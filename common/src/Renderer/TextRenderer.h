@@ -68,6 +68,23 @@ namespace TrenchBroom {
                 EntryCollection();
             };
             
+            /*
+             * When decluttering, the screen space rectangles of the strings added so far are sorted into a uniform
+             * grid of buckets, and a new string is dropped if its rectangle overlaps one of the rectangles in the
+             * buckets it touches. Callers should therefore add the most important strings first.
+             */
+            static const float DeclutterCellSize;
+            
+            struct LabelRect {
+                float x, y, w, h;
+                
+                LabelRect(float i_x, float i_y, float i_w, float i_h);
+                bool intersects(const LabelRect& other) const;
+            };
+            
+            typedef std::vector<LabelRect> LabelRectList;
+            typedef std::map<std::pair<int, int>, LabelRectList> LabelGrid;
+            
             typedef VertexSpecs::P3T2C4::Vertex TextVertex;
             typedef VertexSpecs::P3C4::Vertex RectVertex;
             
@@ -78,9 +95,16 @@ namespace TrenchBroom {
             
             EntryCollection m_entries;
             EntryCollection m_entriesOnTop;
+            
+            bool m_declutter;
+            LabelGrid m_labelGrid;
         public:
             TextRenderer(const FontDescriptor& fontDescriptor, float maxViewDistance = DefaultMaxViewDistance, float minZoomFactor = DefaultMinZoomFactor, const Vec2f& inset = DefaultInset);
             
+            static float defaultMaxViewDistance();
+            
+            void setDeclutter(bool declutter);
+            
             void renderString(RenderContext& renderContext, const Color& textColor, const Color& backgroundColor, const AttrString& string, const TextAnchor& position);
             void renderStringOnTop(RenderContext& renderContext, const Color& textColor, const Color& backgroundColor, const AttrString& string, const TextAnchor& position);
         private:
@@ -89,6 +113,7 @@ namespace TrenchBroom {
             bool isVisible(RenderContext& renderContext, const AttrString& string, const TextAnchor& position, float distance, bool onTop) const;
             float computeAlphaFactor(const RenderContext& renderContext, float distance, bool onTop) const;
             void addEntry(EntryCollection& collection, const Entry& entry);
+            bool placeLabel(const LabelRect& rect);
             
             Vec2f stringSize(RenderContext& renderContext, const AttrString& string) const;
         private:
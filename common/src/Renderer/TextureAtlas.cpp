@@ -0,0 +1,174 @@
+/*
+ Copyright (C) 2010-2016 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TextureAtlas.h"
+
+#include "CollectionUtils.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        class TextureAtlas::Page {
+        private:
+            size_t m_size;
+            size_t m_padding;
+            std::vector<unsigned char> m_buffer;
+            size_t m_x;
+            size_t m_y;
+            size_t m_shelfHeight;
+            GLuint m_textureId;
+        public:
+            Page(const size_t size, const size_t padding) :
+            m_size(size),
+            m_padding(padding),
+            m_buffer(3 * size * size, 0),
+            m_x(padding),
+            m_y(padding),
+            m_shelfHeight(0),
+            m_textureId(0) {}
+            
+            ~Page() {
+                if (m_textureId != 0) {
+                    glAssert(glDeleteTextures(1, &m_textureId));
+                    m_textureId = 0;
+                }
+            }
+            
+            bool insert(const unsigned char* image, const size_t width, const size_t height, Slot& slot) {
+                assert(m_textureId == 0);
+                
+                if (m_x + width + m_padding > m_size) {
+                    m_x = m_padding;
+                    m_y += m_shelfHeight + m_padding;
+                    m_shelfHeight = 0;
+                }
+                
+                if (m_x + width + m_padding > m_size || m_y + height + m_padding > m_size)
+                    return false;
+                
+                for (size_t row = 0; row < height; ++row)
+                    std::memcpy(&m_buffer[3 * ((m_y + row) * m_size + m_x)], image + 3 * row * width, 3 * width);
+                
+                // inset the texture coordinates by half a texel so that linear filtering does not pick up the padding
+                const float size = static_cast<float>(m_size);
+                slot.width = width;
+                slot.height = height;
+                slot.texCoordsMin = Vec2f((static_cast<float>(m_x) + 0.5f) / size,
+                                          (static_cast<float>(m_y) + 0.5f) / size);
+                slot.texCoordsMax = Vec2f((static_cast<float>(m_x + width) - 0.5f) / size,
+                                          (static_cast<float>(m_y + height) - 0.5f) / size);
+                
+                m_x += width + m_padding;
+                m_shelfHeight = std::max(m_shelfHeight, height);
+                return true;
+            }
+            
+            void prepare() {
+                assert(m_textureId == 0);
+                
+                glAssert(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+                glAssert(glGenTextures(1, &m_textureId));
+                glAssert(glBindTexture(GL_TEXTURE_2D, m_textureId));
+                glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
+                glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+                glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+                glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+                glAssert(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB,
+                                      static_cast<GLsizei>(m_size),
+                                      static_cast<GLsizei>(m_size),
+                                      0, GL_RGB, GL_UNSIGNED_BYTE, &m_buffer.front()));
+                glAssert(glBindTexture(GL_TEXTURE_2D, 0));
+                
+                // the pixels are on the GPU now
+                std::vector<unsigned char>().swap(m_buffer);
+            }
+            
+            void activate() const {
+                assert(m_textureId != 0);
+                glAssert(glBindTexture(GL_TEXTURE_2D, m_textureId));
+            }
+        };
+        
+        TextureAtlas::Slot::Slot() :
+        page(0),
+        width(0),
+        height(0) {}
+        
+        TextureAtlas::TextureAtlas(const size_t pageSize, const size_t padding) :
+        m_pageSize(pageSize),
+        m_padding(padding),
+        m_prepared(false) {
+            assert(m_pageSize > 2 * m_padding);
+        }
+        
+        TextureAtlas::~TextureAtlas() {
+            VectorUtils::clearAndDelete(m_pages);
+        }
+        
+        size_t TextureAtlas::pageSize() const {
+            return m_pageSize;
+        }
+        
+        size_t TextureAtlas::pageCount() const {
+            return m_pages.size();
+        }
+        
+        bool TextureAtlas::insert(const unsigned char* image, const size_t width, const size_t height, Slot& slot) {
+            ensure(!m_prepared, "atlas is already prepared");
+            assert(width > 0 && height > 0);
+            
+            if (width + 2 * m_padding > m_pageSize || height + 2 * m_padding > m_pageSize)
+                return false;
+            
+            // only the last page can have free space since pages are never revisited
+            if (m_pages.empty() || !m_pages.back()->insert(image, width, height, slot)) {
+                m_pages.push_back(new Page(m_pageSize, m_padding));
+                const bool inserted = m_pages.back()->insert(image, width, height, slot);
+                assert(inserted);
+                unused(inserted);
+            }
+            
+            slot.page = m_pages.size() - 1;
+            return true;
+        }
+        
+        bool TextureAtlas::prepared() const {
+            return m_prepared;
+        }
+        
+        void TextureAtlas::prepare() {
+            assert(!m_prepared);
+            for (Page* page : m_pages)
+                page->prepare();
+            m_prepared = true;
+        }
+        
+        void TextureAtlas::activate(const size_t page) const {
+            ensure(page < m_pages.size(), "page index out of range");
+            m_pages[page]->activate();
+        }
+        
+        void TextureAtlas::deactivate() const {
+            glAssert(glBindTexture(GL_TEXTURE_2D, 0));
+        }
+    }
+}
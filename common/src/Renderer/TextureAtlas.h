@@ -0,0 +1,76 @@
+/*
+ Copyright (C) 2010-2016 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_TextureAtlas
+#define TrenchBroom_TextureAtlas
+
+#include "Macros.h"
+#include "VecMath.h"
+#include "Renderer/GL.h"
+
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        /**
+         * Packs small RGB images into a few large textures so that many of them can be rendered with a single
+         * texture bind. Images are placed on shelves from left to right and top to bottom. When an image does not
+         * fit onto the current page anymore, a new page is started.
+         */
+        class TextureAtlas {
+        public:
+            class Slot {
+            public:
+                size_t page;
+                size_t width;
+                size_t height;
+                Vec2f texCoordsMin;
+                Vec2f texCoordsMax;
+                
+                Slot();
+            };
+        private:
+            class Page;
+            typedef std::vector<Page*> PageList;
+            
+            size_t m_pageSize;
+            size_t m_padding;
+            PageList m_pages;
+            bool m_prepared;
+        public:
+            TextureAtlas(size_t pageSize = 1024, size_t padding = 1);
+            ~TextureAtlas();
+            
+            size_t pageSize() const;
+            size_t pageCount() const;
+            
+            bool insert(const unsigned char* image, size_t width, size_t height, Slot& slot);
+            
+            bool prepared() const;
+            void prepare();
+            
+            void activate(size_t page) const;
+            void deactivate() const;
+            
+            deleteCopyAndAssignment(TextureAtlas)
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_TextureAtlas) */
@@ -23,6 +23,8 @@
 
 namespace TrenchBroom {
     namespace Renderer {
+        const size_t TextureFont::MaxCachedStrings = 4096;
+        
         TextureFont::TextureFont(FontTexture* texture, const FontGlyph::List& glyphs, const size_t lineHeight, const unsigned char firstChar, const unsigned char charCount) :
         m_texture(texture),
         m_glyphs(glyphs),
@@ -151,6 +153,34 @@ namespace TrenchBroom {
         };
         
         Vec2f::List TextureFont::quads(const AttrString& string, const bool clockwise, const Vec2f& offset) {
+            if (offset != Vec2f::Null)
+                return layoutQuads(string, clockwise, offset);
+            
+            QuadCache& cache = m_quadCache[clockwise ? 1 : 0];
+            QuadCache::const_iterator it = cache.find(string);
+            if (it != cache.end())
+                return it->second;
+            
+            if (cache.size() >= MaxCachedStrings)
+                cache.clear();
+            const Vec2f::List vertices = layoutQuads(string, clockwise, offset);
+            cache.insert(std::make_pair(string, vertices));
+            return vertices;
+        }
+
+        Vec2f TextureFont::measure(const AttrString& string) {
+            SizeCache::const_iterator it = m_sizeCache.find(string);
+            if (it != m_sizeCache.end())
+                return it->second;
+            
+            if (m_sizeCache.size() >= MaxCachedStrings)
+                m_sizeCache.clear();
+            const Vec2f size = layoutSize(string);
+            m_sizeCache.insert(std::make_pair(string, size));
+            return size;
+        }
+
+        Vec2f::List TextureFont::layoutQuads(const AttrString& string, const bool clockwise, const Vec2f& offset) {
             MeasureLines measureLines(*this);
             string.lines(measureLines);
             const Vec2f::List& sizes = measureLines.sizes();
@@ -160,7 +190,7 @@ namespace TrenchBroom {
             return makeQuads.vertices();
         }
 
-        Vec2f TextureFont::measure(const AttrString& string) {
+        Vec2f TextureFont::layoutSize(const AttrString& string) {
             MeasureString measureString(*this);
             string.lines(measureString);
             return measureString.size();
@@ -26,6 +26,7 @@
 #include "Renderer/FontGlyph.h"
 #include "Renderer/FontGlyphBuilder.h"
 
+#include <map>
 #include <vector>
 
 namespace TrenchBroom {
@@ -33,14 +34,26 @@ namespace TrenchBroom {
         class FontTexture;
         
         class TextureFont {
-        public:
         private:
+            /*
+             * Laying out a string is expensive compared to copying its vertices, and the same strings (e.g. entity
+             * classnames) are rendered over and over again, so the sizes and quads of attributed strings are cached.
+             * Only quads without an offset are cached. The caches are cleared once they exceed a maximum size.
+             */
+            static const size_t MaxCachedStrings;
+            
+            typedef std::map<AttrString, Vec2f> SizeCache;
+            typedef std::map<AttrString, Vec2f::List> QuadCache;
+            
             FontTexture* m_texture;
             FontGlyph::List m_glyphs;
             size_t m_lineHeight;
             
             unsigned char m_firstChar;
             unsigned char m_charCount;
+            
+            SizeCache m_sizeCache;
+            QuadCache m_quadCache[2];
         public:
             TextureFont(FontTexture* texture, const FontGlyph::List& glyphs, size_t lineHeight, unsigned char firstChar, unsigned char charCount);
             ~TextureFont();
@@ -53,6 +66,9 @@ namespace TrenchBroom {
             
             void activate();
             void deactivate();
+        private:
+            Vec2f::List layoutQuads(const AttrString& string, bool clockwise, const Vec2f& offset);
+            Vec2f layoutSize(const AttrString& string);
         };
     }
 }
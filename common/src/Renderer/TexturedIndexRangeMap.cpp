@@ -32,6 +32,11 @@ namespace TrenchBroom {
             sizeForKey.inc(primType, count);
         }
 
+        void TexturedIndexRangeMap::Size::incPolygon(const Texture* texture, const size_t vertexCount) {
+            IndexRangeMap::Size& sizeForKey = findCurrent(texture);
+            sizeForKey.incPolygon(vertexCount);
+        }
+
         IndexRangeMap::Size& TexturedIndexRangeMap::Size::findCurrent(const Texture* texture) {
             if (!isCurrent(texture))
                 m_current = MapUtils::findOrInsert(m_sizes, texture, IndexRangeMap::Size());
@@ -86,6 +91,11 @@ namespace TrenchBroom {
             current.add(primType, index, count);
         }
 
+        void TexturedIndexRangeMap::addPolygon(const Texture* texture, const size_t index, const size_t count) {
+            IndexRangeMap& current = findCurrent(texture);
+            current.addPolygon(index, count);
+        }
+
         void TexturedIndexRangeMap::render(VertexArray& vertexArray) {
             DefaultTextureRenderFunc func;
             render(vertexArray, func);
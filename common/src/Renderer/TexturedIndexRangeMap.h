@@ -51,6 +51,7 @@ namespace TrenchBroom {
             public:
                 Size();
                 void inc(const Texture* texture, PrimType primType, size_t count = 1);
+                void incPolygon(const Texture* texture, size_t vertexCount);
             private:
                 IndexRangeMap::Size& findCurrent(const Texture* texture);
                 bool isCurrent(const Texture* texture) const;
@@ -67,6 +68,7 @@ namespace TrenchBroom {
             TexturedIndexRangeMap(const Texture* texture, PrimType primType, size_t index, size_t count);
 
             void add(const Texture* texture, PrimType primType, size_t index, size_t count);
+            void addPolygon(const Texture* texture, size_t index, size_t count);
             
             void render(VertexArray& vertexArray);
             void render(VertexArray& vertexArray, TextureRenderFunc& func);
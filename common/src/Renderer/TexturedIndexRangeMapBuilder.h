@@ -115,7 +115,8 @@ namespace TrenchBroom {
             }
             
             void addPolygon(const Texture* texture, const VertexList& vertices) {
-                add(texture, GL_POLYGON, m_vertexListBuilder.addPolygon(vertices));
+                const IndexData data = m_vertexListBuilder.addPolygon(vertices);
+                m_indexRange.addPolygon(texture, data.index, data.count);
             }
         private:
             void add(const Texture* texture, const PrimType primType, const IndexData& data) {
@@ -20,6 +20,7 @@
 #include "Vbo.h"
 
 #include "Exceptions.h"
+#include "Macros.h"
 #include "Renderer/VboBlock.h"
 
 #include <algorithm>
@@ -27,12 +28,30 @@
 
 namespace TrenchBroom {
     namespace Renderer {
-        bool CompareVboBlocksByCapacity::operator() (const VboBlock* lhs, const VboBlock* rhs) const {
-            ensure(lhs != NULL, "lhs is null");
-            ensure(rhs != NULL, "rhs is null");
-            return lhs->capacity() < rhs->capacity();
+        static size_t lowestSetBit(const size_t mask) {
+            assert(mask != 0);
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<size_t>(__builtin_ctzll(static_cast<unsigned long long>(mask)));
+#else
+            size_t index = 0;
+            while ((mask & (static_cast<size_t>(1) << index)) == 0)
+                ++index;
+            return index;
+#endif
         }
-
+        
+        static size_t highestSetBit(const size_t mask) {
+            assert(mask != 0);
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<size_t>(63 - __builtin_clzll(static_cast<unsigned long long>(mask)));
+#else
+            size_t index = sizeof(size_t) * 8 - 1;
+            while ((mask & (static_cast<size_t>(1) << index)) == 0)
+                --index;
+            return index;
+#endif
+        }
+        
         ActivateVbo::ActivateVbo(Vbo& vbo) :
         m_vbo(vbo),
         m_wasActive(m_vbo.active()) {
@@ -45,19 +64,37 @@ namespace TrenchBroom {
                 m_vbo.deactivate();
         }
 
+        Vbo::Stats::Stats() :
+        totalCapacity(0),
+        freeCapacity(0),
+        usedBlockCount(0),
+        freeBlockCount(0),
+        largestFreeBlock(0) {}
+        
+        float Vbo::Stats::fragmentation() const {
+            if (freeCapacity == 0)
+                return 0.0f;
+            return 1.0f - static_cast<float>(largestFreeBlock) / static_cast<float>(freeCapacity);
+        }
+
         const float Vbo::GrowthFactor = 1.5f;
 
         Vbo::Vbo(const size_t initialCapacity, const GLenum type, const GLenum usage) :
         m_totalCapacity(initialCapacity),
-        m_freeCapacity(m_totalCapacity),
+        m_freeCapacity(0),
+        m_freeBinMask(0),
         m_firstBlock(NULL),
         m_lastBlock(NULL),
         m_state(State_Inactive),
         m_type(type),
         m_usage(usage),
-        m_vboId(0) {
+        m_vboId(0),
+        m_dirty(false) {
+            std::fill(m_freeBins, m_freeBins + BinCount, static_cast<VboBlock*>(NULL));
             m_lastBlock = m_firstBlock = new VboBlock(*this, 0, m_totalCapacity, NULL, NULL);
-            m_freeBlocks.push_back(m_firstBlock);
+            insertFreeBlock(m_firstBlock);
+            if (streaming())
+                m_shadow.resize(m_totalCapacity);
             assert(checkBlockChain());
         }
         
@@ -85,16 +122,14 @@ namespace TrenchBroom {
                 throw e;
             }
 
-            VboBlockList::iterator it = findFreeBlock(capacity);
-            if (it == std::end(m_freeBlocks)) {
+            VboBlock* block = findFreeBlock(capacity);
+            if (block == NULL) {
                 increaseCapacityToAccomodate(capacity);
-                it = findFreeBlock(capacity);
+                block = findFreeBlock(capacity);
             }
             
-            assert(it != std::end(m_freeBlocks));
-            VboBlock* block = *it;
             ensure(block != NULL, "block is null");
-            removeFreeBlock(it);
+            removeFreeBlock(block);
             
             if (block->capacity() > capacity) {
                 VboBlock* remainder = block->split(capacity);
@@ -132,6 +167,99 @@ namespace TrenchBroom {
             m_state = State_Inactive;
         }
         
+        Vbo::Stats Vbo::stats() const {
+            Stats result;
+            result.totalCapacity = m_totalCapacity;
+            result.freeCapacity = m_freeCapacity;
+            
+            for (const VboBlock* block = m_firstBlock; block != NULL; block = block->next()) {
+                if (block->isFree()) {
+                    ++result.freeBlockCount;
+                    result.largestFreeBlock = std::max(result.largestFreeBlock, block->capacity());
+                } else {
+                    ++result.usedBlockCount;
+                }
+            }
+            
+            return result;
+        }
+
+        bool Vbo::streaming() const {
+            return m_usage == GL_STREAM_DRAW;
+        }
+
+        void Vbo::flush() {
+            assert(active());
+            assert(!partiallyMapped());
+            assert(!fullyMapped());
+            
+            if (!streaming() || !m_dirty)
+                return;
+            
+            // only the range up to the end of the last used block has to be uploaded
+            const size_t size = m_totalCapacity - (m_lastBlock->isFree() ? m_lastBlock->capacity() : 0);
+            
+            glAssert(glBufferData(m_type, static_cast<GLsizeiptr>(m_totalCapacity), NULL, m_usage));
+            if (size > 0)
+                glAssert(glBufferSubData(m_type, 0, static_cast<GLsizeiptr>(size), &m_shadow.front()));
+            m_dirty = false;
+        }
+
+        void Vbo::compact() {
+            assert(active());
+            assert(!partiallyMapped());
+            assert(!fullyMapped());
+            assert(checkBlockChain());
+            
+            if (m_freeCapacity == 0 || (m_lastBlock->isFree() && m_lastBlock->capacity() == m_freeCapacity))
+                return;
+            
+            unsigned char* buffer = streaming() ? &m_shadow.front() : map(GL_READ_WRITE);
+            
+            // Slide every used block down to the end of its predecessor and unlink all free blocks. Blocks are
+            // visited in ascending order of their offsets, so memmove never overwrites data that is yet to be moved.
+            size_t cursor = 0;
+            VboBlock* previousUsed = NULL;
+            VboBlock* block = m_firstBlock;
+            while (block != NULL) {
+                VboBlock* next = block->next();
+                if (block->isFree()) {
+                    removeFreeBlock(block);
+                    delete block;
+                } else {
+                    if (block->offset() != cursor) {
+                        memmove(buffer + cursor, buffer + block->offset(), block->capacity());
+                        block->setOffset(cursor);
+                    }
+                    block->setPrevious(previousUsed);
+                    if (previousUsed != NULL)
+                        previousUsed->setNext(block);
+                    else
+                        m_firstBlock = block;
+                    previousUsed = block;
+                    cursor += block->capacity();
+                }
+                block = next;
+            }
+            
+            if (streaming())
+                m_dirty = true;
+            else
+                unmap();
+            
+            assert(m_freeCapacity == 0);
+            assert(previousUsed != NULL);
+            previousUsed->setNext(NULL);
+            m_lastBlock = previousUsed;
+            
+            if (cursor < m_totalCapacity) {
+                m_lastBlock = m_lastBlock->createSuccessor(m_totalCapacity - cursor);
+                insertFreeBlock(m_lastBlock);
+            }
+            
+            assert(checkBlockChain());
+        }
+
         GLenum Vbo::type() const {
             return m_type;
         }
@@ -182,6 +310,19 @@ namespace TrenchBroom {
             assert(checkBlockChain());
         }
 
+        void Vbo::write(const size_t offset, const GLvoid* data, const size_t size) {
+            if (size == 0)
+                return;
+            
+            if (streaming()) {
+                assert(offset + size <= m_shadow.size());
+                memcpy(&m_shadow[offset], data, size);
+                m_dirty = true;
+            } else {
+                glAssert(glBufferSubData(m_type, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data));
+            }
+        }
+
         void Vbo::increaseCapacityToAccomodate(const size_t capacity) {
             size_t newMinCapacity = m_totalCapacity + capacity;
             if (m_lastBlock->isFree())
@@ -215,10 +356,16 @@ namespace TrenchBroom {
             }
             
             m_totalCapacity += delta;
-            m_freeCapacity += delta;
             assert(checkBlockChain());
             
-            if (begin < end) {
+            if (streaming()) {
+                // the contents are kept in client memory and will be uploaded on the next flush
+                m_shadow.resize(m_totalCapacity);
+                m_dirty = true;
+                deactivate();
+                free();
+                activate();
+            } else if (begin < end) {
                 unsigned char* buffer = map();
                 
                 unsigned char* temp = new unsigned char[end - begin];
@@ -241,37 +388,72 @@ namespace TrenchBroom {
             }
         }
 
-        Vbo::VboBlockList::iterator Vbo::findFreeBlock(const size_t minCapacity) {
-            VboBlock query(*this, 0, minCapacity, NULL, NULL);
-            return std::lower_bound(std::begin(m_freeBlocks), std::end(m_freeBlocks), &query, CompareVboBlocksByCapacity());
+        size_t Vbo::binIndex(const size_t capacity) {
+            if (capacity == 0)
+                return 0;
+            return highestSetBit(capacity);
+        }
+
+        VboBlock* Vbo::findFreeBlock(const size_t minCapacity) const {
+            const size_t index = binIndex(minCapacity);
+            
+            // if the requested capacity is a power of two, every block in the matching bin is large enough,
+            // otherwise only the blocks in the larger bins are guaranteed to be
+            const bool exactBin = (minCapacity & (minCapacity - 1)) == 0;
+            const size_t firstBin = exactBin ? index : index + 1;
+            if (firstBin < BinCount) {
+                const size_t candidateBins = m_freeBinMask & ~((static_cast<size_t>(1) << firstBin) - 1);
+                if (candidateBins != 0)
+                    return m_freeBins[lowestSetBit(candidateBins)];
+            }
+            
+            // before the caller has to grow the buffer, check whether the matching bin holds a large enough block
+            if (!exactBin) {
+                for (VboBlock* block = m_freeBins[index]; block != NULL; block = block->nextFree()) {
+                    if (block->capacity() >= minCapacity)
+                        return block;
+                }
+            }
+            return NULL;
         }
 
         void Vbo::insertFreeBlock(VboBlock* block) {
-            VboBlockList::iterator it = std::lower_bound(std::begin(m_freeBlocks), std::end(m_freeBlocks), block, CompareVboBlocksByCapacity());
-            if (it == std::end(m_freeBlocks))
-                m_freeBlocks.push_back(block);
-            else
-                m_freeBlocks.insert(it, block);
+            ensure(block != NULL, "block is null");
+            
+            const size_t index = binIndex(block->capacity());
+            VboBlock* head = m_freeBins[index];
+            block->setPreviousFree(NULL);
+            block->setNextFree(head);
+            if (head != NULL)
+                head->setPreviousFree(block);
+            m_freeBins[index] = block;
+            m_freeBinMask |= (static_cast<size_t>(1) << index);
+            
             block->setFree(true);
             m_freeCapacity += block->capacity();
         }
 
         void Vbo::removeFreeBlock(VboBlock* block) {
-            VboBlockList::iterator it = std::lower_bound(std::begin(m_freeBlocks), std::end(m_freeBlocks), block, CompareVboBlocksByCapacity());
-            assert(it != std::end(m_freeBlocks));
-            if (*it != block) {
-                const VboBlockList::iterator end = std::upper_bound(std::begin(m_freeBlocks), std::end(m_freeBlocks), block, CompareVboBlocksByCapacity());
-                while (it != end && *it != block)
-                    ++it;
-                assert(it != end);
+            ensure(block != NULL, "block is null");
+            assert(block->isFree());
+            
+            const size_t index = binIndex(block->capacity());
+            VboBlock* previousFree = block->previousFree();
+            VboBlock* nextFree = block->nextFree();
+            
+            if (previousFree != NULL) {
+                previousFree->setNextFree(nextFree);
+            } else {
+                assert(m_freeBins[index] == block);
+                m_freeBins[index] = nextFree;
+                if (nextFree == NULL)
+                    m_freeBinMask &= ~(static_cast<size_t>(1) << index);
             }
-            assert(*it == block);
-            removeFreeBlock(it);
-        }
-
-        void Vbo::removeFreeBlock(const VboBlockList::iterator it) {
-            VboBlock* block = *it;
-            m_freeBlocks.erase(it);
+            if (nextFree != NULL)
+                nextFree->setPreviousFree(previousFree);
+            
+            block->setPreviousFree(NULL);
+            block->setNextFree(NULL);
             block->setFree(false);
             m_freeCapacity -= block->capacity();
         }
@@ -297,7 +479,7 @@ namespace TrenchBroom {
             return m_state == State_FullyMapped;
         }
         
-        unsigned char* Vbo::map() {
+        unsigned char* Vbo::map(const GLenum access) {
             assert(active());
             assert(!fullyMapped());
             assert(!partiallyMapped());
@@ -306,7 +488,7 @@ namespace TrenchBroom {
             // fixes a crash on Mac OS X where a buffer could not be mapped after another windows was closed
             glAssert(glFinishObjectAPPLE(GL_BUFFER_OBJECT_APPLE, static_cast<GLint>(m_vboId)));
 #endif
-            unsigned char* buffer = reinterpret_cast<unsigned char *>(glMapBuffer(m_type, GL_WRITE_ONLY));
+            unsigned char* buffer = reinterpret_cast<unsigned char *>(glMapBuffer(m_type, access));
             ensure(buffer != NULL, "buffer is null");
             m_state = State_FullyMapped;
             
@@ -344,6 +526,28 @@ namespace TrenchBroom {
             }
             assert(count == 0);
             
+            return checkFreeBins();
+        }
+
+        bool Vbo::checkFreeBins() const {
+            size_t freeCapacity = 0;
+            for (size_t i = 0; i < BinCount; ++i) {
+                const bool empty = m_freeBins[i] == NULL;
+                assert(empty == ((m_freeBinMask & (static_cast<size_t>(1) << i)) == 0));
+                unused(empty);
+                
+                const VboBlock* previous = NULL;
+                for (const VboBlock* block = m_freeBins[i]; block != NULL; block = block->nextFree()) {
+                    assert(block->isFree());
+                    assert(block->previousFree() == previous);
+                    assert(binIndex(block->capacity()) == i);
+                    freeCapacity += block->capacity();
+                    previous = block;
+                }
+            }
+            
+            assert(freeCapacity == m_freeCapacity);
+            unused(freeCapacity);
             return true;
         }
     }
@@ -31,11 +31,6 @@ namespace TrenchBroom {
     namespace Renderer {
         class VboBlock;
         
-        class CompareVboBlocksByCapacity {
-        public:
-            bool operator() (const VboBlock* lhs, const VboBlock* rhs) const;
-        };
-        
         class Vbo;
         class ActivateVbo {
         private:
@@ -49,6 +44,25 @@ namespace TrenchBroom {
         class Vbo {
         public:
             typedef std::shared_ptr<Vbo> Ptr;
+            
+            /**
+             * Describes how the buffer's capacity is currently split into used and free blocks.
+             */
+            struct Stats {
+                size_t totalCapacity;
+                size_t freeCapacity;
+                size_t usedBlockCount;
+                size_t freeBlockCount;
+                size_t largestFreeBlock;
+                
+                Stats();
+                
+                /**
+                 * Returns a value between 0 and 1 that indicates how much of the free capacity is unusable for an
+                 * allocation of the largest possible size. 0 means that all free capacity is contiguous.
+                 */
+                float fragmentation() const;
+            };
         private:
             typedef enum {
                 State_Inactive = 0,
@@ -57,13 +71,21 @@ namespace TrenchBroom {
                 State_FullyMapped = 3
             } State;
         private:
-            typedef std::vector<VboBlock*> VboBlockList;
             static const float GrowthFactor;
             
+            /*
+             * Free blocks are kept in segregated free lists. Bin i holds the free blocks whose capacity c satisfies
+             * 2^i <= c < 2^(i+1) (bin 0 also holds empty blocks). Each bin is an intrusive doubly linked list, and a
+             * bit mask records which bins are non-empty. Inserting and removing a free block are constant time
+             * operations, and so is finding a sufficiently large block as long as some bin above the requested size
+             * is non-empty. Only if there is none is the matching bin scanned before the buffer has to grow.
+             */
+            static const size_t BinCount = sizeof(size_t) * 8;
+            
             size_t m_totalCapacity;
             size_t m_freeCapacity;
-            VboBlockList m_freeBlocks;
-            VboBlockList m_usedBlocks;
+            VboBlock* m_freeBins[BinCount];
+            size_t m_freeBinMask;
             VboBlock* m_firstBlock;
             VboBlock* m_lastBlock;
             State m_state;
@@ -71,6 +93,14 @@ namespace TrenchBroom {
             GLenum m_type;
             GLenum m_usage;
             GLuint m_vboId;
+            
+            /*
+             * Streaming vbos (usage GL_STREAM_DRAW) keep a copy of their contents in client memory. Writes go to
+             * this copy, and flush() uploads it with a single call after orphaning the buffer's storage, so that the
+             * driver never has to wait until the GPU has finished reading the data written for the previous frame.
+             */
+            std::vector<unsigned char> m_shadow;
+            bool m_dirty;
         public:
             Vbo(const size_t initialCapacity, const GLenum type = GL_ARRAY_BUFFER, const GLenum usage = GL_DYNAMIC_DRAW);
             ~Vbo();
@@ -80,6 +110,27 @@ namespace TrenchBroom {
             bool active() const;
             void activate();
             void deactivate();
+            
+            Stats stats() const;
+            
+            /**
+             * Indicates whether this vbo was created with GL_STREAM_DRAW usage. Such vbos are meant for data that is
+             * written once per frame and then discarded.
+             */
+            bool streaming() const;
+            
+            /**
+             * Uploads all data written to a streaming vbo since the last flush. Does nothing for other vbos, whose
+             * blocks are written directly. The vbo must be active and unmapped.
+             */
+            void flush();
+            
+            /**
+             * Moves all used blocks to the front of the buffer so that the free capacity forms a single block at its
+             * end. The blocks keep their identity, only their offsets change, so this must not be called while
+             * vertex or index data from this buffer is set up for rendering. The vbo must be active and unmapped.
+             */
+            void compact();
         private:
             friend class ActivateVbo;
             friend class VboBlock;
@@ -88,23 +139,27 @@ namespace TrenchBroom {
             
             void free();
             void freeBlock(VboBlock* block);
+            
+            void write(size_t offset, const GLvoid* data, size_t size);
 
             void increaseCapacityToAccomodate(const size_t capacity);
             void increaseCapacity(size_t delta);
-            VboBlockList::iterator findFreeBlock(size_t minCapacity);
+            
+            static size_t binIndex(size_t capacity);
+            VboBlock* findFreeBlock(size_t minCapacity) const;
             void insertFreeBlock(VboBlock* block);
             void removeFreeBlock(VboBlock* block);
-            void removeFreeBlock(VboBlockList::iterator it);
 
             bool partiallyMapped() const;
             void mapPartially();
             void unmapPartially();
             
             bool fullyMapped() const;
-            unsigned char* map();
+            unsigned char* map(GLenum access = GL_WRITE_ONLY);
             void unmap();
 
             bool checkBlockChain() const;
+            bool checkFreeBins() const;
         };
     }
 }
@@ -40,6 +40,8 @@ namespace TrenchBroom {
         m_capacity(capacity),
         m_previous(previous),
         m_next(next),
+        m_previousFree(NULL),
+        m_nextFree(NULL),
         m_mapped(false) {}
         
         Vbo& VboBlock::vbo() const {
@@ -90,6 +92,22 @@ namespace TrenchBroom {
             m_next = next;
         }
         
+        VboBlock* VboBlock::previousFree() const {
+            return m_previousFree;
+        }
+        
+        void VboBlock::setPreviousFree(VboBlock* previousFree) {
+            m_previousFree = previousFree;
+        }
+        
+        VboBlock* VboBlock::nextFree() const {
+            return m_nextFree;
+        }
+        
+        void VboBlock::setNextFree(VboBlock* nextFree) {
+            m_nextFree = nextFree;
+        }
+        
         bool VboBlock::isFree() const {
             return m_free;
         }
@@ -102,6 +120,10 @@ namespace TrenchBroom {
             m_capacity = capacity;
         }
 
+        void VboBlock::setOffset(const size_t offset) {
+            m_offset = offset;
+        }
+
         VboBlock* VboBlock::mergeWithSuccessor() {
             ensure(m_next != NULL, "next is null");
             
@@ -49,6 +49,8 @@ namespace TrenchBroom {
             size_t m_capacity;
             VboBlock* m_previous;
             VboBlock* m_next;
+            VboBlock* m_previousFree;
+            VboBlock* m_nextFree;
             
             bool m_mapped;
         public:
@@ -71,10 +73,7 @@ namespace TrenchBroom {
                 const size_t size = buffer.size() * sizeof(T);
                 assert(address + size <= m_capacity);
                 
-                const GLvoid* ptr = static_cast<const GLvoid*>(&(buffer[0]));
-                const GLintptr offset = static_cast<GLintptr>(m_offset + address);
-                const GLsizeiptr sizei = static_cast<GLsizeiptr>(size);
-                glAssert(glBufferSubData(m_vbo.type(), offset, sizei, ptr));
+                m_vbo.write(m_offset + address, static_cast<const GLvoid*>(&(buffer[0])), size);
                 
                 return size;
             }
@@ -90,9 +89,15 @@ namespace TrenchBroom {
             VboBlock* next() const;
             void setNext(VboBlock* next);
             
+            VboBlock* previousFree() const;
+            void setPreviousFree(VboBlock* previousFree);
+            VboBlock* nextFree() const;
+            void setNextFree(VboBlock* nextFree);
+            
             bool isFree() const;
             void setFree(const bool free);
             void setCapacity(const size_t capacity);
+            void setOffset(const size_t offset);
             
             VboBlock* mergeWithSuccessor();
             VboBlock* split(const size_t capacity);
@@ -0,0 +1,44 @@
+/*
+ Copyright (C) 2010-2016 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_SIMD_h
+#define TrenchBroom_SIMD_h
+
+// SSE2 is part of every x86-64 target, so the batch kernels in Mat.h, Plane.h and BBox.h use it whenever the compiler
+// targets it. Other targets fall back to the generic implementations.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TB_SIMD_SSE2 1
+#include <emmintrin.h>
+
+namespace SIMD {
+    // Loads three consecutive floats into the lower lanes of a register, the highest lane is zero.
+    inline __m128 load3(const float* values) {
+        const __m128 xy = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(values));
+        return _mm_movelh_ps(xy, _mm_load_ss(values + 2));
+    }
+    
+    // Stores the lower three lanes of the given register without touching the memory beyond.
+    inline void store3(float* values, const __m128 v) {
+        _mm_storel_pi(reinterpret_cast<__m64*>(values), v);
+        _mm_store_ss(values + 2, _mm_movehl_ps(v, v));
+    }
+}
+#endif
+
+#endif
@@ -0,0 +1,62 @@
+/*
+ Copyright (C) 2010-2016 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StringPool.h"
+
+#include "Ensure.h"
+
+namespace TrenchBroom {
+    StringPool& StringPool::instance() {
+        // never destroyed so that interned strings outlive any static objects that still refer to them
+        static StringPool* pool = new StringPool();
+        return *pool;
+    }
+    
+    StringPool::StringPool() {}
+
+    const String* StringPool::intern(const String& str) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Pool::iterator it = m_pool.insert(std::make_pair(str, 0u)).first;
+        ++it->second;
+        return &it->first;
+    }
+    
+    void StringPool::release(const String* str) {
+        ensure(str != NULL, "str is null");
+        
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Pool::iterator it = m_pool.find(*str);
+        ensure(it != std::end(m_pool) && &it->first == str, "string is not interned");
+        if (--it->second == 0)
+            m_pool.erase(it);
+    }
+    
+    const String* StringPool::find(const String& str) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Pool::const_iterator it = m_pool.find(str);
+        if (it == std::end(m_pool))
+            return NULL;
+        return &it->first;
+    }
+    
+    size_t StringPool::size() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_pool.size();
+    }
+}
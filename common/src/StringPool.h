@@ -0,0 +1,63 @@
+/*
+ Copyright (C) 2010-2016 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_StringPool
+#define TrenchBroom_StringPool
+
+#include "Macros.h"
+#include "StringUtils.h"
+
+#include <mutex>
+#include <unordered_map>
+
+namespace TrenchBroom {
+    /**
+     * A reference counted pool of strings. Equal strings are interned to the same pooled instance, so
+     * interned strings can be compared and hashed by their address. Every call to intern must be balanced
+     * by a call to release, and the pooled string is freed once its last reference is released.
+     *
+     * The pool is safe to use from multiple threads.
+     */
+    class StringPool {
+    private:
+        typedef std::unordered_map<String, size_t> Pool;
+        
+        mutable std::mutex m_mutex;
+        Pool m_pool;
+    public:
+        static StringPool& instance();
+        
+        StringPool();
+        
+        const String* intern(const String& str);
+        void release(const String* str);
+        
+        /**
+         * Returns the interned instance of the given string without adding a reference, or NULL if the
+         * string has not been interned.
+         */
+        const String* find(const String& str) const;
+        
+        size_t size() const;
+        
+        deleteCopyAndAssignment(StringPool)
+    };
+}
+
+#endif /* defined(TrenchBroom_StringPool) */
@@ -0,0 +1,375 @@
+/*
+ Copyright (C) 2010-2016 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UniformGrid_h
+#define UniformGrid_h
+
+#include "BBox.h"
+#include "MathUtils.h"
+#include "Ray.h"
+#include "Vec.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <map>
+#include <set>
+#include <vector>
+
+/**
+ * A sparse uniform grid of cubic cells which stores a set of points. Only non-empty cells are kept, so memory is
+ * proportional to the number of points. Points that are equal up to the given epsilon are considered the same point,
+ * which matches the ordering used by Vec::LexicographicOrder.
+ */
+template <typename T>
+class UniformGrid {
+public:
+    typedef Vec<T,3> Point;
+    typedef std::vector<Point> PointList;
+    typedef BBox<T,3> Box;
+private:
+    struct Cell {
+        long x, y, z;
+        
+        Cell(const long i_x, const long i_y, const long i_z) :
+        x(i_x), y(i_y), z(i_z) {}
+        
+        bool operator<(const Cell& other) const {
+            if (x != other.x)
+                return x < other.x;
+            if (y != other.y)
+                return y < other.y;
+            return z < other.z;
+        }
+    };
+    
+    typedef std::map<Cell, PointList> CellMap;
+    
+    T m_cellSize;
+    T m_epsilon;
+    CellMap m_cells;
+    size_t m_size;
+    
+    // the range of cells that have been occupied since the grid was last cleared
+    Cell m_minCell;
+    Cell m_maxCell;
+public:
+    UniformGrid(const T cellSize = static_cast<T>(64.0), const T epsilon = Math::Constants<T>::almostZero()) :
+    m_cellSize(cellSize),
+    m_epsilon(epsilon),
+    m_size(0),
+    m_minCell(0, 0, 0),
+    m_maxCell(0, 0, 0) {
+        assert(m_cellSize > static_cast<T>(0.0));
+    }
+    
+    bool empty() const {
+        return m_size == 0;
+    }
+    
+    size_t size() const {
+        return m_size;
+    }
+    
+    size_t cellCount() const {
+        return m_cells.size();
+    }
+    
+    bool contains(const Point& point) const {
+        const Cell min = cell(point - Point(m_epsilon, m_epsilon, m_epsilon));
+        const Cell max = cell(point + Point(m_epsilon, m_epsilon, m_epsilon));
+        for (long x = min.x; x <= max.x; ++x) {
+            for (long y = min.y; y <= max.y; ++y) {
+                for (long z = min.z; z <= max.z; ++z) {
+                    const typename CellMap::const_iterator it = m_cells.find(Cell(x, y, z));
+                    if (it != std::end(m_cells) && findPoint(it->second, point) != std::end(it->second))
+                        return true;
+                }
+            }
+        }
+        return false;
+    }
+    
+    /**
+     * Inserts the given point unless an equal point is already present. Returns whether the point was inserted.
+     */
+    bool insert(const Point& point) {
+        if (contains(point))
+            return false;
+        
+        const Cell c = cell(point);
+        if (empty()) {
+            m_minCell = m_maxCell = c;
+        } else {
+            m_minCell = Cell(std::min(m_minCell.x, c.x), std::min(m_minCell.y, c.y), std::min(m_minCell.z, c.z));
+            m_maxCell = Cell(std::max(m_maxCell.x, c.x), std::max(m_maxCell.y, c.y), std::max(m_maxCell.z, c.z));
+        }
+        
+        m_cells[c].push_back(point);
+        ++m_size;
+        return true;
+    }
+    
+    /**
+     * Removes the point equal to the given point, if any. Returns whether a point was removed.
+     */
+    bool remove(const Point& point) {
+        const Cell min = cell(point - Point(m_epsilon, m_epsilon, m_epsilon));
+        const Cell max = cell(point + Point(m_epsilon, m_epsilon, m_epsilon));
+        for (long x = min.x; x <= max.x; ++x) {
+            for (long y = min.y; y <= max.y; ++y) {
+                for (long z = min.z; z <= max.z; ++z) {
+                    const typename CellMap::iterator it = m_cells.find(Cell(x, y, z));
+                    if (it != std::end(m_cells)) {
+                        PointList& points = it->second;
+                        const typename PointList::iterator pIt = findPoint(points, point);
+                        if (pIt != std::end(points)) {
+                            *pIt = points.back();
+                            points.pop_back();
+                            if (points.empty())
+                                m_cells.erase(it);
+                            --m_size;
+                            return true;
+                        }
+                    }
+                }
+            }
+        }
+        return false;
+    }
+    
+    void clear() {
+        m_cells.clear();
+        m_size = 0;
+    }
+    
+    /**
+     * Returns all points whose distance to the given center is at most the given radius.
+     */
+    PointList findInRadius(const Point& center, const T radius) const {
+        PointList result;
+        const T radius2 = radius * radius;
+        
+        const Cell min = cell(center - Point(radius, radius, radius));
+        const Cell max = cell(center + Point(radius, radius, radius));
+        const double cellsInRange = double(max.x - min.x + 1) * double(max.y - min.y + 1) * double(max.z - min.z + 1);
+        
+        if (cellsInRange > double(m_cells.size())) {
+            for (const auto& entry : m_cells)
+                collectInRadius(entry.second, center, radius2, result);
+        } else {
+            for (long x = min.x; x <= max.x; ++x) {
+                for (long y = min.y; y <= max.y; ++y) {
+                    for (long z = min.z; z <= max.z; ++z) {
+                        const typename CellMap::const_iterator it = m_cells.find(Cell(x, y, z));
+                        if (it != std::end(m_cells))
+                            collectInRadius(it->second, center, radius2, result);
+                    }
+                }
+            }
+        }
+        
+        return result;
+    }
+    
+    /**
+     * Returns the points of all cells which the given ray passes within reach of. The reach of a cell is determined by
+     * the given function, which receives the bounds of a cell and must return an upper bound for the distance at which
+     * the caller considers a point in that cell to be hit by the ray. The reach of a box must not be smaller than the
+     * reach of any cell within it.
+     *
+     * Only the cells along the ray are visited, padded by the reach at each step, unless the ray crosses so many cells
+     * that checking every non-empty cell is cheaper.
+     */
+    template <typename Reach>
+    PointList findNearRay(const Ray<T,3>& ray, const Reach& reach) const {
+        PointList result;
+        if (empty())
+            return result;
+        
+        // clip the ray to the occupied part of the grid, padded by the reach there
+        const Box occupied(cellBounds(m_minCell).min, cellBounds(m_maxCell).max);
+        T enter, exit;
+        if (!clipRay(ray, occupied.expanded(reach(occupied)), enter, exit))
+            return result;
+        
+        const Cell first = cell(ray.pointAtDistance(enter));
+        const Cell last = cell(ray.pointAtDistance(exit));
+        const double cellsOnRay = double(std::labs(last.x - first.x) + std::labs(last.y - first.y) + std::labs(last.z - first.z) + 1);
+        
+        // every step looks up at least the 27 cells around the current one
+        if (27.0 * cellsOnRay > double(m_cells.size())) {
+            for (const auto& entry : m_cells)
+                collectNearRay(entry.first, entry.second, ray, reach, result);
+        } else {
+            traverse(ray, reach, enter, exit, first, result);
+        }
+        
+        return result;
+    }
+private:
+    Cell cell(const Point& point) const {
+        return Cell(static_cast<long>(std::floor(point.x() / m_cellSize)),
+                    static_cast<long>(std::floor(point.y() / m_cellSize)),
+                    static_cast<long>(std::floor(point.z() / m_cellSize)));
+    }
+    
+    /**
+     * Returns the lowest cell whose closed bounds contain the given point, which differs from cell(point) if the point
+     * is on a cell boundary.
+     */
+    Cell lowestCell(const Point& point) const {
+        return Cell(static_cast<long>(std::ceil(point.x() / m_cellSize)) - 1,
+                    static_cast<long>(std::ceil(point.y() / m_cellSize)) - 1,
+                    static_cast<long>(std::ceil(point.z() / m_cellSize)) - 1);
+    }
+    
+    Box cellBounds(const Cell& c) const {
+        const Point min(static_cast<T>(c.x) * m_cellSize,
+                        static_cast<T>(c.y) * m_cellSize,
+                        static_cast<T>(c.z) * m_cellSize);
+        return Box(min, min + Point(m_cellSize, m_cellSize, m_cellSize));
+    }
+    
+    /**
+     * Computes the range of distances at which the given ray is inside the given box. Returns false if the ray misses
+     * the box or only hits it behind its origin.
+     */
+    static bool clipRay(const Ray<T,3>& ray, const Box& box, T& enter, T& exit) {
+        enter = static_cast<T>(0.0);
+        exit = std::numeric_limits<T>::max();
+        
+        for (size_t i = 0; i < 3; ++i) {
+            const T o = ray.origin[i];
+            const T d = ray.direction[i];
+            if (d == static_cast<T>(0.0)) {
+                if (o < box.min[i] || o > box.max[i])
+                    return false;
+            } else {
+                T t1 = (box.min[i] - o) / d;
+                T t2 = (box.max[i] - o) / d;
+                if (t1 > t2)
+                    std::swap(t1, t2);
+                enter = std::max(enter, t1);
+                exit = std::min(exit, t2);
+                if (enter > exit)
+                    return false;
+            }
+        }
+        return true;
+    }
+    
+    /**
+     * Walks the cells that the given ray passes through between the given distances (Amanatides and Woo's 3D-DDA) and
+     * collects the points of the non-empty cells within reach of each of them.
+     */
+    template <typename Reach>
+    void traverse(const Ray<T,3>& ray, const Reach& reach, const T enter, const T exit, const Cell& first, PointList& result) const {
+        const Point start = ray.pointAtDistance(enter);
+        
+        long index[3] = { first.x, first.y, first.z };
+        long step[3];
+        T next[3];  // ray distance at which the next cell boundary is crossed on each axis
+        T delta[3]; // ray distance between two cell boundaries on each axis
+        
+        for (size_t i = 0; i < 3; ++i) {
+            const T d = ray.direction[i];
+            if (d > static_cast<T>(0.0)) {
+                step[i] = 1;
+                next[i] = enter + (static_cast<T>(index[i] + 1) * m_cellSize - start[i]) / d;
+                delta[i] = m_cellSize / d;
+            } else if (d < static_cast<T>(0.0)) {
+                step[i] = -1;
+                next[i] = enter + (static_cast<T>(index[i]) * m_cellSize - start[i]) / d;
+                delta[i] = -m_cellSize / d;
+            } else {
+                step[i] = 0;
+                next[i] = std::numeric_limits<T>::max();
+                delta[i] = std::numeric_limits<T>::max();
+            }
+        }
+        
+        std::set<Cell> visited;
+        while (true) {
+            collectNearCell(Cell(index[0], index[1], index[2]), ray, reach, visited, result);
+            
+            const size_t axis = next[0] < next[1] ? (next[0] < next[2] ? 0 : 2) : (next[1] < next[2] ? 1 : 2);
+            if (next[axis] > exit)
+                break;
+            index[axis] += step[axis];
+            next[axis] += delta[axis];
+        }
+    }
+    
+    template <typename Reach>
+    void collectNearCell(const Cell& c, const Ray<T,3>& ray, const Reach& reach, std::set<Cell>& visited, PointList& result) const {
+        // Any cell that reaches into this cell touches this cell's bounds expanded by its reach, so a box that is one
+        // more cell larger than that contains all of them and its reach bounds theirs.
+        const Box bounds = cellBounds(c);
+        const T padding = reach(bounds.expanded(reach(bounds) + m_cellSize));
+        
+        const Cell min = lowestCell(bounds.min - Point(padding, padding, padding));
+        const Cell max = cell(bounds.max + Point(padding, padding, padding));
+        for (long x = min.x; x <= max.x; ++x) {
+            for (long y = min.y; y <= max.y; ++y) {
+                for (long z = min.z; z <= max.z; ++z) {
+                    const Cell neighbour(x, y, z);
+                    const typename CellMap::const_iterator it = m_cells.find(neighbour);
+                    if (it != std::end(m_cells) && visited.insert(neighbour).second)
+                        collectNearRay(neighbour, it->second, ray, reach, result);
+                }
+            }
+        }
+    }
+    
+    template <typename Reach>
+    void collectNearRay(const Cell& c, const PointList& points, const Ray<T,3>& ray, const Reach& reach, PointList& result) const {
+        const Box bounds = cellBounds(c);
+        const Box expanded = bounds.expanded(reach(bounds));
+        if (expanded.contains(ray.origin) || !Math::isnan(expanded.intersectWithRay(ray)))
+            result.insert(std::end(result), std::begin(points), std::end(points));
+    }
+    
+    typename PointList::const_iterator findPoint(const PointList& points, const Point& point) const {
+        for (typename PointList::const_iterator it = std::begin(points), end = std::end(points); it != end; ++it) {
+            if (it->equals(point, m_epsilon))
+                return it;
+        }
+        return std::end(points);
+    }
+    
+    typename PointList::iterator findPoint(PointList& points, const Point& point) const {
+        for (typename PointList::iterator it = std::begin(points), end = std::end(points); it != end; ++it) {
+            if (it->equals(point, m_epsilon))
+                return it;
+        }
+        return std::end(points);
+    }
+    
+    void collectInRadius(const PointList& points, const Point& center, const T radius2, PointList& result) const {
+        for (const Point& point : points) {
+            if (center.squaredDistanceTo(point) <= radius2)
+                result.push_back(point);
+        }
+    }
+};
+
+#endif /* UniformGrid_h */
@@ -0,0 +1,154 @@
+/*
+ Copyright (C) 2010-2016 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AssetPreloader.h"
+
+#include "CollectionUtils.h"
+#include "Exceptions.h"
+#include "Logger.h"
+#include "Assets/EntityDefinition.h"
+#include "Assets/EntityDefinitionFileSpec.h"
+#include "Assets/EntityDefinitionManager.h"
+#include "Assets/TextureCollection.h"
+#include "Assets/TextureManager.h"
+#include "EL/VariableStore.h"
+#include "IO/SimpleParserStatus.h"
+#include "Model/EntityAttributes.h"
+#include "Model/Game.h"
+#include "Model/World.h"
+
+#include <chrono>
+
+namespace TrenchBroom {
+    namespace View {
+        typedef std::chrono::steady_clock Clock;
+        
+        static double millisecondsSince(const Clock::time_point& start) {
+            const std::chrono::duration<double, std::milli> time = Clock::now() - start;
+            return time.count();
+        }
+        
+        AssetPreloader::AssetPreloader(Model::GamePtr game, const IO::Path& documentPath) :
+        m_game(game),
+        m_documentPath(documentPath),
+        m_started(false) {}
+        
+        AssetPreloader::~AssetPreloader() {
+            // discard the results that were never handed over, this waits for the workers to finish
+            try {
+                if (m_entityDefinitions.valid()) {
+                    EntityDefinitionResult result = m_entityDefinitions.get();
+                    VectorUtils::clearAndDelete(result.assets);
+                }
+                if (m_textureCollections.valid()) {
+                    TextureCollectionResult result = m_textureCollections.get();
+                    VectorUtils::clearAndDelete(result.assets);
+                }
+            } catch (...) {}
+        }
+        
+        void AssetPreloader::start(const Model::World* world, const IO::Path::List& entityDefinitionSearchPaths) {
+            ensure(world != NULL, "world is null");
+            
+            // the workers of a previous call must not be replaced while they are running
+            if (m_started)
+                return;
+            
+            // copy everything the workers need from the world, which keeps changing while it is being parsed
+            const Assets::EntityDefinitionFileSpec spec = m_game->extractEntityDefinitionFile(world);
+            const IO::Path::List textureCollectionPaths = m_game->extractTextureCollections(world);
+            
+            EL::VariableTable variables;
+            for (const Model::EntityAttribute& attribute : world->attributes())
+                variables.declare(attribute.name(), EL::Value(attribute.value()));
+            
+            const IO::Path documentDirectory = m_documentPath.isEmpty() ? IO::Path() : m_documentPath.deleteLastComponent();
+            
+            m_entityDefinitions = std::async(std::launch::async, &AssetPreloader::loadEntityDefinitions, m_game, spec, entityDefinitionSearchPaths, &m_entityDefinitionLogger);
+            m_textureCollections = std::async(std::launch::async, &AssetPreloader::readTextureCollections, m_game, variables, documentDirectory, textureCollectionPaths, &m_textureCollectionLogger);
+            m_started = true;
+        }
+        
+        bool AssetPreloader::started() const {
+            return m_started;
+        }
+        
+        void AssetPreloader::finishEntityDefinitions(Assets::EntityDefinitionManager& manager, Logger* logger) {
+            assert(m_started);
+            
+            const Clock::time_point start = Clock::now();
+            const EntityDefinitionResult result = m_entityDefinitions.get();
+            const double waitTime = millisecondsSince(start);
+            
+            m_entityDefinitionLogger.setParentLogger(logger);
+            manager.setDefinitions(result.assets);
+            
+            if (logger != NULL)
+                logger->info("Loaded entity definitions in %.0fms (waited %.0fms)", result.time, waitTime);
+        }
+        
+        void AssetPreloader::finishTextureCollections(Assets::TextureManager& manager, Logger* logger) {
+            assert(m_started);
+            
+            const Clock::time_point start = Clock::now();
+            const TextureCollectionResult result = m_textureCollections.get();
+            const double waitTime = millisecondsSince(start);
+            
+            m_textureCollectionLogger.setParentLogger(logger);
+            manager.setTextureCollections(result.assets);
+            
+            if (logger != NULL)
+                logger->info("Read texture collections in %.0fms (waited %.0fms)", result.time, waitTime);
+        }
+
+        AssetPreloader::EntityDefinitionResult AssetPreloader::loadEntityDefinitions(Model::GamePtr game, const Assets::EntityDefinitionFileSpec& spec, const IO::Path::List& searchPaths, Logger* logger) {
+            const Clock::time_point start = Clock::now();
+            
+            EntityDefinitionResult result;
+            try {
+                const IO::Path path = game->findEntityDefinitionFile(spec, searchPaths);
+                IO::SimpleParserStatus status(logger);
+                result.assets = game->loadEntityDefinitions(status, path);
+                logger->info("Loaded entity definition file " + path.lastComponent().asString());
+            } catch (const Exception& e) {
+                if (spec.builtin())
+                    logger->error("Could not load builtin entity definition file '%s': %s", spec.path().asString().c_str(), e.what());
+                else
+                    logger->error("Could not load external entity definition file '%s': %s", spec.path().asString().c_str(), e.what());
+            }
+            
+            result.time = millisecondsSince(start);
+            return result;
+        }
+        
+        AssetPreloader::TextureCollectionResult AssetPreloader::readTextureCollections(Model::GamePtr game, const EL::VariableTable& variables, const IO::Path& documentPath, const IO::Path::List& paths, Logger* logger) {
+            const Clock::time_point start = Clock::now();
+            
+            TextureCollectionResult result;
+            try {
+                result.assets = game->readTextureCollections(variables, documentPath, paths, logger);
+            } catch (const Exception& e) {
+                logger->error(e.what());
+            }
+            
+            result.time = millisecondsSince(start);
+            return result;
+        }
+    }
+}
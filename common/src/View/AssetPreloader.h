@@ -0,0 +1,103 @@
+/*
+ Copyright (C) 2010-2016 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_AssetPreloader
+#define TrenchBroom_AssetPreloader
+
+#include "Macros.h"
+#include "SharedPointer.h"
+#include "Assets/AssetTypes.h"
+#include "IO/Path.h"
+#include "Model/ModelTypes.h"
+#include "View/CachingLogger.h"
+
+#include <future>
+
+namespace TrenchBroom {
+    class Logger;
+    
+    namespace EL {
+        class VariableTable;
+    }
+    
+    namespace Assets {
+        class EntityDefinitionManager;
+        class TextureManager;
+    }
+    
+    namespace View {
+        /**
+         * Reads the entity definitions and texture collections of a map on worker threads while the map itself is
+         * still being parsed. The preloader is started as soon as the worldspawn entity has been read, and its
+         * results are handed over to the asset managers once the map is loaded. The messages of the workers are
+         * cached and only passed on to the document's logger when the results are handed over.
+         *
+         * All member functions must be called on the main thread.
+         */
+        class AssetPreloader {
+        private:
+            template <typename T>
+            struct Result {
+                T assets;
+                double time;
+            };
+            
+            typedef Result<Assets::EntityDefinitionList> EntityDefinitionResult;
+            typedef Result<Assets::TextureCollectionList> TextureCollectionResult;
+            
+            Model::GamePtr m_game;
+            IO::Path m_documentPath;
+            bool m_started;
+            
+            CachingLogger m_entityDefinitionLogger;
+            std::future<EntityDefinitionResult> m_entityDefinitions;
+            
+            CachingLogger m_textureCollectionLogger;
+            std::future<TextureCollectionResult> m_textureCollections;
+        public:
+            AssetPreloader(Model::GamePtr game, const IO::Path& documentPath);
+            ~AssetPreloader();
+            
+            /**
+             * Starts reading the assets referenced by the given world on worker threads. The game's search paths
+             * must be set up for the world before this is called, and they must not change until the results
+             * have been handed over. Calling this again once the preloader has been started has no effect.
+             */
+            void start(const Model::World* world, const IO::Path::List& entityDefinitionSearchPaths);
+            bool started() const;
+            
+            /**
+             * Waits for the entity definitions to be loaded and passes them to the given manager.
+             */
+            void finishEntityDefinitions(Assets::EntityDefinitionManager& manager, Logger* logger);
+            
+            /**
+             * Waits for the texture collections to be read and passes them to the given manager.
+             */
+            void finishTextureCollections(Assets::TextureManager& manager, Logger* logger);
+        private:
+            static EntityDefinitionResult loadEntityDefinitions(Model::GamePtr game, const Assets::EntityDefinitionFileSpec& spec, const IO::Path::List& searchPaths, Logger* logger);
+            static TextureCollectionResult readTextureCollections(Model::GamePtr game, const EL::VariableTable& variables, const IO::Path& documentPath, const IO::Path::List& paths, Logger* logger);
+            
+            deleteCopyAndAssignment(AssetPreloader)
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_AssetPreloader) */
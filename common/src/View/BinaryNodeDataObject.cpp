@@ -0,0 +1,41 @@
+/*
+ Copyright (C) 2010-2016 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BinaryNodeDataObject.h"
+
+namespace TrenchBroom {
+    namespace View {
+        const wxDataFormat& BinaryNodeDataObject::format() {
+            static const wxDataFormat format("TrenchBroom/BinaryNodes");
+            return format;
+        }
+        
+        BinaryNodeDataObject::BinaryNodeDataObject() :
+        wxCustomDataObject(format()) {}
+        
+        BinaryNodeDataObject::BinaryNodeDataObject(const String& data) :
+        wxCustomDataObject(format()) {
+            SetData(data.size(), data.data());
+        }
+        
+        String BinaryNodeDataObject::data() const {
+            return String(static_cast<const char*>(GetData()), GetSize());
+        }
+    }
+}
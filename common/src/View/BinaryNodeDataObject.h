@@ -0,0 +1,45 @@
+/*
+ Copyright (C) 2010-2016 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_BinaryNodeDataObject
+#define TrenchBroom_BinaryNodeDataObject
+
+#include "StringUtils.h"
+
+#include <wx/dataobj.h>
+
+namespace TrenchBroom {
+    namespace View {
+        /**
+         * Carries binary node data written by IO::BinaryNodeWriter through the clipboard, so that nodes copied
+         * within the editor can be pasted without formatting and parsing map text.
+         */
+        class BinaryNodeDataObject : public wxCustomDataObject {
+        public:
+            static const wxDataFormat& format();
+            
+            BinaryNodeDataObject();
+            BinaryNodeDataObject(const String& data);
+            
+            String data() const;
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_BinaryNodeDataObject) */
@@ -403,14 +403,10 @@ namespace TrenchBroom {
             }
 
             size_t indexOfRowAt(const float y) const {
-                for (size_t i = 0; i < m_rows.size(); ++i) {
-                    const Row& row = m_rows[i];
-                    const LayoutBounds& rowBounds = row.bounds();
-                    if (y < rowBounds.bottom())
-                        return i;
-                }
-                
-                return m_rows.size();
+                // the rows are ordered from top to bottom, so we can search for the first row below y
+                const typename RowList::const_iterator it = std::upper_bound(std::begin(m_rows), std::end(m_rows), y,
+                                                                             [](const float value, const Row& row) { return value < row.bounds().bottom(); });
+                return static_cast<size_t>(std::distance(std::begin(m_rows), it));
             }
             
             bool rowAt(const float y, const Row** result) const {
@@ -423,7 +419,7 @@ namespace TrenchBroom {
             }
             
             bool cellAt(const float x, const float y, const typename Row::Cell** result) const {
-                for (size_t i = 0; i < m_rows.size(); ++i) {
+                for (size_t i = indexOfRowAt(y); i < m_rows.size(); ++i) {
                     const Row& row = m_rows[i];
                     const LayoutBounds& rowBounds = row.bounds();
                     if (y > rowBounds.bottom())
@@ -628,10 +624,7 @@ namespace TrenchBroom {
             }
 
             bool cellAt(const float x, const float y, const typename Group::Row::Cell** result) {
-                if (!m_valid)
-                    validate();
-
-                for (size_t i = 0; i < m_groups.size(); ++i) {
+                for (size_t i = indexOfGroupAt(y); i < m_groups.size(); ++i) {
                     const Group& group = m_groups[i];
                     const LayoutBounds groupBounds = group.bounds();
                     if (y > groupBounds.bottom())
@@ -665,6 +658,19 @@ namespace TrenchBroom {
                 return false;
             }
 
+            /**
+             * Returns the index of the first group whose bottom is not above the given y coordinate, or the
+             * number of groups if there is no such group.
+             */
+            size_t indexOfGroupAt(const float y) {
+                if (!m_valid)
+                    validate();
+                
+                const typename GroupList::iterator it = std::lower_bound(std::begin(m_groups), std::end(m_groups), y,
+                                                                         [](const Group& group, const float value) { return group.bounds().bottom() < value; });
+                return static_cast<size_t>(std::distance(std::begin(m_groups), it));
+            }
+            
             const LayoutBounds titleBoundsForVisibleRect(const Group& group, const float y, const float height) const {
                 return group.titleBoundsForVisibleRect(y, height, m_groupMargin);
             }
@@ -788,7 +794,7 @@ namespace TrenchBroom {
             }
             
             float outerMargin() const {
-                return m_outerMargin();
+                return m_outerMargin;
             }
             
             float groupMargin() const {
@@ -800,7 +806,7 @@ namespace TrenchBroom {
             }
             
             float cellMargin() const {
-                return m_cellMargin();
+                return m_cellMargin;
             }
         };
     }
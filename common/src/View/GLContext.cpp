@@ -35,6 +35,10 @@ namespace TrenchBroom {
             return m_contextManager->indexVbo();
         }
         
+        Renderer::Vbo& GLContext::streamVbo() {
+            return m_contextManager->streamVbo();
+        }
+        
         Renderer::FontManager& GLContext::fontManager() {
             return m_contextManager->fontManager();
         }
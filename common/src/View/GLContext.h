@@ -44,6 +44,7 @@ namespace TrenchBroom {
 
             Renderer::Vbo& vertexVbo();
             Renderer::Vbo& indexVbo();
+            Renderer::Vbo& streamVbo();
             Renderer::FontManager& fontManager();
             Renderer::ShaderManager& shaderManager();
             
@@ -30,12 +30,14 @@ namespace TrenchBroom {
         m_initialized(false),
         m_vertexVbo(new Renderer::Vbo(0xFFFFFF)),
         m_indexVbo(new Renderer::Vbo(0xFFFFF, GL_ELEMENT_ARRAY_BUFFER)),
+        m_streamVbo(new Renderer::Vbo(0xFFFFF, GL_ARRAY_BUFFER, GL_STREAM_DRAW)),
         m_fontManager(new Renderer::FontManager()),
         m_shaderManager(new Renderer::ShaderManager()) {}
         
         GLContextManager::~GLContextManager() {
             delete m_vertexVbo;
             delete m_indexVbo;
+            delete m_streamVbo;
             delete m_fontManager;
             delete m_shaderManager;
         }
@@ -72,6 +74,10 @@ namespace TrenchBroom {
             return *m_indexVbo;
         }
         
+        Renderer::Vbo& GLContextManager::streamVbo() {
+            return *m_streamVbo;
+        }
+        
         Renderer::FontManager& GLContextManager::fontManager() {
             return *m_fontManager;
         }
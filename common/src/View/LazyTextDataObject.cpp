@@ -0,0 +1,50 @@
+/*
+ Copyright (C) 2010-2016 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LazyTextDataObject.h"
+
+namespace TrenchBroom {
+    namespace View {
+        LazyTextDataObject::LazyTextDataObject(const Generator& generator) :
+        m_generator(generator),
+        m_generated(false) {}
+        
+        size_t LazyTextDataObject::GetTextLength() const {
+            generate();
+            return wxTextDataObject::GetTextLength();
+        }
+        
+        wxString LazyTextDataObject::GetText() const {
+            generate();
+            return wxTextDataObject::GetText();
+        }
+        
+        void LazyTextDataObject::SetText(const wxString& text) {
+            m_generated = true;
+            wxTextDataObject::SetText(text);
+        }
+
+        void LazyTextDataObject::generate() const {
+            if (!m_generated) {
+                LazyTextDataObject* self = const_cast<LazyTextDataObject*>(this);
+                self->SetText(wxString(m_generator()));
+            }
+        }
+    }
+}
@@ -0,0 +1,53 @@
+/*
+ Copyright (C) 2010-2016 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_LazyTextDataObject
+#define TrenchBroom_LazyTextDataObject
+
+#include "StringUtils.h"
+
+#include <wx/dataobj.h>
+
+#include <functional>
+
+namespace TrenchBroom {
+    namespace View {
+        /**
+         * A text data object that only generates its text when the text is actually requested, e.g. when the
+         * clipboard contents are pasted into another application.
+         */
+        class LazyTextDataObject : public wxTextDataObject {
+        public:
+            typedef std::function<String()> Generator;
+        private:
+            Generator m_generator;
+            mutable bool m_generated;
+        public:
+            LazyTextDataObject(const Generator& generator);
+            
+            size_t GetTextLength() const;
+            wxString GetText() const;
+            void SetText(const wxString& text);
+        private:
+            void generate() const;
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_LazyTextDataObject) */
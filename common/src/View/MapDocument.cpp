@@ -19,6 +19,7 @@
 
 #include "View/MapDocument.h"
 
+#include "ParallelUtils.h"
 #include "PreferenceManager.h"
 #include "Preferences.h"
 #include "Polyhedron.h"
@@ -26,6 +27,8 @@
 #include "Assets/EntityModelManager.h"
 #include "Assets/Texture.h"
 #include "Assets/TextureManager.h"
+#include "IO/BinaryNodeReader.h"
+#include "IO/BinaryNodeWriter.h"
 #include "IO/DiskFileSystem.h"
 #include "IO/SimpleParserStatus.h"
 #include "IO/SystemPaths.h"
@@ -73,6 +76,7 @@
 #include "Model/PointFile.h"
 #include "Model/World.h"
 #include "View/AddRemoveNodesCommand.h"
+#include "View/AssetPreloader.h"
 #include "View/ChangeBrushFaceAttributesCommand.h"
 #include "View/ChangeEntityAttributesCommand.h"
 #include "View/UpdateEntitySpawnflagCommand.h"
@@ -108,6 +112,7 @@
 #include "View/ViewEffectsService.h"
 
 #include <cassert>
+#include <chrono>
 
 namespace TrenchBroom {
     namespace View {
@@ -241,9 +246,11 @@ namespace TrenchBroom {
             info("Loading document from " + path.asString());
             
             clearDocument();
-            loadWorld(mapFormat, worldBounds, game, path);
             
-            loadAssets();
+            AssetPreloader preloader(game, path);
+            loadWorld(mapFormat, worldBounds, game, path, preloader);
+            
+            loadAssets(preloader);
             registerIssueGenerators();
             
             documentWasLoadedNotifier(this);
@@ -299,6 +306,46 @@ namespace TrenchBroom {
             return stream.str();
         }
         
+        String MapDocument::serializeSelectedNodesBinary() {
+            return IO::BinaryNodeWriter::writeNodes(m_world->format(), m_selectedNodes.nodes());
+        }
+        
+        String MapDocument::serializeSelectedBrushFacesBinary() {
+            return IO::BinaryNodeWriter::writeBrushFaces(m_world->format(), m_selectedBrushFaces);
+        }
+        
+        static String convertBinaryToText(Model::GamePtr game, const Model::MapFormat::Type format, const BBox3& worldBounds, const Model::EntityAttribute::List& worldAttributes, const String& data) {
+            // the document that copied the data may be gone, so we decode it into a world of our own
+            Model::World* world = game->newMap(format, worldBounds);
+            world->setAttributes(worldAttributes);
+            
+            StringStream stream;
+            try {
+                IO::SimpleParserStatus parserStatus(NULL);
+                const Model::NodeList nodes = IO::BinaryNodeReader::readNodes(data, world, worldBounds, parserStatus);
+                game->writeNodesToStream(world, nodes, stream);
+                VectorUtils::deleteAll(nodes);
+            } catch (const ParserException&) {
+                try {
+                    const Model::BrushFaceList faces = IO::BinaryNodeReader::readBrushFaces(data, world);
+                    game->writeBrushFacesToStream(world, faces, stream);
+                    VectorUtils::deleteAll(faces);
+                } catch (const ParserException&) {}
+            }
+            
+            delete world;
+            return stream.str();
+        }
+        
+        std::function<String()> MapDocument::binaryToTextConverter(const String& data) const {
+            const Model::GamePtr game = m_game;
+            const Model::MapFormat::Type format = m_world->format();
+            const BBox3 worldBounds = m_worldBounds;
+            const Model::EntityAttribute::List worldAttributes = m_world->attributes();
+            
+            return [=]() { return convertBinaryToText(game, format, worldBounds, worldAttributes, data); };
+        }
+        
         PasteType MapDocument::paste(const String& str) {
             try {
                 const Model::NodeList nodes = m_game->parseNodes(str, m_world, m_worldBounds, this);
@@ -316,6 +363,24 @@ namespace TrenchBroom {
             return PT_Failed;
         }
         
+        PasteType MapDocument::pasteBinary(const String& data) {
+            // the data may have been copied from a map with a different format, so the caller falls back to
+            // pasting text if this fails
+            try {
+                IO::SimpleParserStatus parserStatus(this);
+                const Model::NodeList nodes = IO::BinaryNodeReader::readNodes(data, m_world, m_worldBounds, parserStatus);
+                if (!nodes.empty() && pasteNodes(nodes))
+                    return PT_Node;
+            } catch (const ParserException&) {
+                try {
+                    const Model::BrushFaceList faces = IO::BinaryNodeReader::readBrushFaces(data, m_world);
+                    if (!faces.empty() && pasteBrushFaces(faces))
+                        return PT_BrushFace;
+                } catch (const ParserException&) {}
+            }
+            return PT_Failed;
+        }
+        
         bool MapDocument::pasteNodes(const Model::NodeList& nodes) {
             Model::MergeNodesIntoWorldVisitor mergeNodes(m_world, currentLayer());
             Model::Node::accept(std::begin(nodes), std::end(nodes), mergeNodes);
@@ -888,20 +953,22 @@ namespace TrenchBroom {
             if (!hasSelectedBrushFaces() && !selectedNodes().hasOnlyBrushes())
                 return false;
             
-            Polyhedron3 polyhedron;
+            Vec3::List points;
             
             if (hasSelectedBrushFaces()) {
                 for (const Model::BrushFace* face : selectedBrushFaces()) {
                     for (const Model::BrushVertex* vertex : face->vertices())
-                        polyhedron.addPoint(vertex->position());
+                        points.push_back(vertex->position());
                 }
             } else if (selectedNodes().hasOnlyBrushes()) {
                 for (const Model::Brush* brush : selectedNodes().brushes()) {
                     for (const Model::BrushVertex* vertex : brush->vertices())
-                        polyhedron.addPoint(vertex->position());
+                        points.push_back(vertex->position());
                 }
             }
             
+            const Polyhedron3 polyhedron(points);
+            
             if (!polyhedron.polyhedron() || !polyhedron.closed())
                 return false;
             
@@ -932,8 +999,21 @@ namespace TrenchBroom {
             Model::NodeList toRemove;
             toRemove.push_back(subtrahend);
             
-            for (Model::Brush* minuend : minuends) {
-                const Model::BrushList result = minuend->subtract(*m_world, m_worldBounds, currentTextureName(), subtrahend);
+            // Minuends that don't touch the subtrahend are left alone, the others are subtracted in parallel. Only the
+            // geometry is computed on the workers because creating faces binds textures, which must happen on this thread.
+            const BBox3& subtrahendBounds = subtrahend->bounds();
+            std::vector<Model::BrushGeometry::SubtractResult> results(minuends.size());
+            
+            ParallelUtils::parallelFor(minuends.size(), [&](const size_t i) {
+                const Model::Brush* minuend = minuends[i];
+                if (minuend->bounds().intersects(subtrahendBounds))
+                    results[i] = minuend->subtractGeometry(subtrahend);
+            });
+            
+            const String textureName = currentTextureName();
+            for (size_t i = 0; i < minuends.size(); ++i) {
+                Model::Brush* minuend = minuends[i];
+                const Model::BrushList result = minuend->createBrushes(*m_world, m_worldBounds, textureName, results[i], subtrahend);
                 if (!result.empty()) {
                     VectorUtils::append(toAdd[minuend->parent()], result);
                     toRemove.push_back(minuend);
@@ -986,16 +1066,23 @@ namespace TrenchBroom {
 
         bool MapDocument::clipBrushes(const Vec3& p1, const Vec3& p2, const Vec3& p3) {
             const Model::BrushList& brushes = m_selectedNodes.brushes();
-            Model::ParentChildrenMap clippedBrushes;
+            Model::BrushFace* clipFace = m_world->createFace(p1, p2, p3, Model::BrushFaceAttributes(currentTextureName()));
+            const Plane3 clipPlane = clipFace->boundary();
             
-            for (const Model::Brush* originalBrush : brushes) {
-                Model::BrushFace* clipFace = m_world->createFace(p1, p2, p3, Model::BrushFaceAttributes(currentTextureName()));
-                Model::Brush* clippedBrush = originalBrush->clone(m_worldBounds);
-                if (clippedBrush->clip(m_worldBounds, clipFace))
-                    clippedBrushes[originalBrush->parent()].push_back(clippedBrush);
-                else
-                    delete clippedBrush;
+            // only the geometry is clipped on the workers, the faces are created on this thread because they bind textures
+            std::vector<Model::BrushGeometry*> clippedGeometries(brushes.size(), NULL);
+            ParallelUtils::parallelFor(brushes.size(), [&](const size_t i) {
+                clippedGeometries[i] = brushes[i]->clipGeometry(clipPlane);
+            });
+            
+            Model::ParentChildrenMap clippedBrushes;
+            for (size_t i = 0; i < brushes.size(); ++i) {
+                if (clippedGeometries[i] != NULL) {
+                    Model::Brush* clippedBrush = brushes[i]->createClippedBrush(clippedGeometries[i], clipFace->clone());
+                    clippedBrushes[brushes[i]->parent()].push_back(clippedBrush);
+                }
             }
+            delete clipFace;
             
             Transaction transaction(this, "Clip Brushes");
             const Model::NodeList toRemove(std::begin(brushes), std::end(brushes));
@@ -1071,7 +1158,7 @@ namespace TrenchBroom {
             
             // try to find the texture if it is null, maybe it just wasn't set?
             if (attributes.texture() == NULL) {
-                Assets::Texture* texture = m_textureManager->texture(attributes.textureName());
+                Assets::Texture* texture = m_textureManager->texture(attributes.internedTextureName());
                 request.setTexture(texture);
             }
             
@@ -1243,13 +1330,29 @@ namespace TrenchBroom {
             setPath(DefaultDocumentName);
         }
         
-        void MapDocument::loadWorld(const Model::MapFormat::Type mapFormat, const BBox3& worldBounds, Model::GamePtr game, const IO::Path& path) {
+        typedef std::chrono::steady_clock Clock;
+        
+        static double millisecondsSince(const Clock::time_point& start) {
+            const std::chrono::duration<double, std::milli> time = Clock::now() - start;
+            return time.count();
+        }
+        
+        void MapDocument::loadWorld(const Model::MapFormat::Type mapFormat, const BBox3& worldBounds, Model::GamePtr game, const IO::Path& path, AssetPreloader& preloader) {
             m_worldBounds = worldBounds;
             m_game = game;
-            m_world = m_game->loadMap(mapFormat, m_worldBounds, path, this);
+            
+            // start reading the assets as soon as the worldspawn entity is known, the search paths must be set up
+            // first because the preloader reads from the game file system
+            const Clock::time_point start = Clock::now();
+            m_world = m_game->loadMap(mapFormat, m_worldBounds, path, this, [this, &path, &preloader](const Model::World* world) {
+                updateGameSearchPaths(m_game->extractEnabledMods(world));
+                preloader.start(world, externalSearchPaths(path));
+            });
+            info("Parsed map in %.0fms", millisecondsSince(start));
             setCurrentLayer(m_world->defaultLayer());
             
-            updateGameSearchPaths();
+            if (!preloader.started())
+                updateGameSearchPaths();
             setPath(path);
         }
         
@@ -1282,6 +1385,8 @@ namespace TrenchBroom {
         }
         
         IO::Path::List MapDocument::availableTextureCollections() const {
+            // the user may have added texture collections since the list was last shown
+            m_game->refreshFileSystem();
             return m_game->findTextureCollections();
         }
         
@@ -1297,6 +1402,22 @@ namespace TrenchBroom {
             setTextures();
         }
         
+        void MapDocument::loadAssets(AssetPreloader& preloader) {
+            if (!preloader.started()) {
+                loadAssets();
+                return;
+            }
+            
+            preloader.finishEntityDefinitions(*m_entityDefinitionManager, this);
+            setEntityDefinitions();
+            loadEntityModels();
+            preloader.finishTextureCollections(*m_textureManager, this);
+            
+            const Clock::time_point start = Clock::now();
+            setTextures();
+            info("Bound textures in %.0fms", millisecondsSince(start));
+        }
+        
         void MapDocument::unloadAssets() {
             unloadEntityDefinitions();
             unloadEntityModels();
@@ -1347,6 +1468,7 @@ namespace TrenchBroom {
         }
         
         void MapDocument::reloadTextures() {
+            m_game->refreshFileSystem();
             unsetTextures();
             loadTextures();
             setTextures();
@@ -1400,6 +1522,7 @@ namespace TrenchBroom {
         }
 
         void MapDocument::reloadEntityDefinitions() {
+            m_game->refreshFileSystem();
             unloadEntityDefinitions();
             clearEntityModels();
             loadEntityDefinitions();
@@ -1465,9 +1588,13 @@ namespace TrenchBroom {
         }
 
         IO::Path::List MapDocument::externalSearchPaths() const {
+            return externalSearchPaths(m_path);
+        }
+        
+        IO::Path::List MapDocument::externalSearchPaths(const IO::Path& documentPath) const {
             IO::Path::List searchPaths;
-            if (!m_path.isEmpty() && m_path.isAbsolute())
-                searchPaths.push_back(m_path.deleteLastComponent());
+            if (!documentPath.isEmpty() && documentPath.isAbsolute())
+                searchPaths.push_back(documentPath.deleteLastComponent());
             
             const IO::Path gamePath = m_game->gamePath();
             if (!gamePath.isEmpty())
@@ -1478,7 +1605,10 @@ namespace TrenchBroom {
         }
         
         void MapDocument::updateGameSearchPaths() {
-            const StringList modNames = mods();
+            updateGameSearchPaths(mods());
+        }
+        
+        void MapDocument::updateGameSearchPaths(const StringList& modNames) {
             IO::Path::List additionalSearchPaths;
             additionalSearchPaths.reserve(modNames.size());
             
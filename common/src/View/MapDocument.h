@@ -35,6 +35,8 @@
 #include "View/UndoableCommand.h"
 #include "View/ViewTypes.h"
 
+#include <functional>
+
 class Color;
 namespace TrenchBroom {
     namespace Assets {
@@ -53,6 +55,7 @@ namespace TrenchBroom {
     }
     
     namespace View {
+        class AssetPreloader;
         class Command;
         class Grid;
         class MapViewConfig;
@@ -180,7 +183,22 @@ namespace TrenchBroom {
             String serializeSelectedNodes();
             String serializeSelectedBrushFaces();
             
+            /**
+             * Binary counterparts of the methods above, used for copying and pasting within the editor. The
+             * binary data can be converted to text when another application asks for the clipboard contents.
+             */
+            String serializeSelectedNodesBinary();
+            String serializeSelectedBrushFacesBinary();
+            
+            /**
+             * Returns a function that converts the given binary data to map text. It captures the game, map format,
+             * world bounds and worldspawn attributes of this document as they are now, so it keeps working after the
+             * document has been closed or its map format has changed.
+             */
+            std::function<String()> binaryToTextConverter(const String& data) const;
+            
             PasteType paste(const String& str);
+            PasteType pasteBinary(const String& data);
         private:
             bool pasteNodes(const Model::NodeList& nodes);
             bool pasteBrushFaces(const Model::BrushFaceList& faces);
@@ -360,7 +378,7 @@ namespace TrenchBroom {
             Model::NodeList findNodesContaining(const Vec3& point) const;
         private: // world management
             void createWorld(Model::MapFormat::Type mapFormat, const BBox3& worldBounds, Model::GamePtr game);
-            void loadWorld(Model::MapFormat::Type mapFormat, const BBox3& worldBounds, Model::GamePtr game, const IO::Path& path);
+            void loadWorld(Model::MapFormat::Type mapFormat, const BBox3& worldBounds, Model::GamePtr game, const IO::Path& path, AssetPreloader& preloader);
             void clearWorld();
             void initializeWorld(const BBox3& worldBounds);
         public: // asset management
@@ -373,6 +391,7 @@ namespace TrenchBroom {
             void setEnabledTextureCollections(const IO::Path::List& paths);
         private:
             void loadAssets();
+            void loadAssets(AssetPreloader& preloader);
             void unloadAssets();
             
             void loadEntityDefinitions();
@@ -401,7 +420,9 @@ namespace TrenchBroom {
             void unsetTextures(const Model::NodeList& nodes);
         protected: // search paths and mods
             IO::Path::List externalSearchPaths() const;
+            IO::Path::List externalSearchPaths(const IO::Path& documentPath) const;
             void updateGameSearchPaths();
+            void updateGameSearchPaths(const StringList& modNames);
         public:
             StringList mods() const;
             void setMods(const StringList& mods);
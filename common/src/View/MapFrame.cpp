@@ -30,6 +30,7 @@
 #include "Model/PointFile.h"
 #include "View/ActionManager.h"
 #include "View/Autosaver.h"
+#include "View/BinaryNodeDataObject.h"
 #include "View/BorderLine.h"
 #include "View/CachingLogger.h"
 #include "View/ClipTool.h"
@@ -42,6 +43,7 @@
 #include "View/InfoPanel.h"
 #include "View/Inspector.h"
 #include "View/LaunchGameEngineDialog.h"
+#include "View/LazyTextDataObject.h"
 #include "View/MapDocument.h"
 #include "View/MapFrameDropTarget.h"
 #include "View/Menu.h"
@@ -681,12 +683,17 @@ namespace TrenchBroom {
         void MapFrame::copyToClipboard() {
             OpenClipboard openClipboard;
             if (wxTheClipboard->IsOpened()) {
-                String str;
+                String data;
                 if (m_document->hasSelectedNodes())
-                    str = m_document->serializeSelectedNodes();
+                    data = m_document->serializeSelectedNodesBinary();
                 else if (m_document->hasSelectedBrushFaces())
-                    str = m_document->serializeSelectedBrushFaces();
-                wxTheClipboard->SetData(new wxTextDataObject(str));
+                    data = m_document->serializeSelectedBrushFacesBinary();
+                
+                // other applications only see text, which is generated when they ask for it
+                wxDataObjectComposite* dataObject = new wxDataObjectComposite();
+                dataObject->Add(new BinaryNodeDataObject(data), true);
+                dataObject->Add(new LazyTextDataObject(m_document->binaryToTextConverter(data)));
+                wxTheClipboard->SetData(dataObject);
             }
         }
 
@@ -713,6 +720,15 @@ namespace TrenchBroom {
 
         PasteType MapFrame::paste() {
             OpenClipboard openClipboard;
+            if (wxTheClipboard->IsOpened() && wxTheClipboard->IsSupported(BinaryNodeDataObject::format())) {
+                BinaryNodeDataObject binaryData;
+                if (wxTheClipboard->GetData(binaryData)) {
+                    const PasteType result = m_document->pasteBinary(binaryData.data());
+                    if (result != PT_Failed)
+                        return result;
+                }
+            }
+            
             if (!wxTheClipboard->IsOpened() || !wxTheClipboard->IsSupported(wxDF_TEXT)) {
                 logger()->error("Clipboard is empty");
                 return PT_Failed;
@@ -1452,7 +1468,7 @@ namespace TrenchBroom {
                 return false;
             
             OpenClipboard openClipboard;
-            return wxTheClipboard->IsOpened() && wxTheClipboard->IsSupported(wxDF_TEXT);
+            return wxTheClipboard->IsOpened() && (wxTheClipboard->IsSupported(BinaryNodeDataObject::format()) || wxTheClipboard->IsSupported(wxDF_TEXT));
         }
 
         bool MapFrame::canDelete() const {
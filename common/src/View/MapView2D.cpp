@@ -323,7 +323,7 @@ namespace TrenchBroom {
         
         void MapView2D::doRenderGrid(Renderer::RenderContext& renderContext, Renderer::RenderBatch& renderBatch) {
             MapDocumentSPtr document = lock(m_document);
-            renderBatch.addOneShot(new Renderer::GridRenderer(m_camera, document->worldBounds()));
+            renderBatch.addStreamed(new Renderer::GridRenderer(m_camera, document->worldBounds()));
         }
 
         void MapView2D::doRenderMap(Renderer::MapRenderer& renderer, Renderer::RenderContext& renderContext, Renderer::RenderBatch& renderBatch) {
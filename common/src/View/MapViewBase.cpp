@@ -860,7 +860,7 @@ namespace TrenchBroom {
             setupGL(renderContext);
             setRenderOptions(renderContext);
 
-            Renderer::RenderBatch renderBatch(vertexVbo(), indexVbo());
+            Renderer::RenderBatch renderBatch(vertexVbo(), indexVbo(), streamVbo());
 
             doRenderGrid(renderContext, renderBatch);
             doRenderMap(m_renderer, renderContext, renderBatch);
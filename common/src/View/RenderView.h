@@ -55,6 +55,7 @@ namespace TrenchBroom {
         protected:
             Renderer::Vbo& vertexVbo();
             Renderer::Vbo& indexVbo();
+            Renderer::Vbo& streamVbo();
             Renderer::FontManager& fontManager();
             Renderer::ShaderManager& shaderManager();
             
@@ -158,7 +158,7 @@ namespace TrenchBroom {
                 const Vec3 startAxis = (m_start - m_center).normalized();
                 const Vec3 endAxis = Quat3(m_axis, m_angle) * startAxis;
                 
-                renderBatch.addOneShot(new AngleIndicatorRenderer(m_center, handleRadius, m_axis.firstComponent(), startAxis, endAxis));
+                renderBatch.addStreamed(new AngleIndicatorRenderer(m_center, handleRadius, m_axis.firstComponent(), startAxis, endAxis));
             }
             
             void renderAngleText(Renderer::RenderContext& renderContext, Renderer::RenderBatch& renderBatch) {
@@ -215,19 +215,19 @@ namespace TrenchBroom {
         }
 
         void TextureBrowser::nodesWereAdded(const Model::NodeList& nodes) {
-            reload();
+            refresh();
         }
         
         void TextureBrowser::nodesWereRemoved(const Model::NodeList& nodes) {
-            reload();
+            refresh();
         }
         
         void TextureBrowser::nodesDidChange(const Model::NodeList& nodes) {
-            reload();
+            refresh();
         }
         
         void TextureBrowser::brushFacesDidChange(const Model::BrushFaceList& faces) {
-            reload();
+            refresh();
         }
 
         void TextureBrowser::textureCollectionsDidChange() {
@@ -255,6 +255,14 @@ namespace TrenchBroom {
             }
         }
 
+        void TextureBrowser::refresh() {
+            // changes to the usage counts are handled by the view itself
+            if (m_view != NULL) {
+                updateSelectedTexture();
+                m_view->Refresh();
+            }
+        }
+
         void TextureBrowser::updateSelectedTexture() {
             MapDocumentSPtr document = lock(m_document);
             const String& textureName = document->currentTextureName();
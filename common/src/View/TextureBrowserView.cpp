@@ -37,6 +37,14 @@ namespace TrenchBroom {
         texture(i_texture),
         fontDescriptor(i_fontDescriptor) {}
 
+        TextureBrowserView::TextureInfo::TextureInfo(const String& i_name, const String& i_key, const bool i_matchesFilter, const Renderer::FontDescriptor& i_font) :
+        name(i_name),
+        key(i_key),
+        matchesFilter(i_matchesFilter),
+        measured(false),
+        font(i_font),
+        titleWidth(0.0f) {}
+
         TextureBrowserView::TextureBrowserView(wxWindow* parent,
                                                wxScrollBar* scrollBar,
                                                GLContextManager& contextManager,
@@ -46,7 +54,9 @@ namespace TrenchBroom {
         m_group(false),
         m_hideUnused(false),
         m_sortOrder(SO_Name),
-        m_selectedTexture(NULL) {
+        m_selectedTexture(NULL),
+        m_measuredFontSize(0),
+        m_measuredCellWidth(0.0f) {
             m_textureManager.usageCountDidChange.addObserver(this, &TextureBrowserView::usageCountDidChange);
         }
         
@@ -99,7 +109,10 @@ namespace TrenchBroom {
         }
 
         void TextureBrowserView::usageCountDidChange() {
-            invalidate();
+            // The cell colors are taken from the usage counts when rendering, so the layout only needs to be
+            // rebuilt if the usage counts determine the order or visibility of the textures.
+            if (m_sortOrder == SO_Usage || m_hideUnused)
+                invalidate();
             Refresh();
         }
 
@@ -121,6 +134,7 @@ namespace TrenchBroom {
             assert(fontSize > 0);
             
             const Renderer::FontDescriptor font(fontPath, static_cast<size_t>(fontSize));
+            updateTextureInfos(font, layout.maxCellWidth());
             
             if (m_group) {
                 for (const Assets::TextureCollection* collection : getCollections()) {
@@ -135,20 +149,76 @@ namespace TrenchBroom {
         }
         
         void TextureBrowserView::addTextureToLayout(Layout& layout, Assets::Texture* texture, const Renderer::FontDescriptor& font) {
-            const float maxCellWidth = layout.maxCellWidth();
-            const Renderer::FontDescriptor actualFont = fontManager().selectFontSize(font, texture->name(), maxCellWidth, 5);
-            const Vec2f actualSize = fontManager().font(actualFont).measure(texture->name());
+            TextureInfo& info = textureInfo(texture);
+            if (!info.measured) {
+                info.font = fontManager().selectFontSize(font, texture->name(), layout.maxCellWidth(), 5);
+                info.titleWidth = fontManager().font(info.font).measure(texture->name()).x();
+                info.measured = true;
+            }
             
             const float scaleFactor = pref(Preferences::TextureBrowserIconSize);
             const size_t scaledTextureWidth = static_cast<size_t>(Math::round(scaleFactor * static_cast<float>(texture->width())));
             const size_t scaledTextureHeight = static_cast<size_t>(Math::round(scaleFactor * static_cast<float>(texture->height())));
             
-            layout.addItem(TextureCellData(texture, actualFont),
+            layout.addItem(TextureCellData(texture, info.font),
                            scaledTextureWidth,
                            scaledTextureHeight,
-                           actualSize.x(),
+                           info.titleWidth,
                            font.size() + 2.0f);
         }
+        
+        void TextureBrowserView::updateTextureInfos(const Renderer::FontDescriptor& font, const float maxCellWidth) {
+            const Assets::TextureList& textures = m_textureManager.textures();
+            if (m_textureInfos.size() > textures.size()) {
+                // drop the infos of textures that were unloaded
+                TextureInfoMap infos;
+                for (const Assets::Texture* texture : textures) {
+                    TextureInfoMap::iterator it = m_textureInfos.find(texture);
+                    if (it != std::end(m_textureInfos))
+                        infos.insert(*it);
+                }
+                using std::swap;
+                swap(infos, m_textureInfos);
+            }
+            
+            if (font.path() != m_measuredFontPath || font.size() != m_measuredFontSize || maxCellWidth != m_measuredCellWidth) {
+                for (auto& entry : m_textureInfos)
+                    entry.second.measured = false;
+                m_measuredFontPath = font.path();
+                m_measuredFontSize = font.size();
+                m_measuredCellWidth = maxCellWidth;
+            }
+            
+            const String filterText = StringUtils::toLower(m_filterText);
+            if (filterText != m_indexedFilterText) {
+                // If the new filter contains the previous one, only the previous matches can still match.
+                const bool narrowed = filterText.find(m_indexedFilterText) != String::npos;
+                for (auto& entry : m_textureInfos) {
+                    TextureInfo& info = entry.second;
+                    if (info.matchesFilter || !narrowed)
+                        info.matchesFilter = info.key.find(filterText) != String::npos;
+                }
+                m_indexedFilterText = filterText;
+            }
+        }
+        
+        TextureBrowserView::TextureInfo& TextureBrowserView::textureInfo(const Assets::Texture* texture) {
+            TextureInfoMap::iterator it = m_textureInfos.lower_bound(texture);
+            if (it == std::end(m_textureInfos) || it->first != texture) {
+                const String key = StringUtils::toLower(texture->name());
+                const bool matchesFilter = key.find(m_indexedFilterText) != String::npos;
+                const Renderer::FontDescriptor font(m_measuredFontPath, m_measuredFontSize);
+                it = m_textureInfos.insert(it, std::make_pair(texture, TextureInfo(texture->name(), key, matchesFilter, font)));
+            } else if (it->second.name != texture->name()) {
+                // the texture was replaced by another one at the same address
+                TextureInfo& info = it->second;
+                info.name = texture->name();
+                info.key = StringUtils::toLower(info.name);
+                info.matchesFilter = info.key.find(m_indexedFilterText) != String::npos;
+                info.measured = false;
+            }
+            return it->second;
+        }
 
         struct TextureBrowserView::CompareByUsageCount {
             StringUtils::CaseInsensitiveStringLess m_less;
@@ -162,14 +232,20 @@ namespace TrenchBroom {
                 
                 return m_less(lhs->name(), rhs->name());
             }
+            
+            bool operator()(const SortEntry& lhs, const SortEntry& rhs) const {
+                if (lhs.second->usageCount() > rhs.second->usageCount())
+                    return true;
+                if (lhs.second->usageCount() < rhs.second->usageCount())
+                    return false;
+                
+                return *lhs.first < *rhs.first;
+            }
         };
         
         struct TextureBrowserView::CompareByName {
-            StringUtils::CaseInsensitiveStringLess m_less;
-            
-            template <typename T>
-            bool operator()(const T* lhs, const T* rhs) const {
-                return m_less(lhs->name(), rhs->name());
+            bool operator()(const SortEntry& lhs, const SortEntry& rhs) const {
+                return *lhs.first < *rhs.first;
             }
         };
 
@@ -180,16 +256,6 @@ namespace TrenchBroom {
             }
         };
         
-        struct TextureBrowserView::MatchName {
-            String pattern;
-            
-            MatchName(const String& i_pattern) : pattern(i_pattern) {}
-            
-            bool operator()(const Assets::Texture* texture) const {
-                return !StringUtils::containsCaseInsensitive(texture->name(), pattern);
-            }
-        };
-
         Assets::TextureCollectionList TextureBrowserView::getCollections() const {
             Assets::TextureCollectionList collections = m_textureManager.collections();
             if (m_hideUnused)
@@ -199,36 +265,45 @@ namespace TrenchBroom {
             return collections;
         }
         
-        Assets::TextureList TextureBrowserView::getTextures(const Assets::TextureCollection* collection) const {
+        Assets::TextureList TextureBrowserView::getTextures(const Assets::TextureCollection* collection) {
             Assets::TextureList textures = collection->textures();
             filterTextures(textures);
             sortTextures(textures);
             return textures;
         }
         
-        Assets::TextureList TextureBrowserView::getTextures() const {
+        Assets::TextureList TextureBrowserView::getTextures() {
             Assets::TextureList textures = m_textureManager.textures();
             filterTextures(textures);
             sortTextures(textures);
             return textures;
         }
 
-        void TextureBrowserView::filterTextures(Assets::TextureList& textures) const {
+        void TextureBrowserView::filterTextures(Assets::TextureList& textures) {
             if (m_hideUnused)
                 VectorUtils::eraseIf(textures, MatchUsageCount());
-            if (!m_filterText.empty())
-                VectorUtils::eraseIf(textures, MatchName(m_filterText));
+            if (!m_indexedFilterText.empty())
+                VectorUtils::eraseIf(textures, [this](const Assets::Texture* texture) { return !textureInfo(texture).matchesFilter; });
         }
         
-        void TextureBrowserView::sortTextures(Assets::TextureList& textures) const {
+        void TextureBrowserView::sortTextures(Assets::TextureList& textures) {
+            // sort by the cached lower case names instead of comparing the names case insensitively
+            std::vector<SortEntry> entries;
+            entries.reserve(textures.size());
+            for (Assets::Texture* texture : textures)
+                entries.push_back(SortEntry(&textureInfo(texture).key, texture));
+            
             switch (m_sortOrder) {
                 case SO_Name:
-                    VectorUtils::sort(textures, CompareByName());
+                    VectorUtils::sort(entries, CompareByName());
                     break;
                 case SO_Usage:
-                    VectorUtils::sort(textures, CompareByUsageCount());
+                    VectorUtils::sort(entries, CompareByUsageCount());
                     break;
             }
+            
+            for (size_t i = 0; i < entries.size(); ++i)
+                textures[i] = entries[i].second;
         }
 
         void TextureBrowserView::doClear() {}
@@ -263,23 +338,23 @@ namespace TrenchBroom {
             typedef Renderer::VertexSpecs::P2C4::Vertex BoundsVertex;
             BoundsVertex::List vertices;
             
-            for (size_t i = 0; i < layout.size(); ++i) {
+            for (size_t i = layout.indexOfGroupAt(y); i < layout.size(); ++i) {
                 const Layout::Group& group = layout[i];
-                if (group.intersectsY(y, height)) {
-                    for (size_t j = 0; j < group.size(); ++j) {
-                        const Layout::Group::Row& row = group[j];
-                        if (row.intersectsY(y, height)) {
-                            for (size_t k = 0; k < row.size(); ++k) {
-                                const Layout::Group::Row::Cell& cell = row[k];
-                                const LayoutBounds& bounds = cell.itemBounds();
-                                const Assets::Texture* texture = cell.item().texture;
-                                const Color& color = textureColor(*texture);
-                                vertices.push_back(BoundsVertex(Vec2f(bounds.left() - 2.0f, height - (bounds.top() - 2.0f - y)), color));
-                                vertices.push_back(BoundsVertex(Vec2f(bounds.left() - 2.0f, height - (bounds.bottom() + 2.0f - y)), color));
-                                vertices.push_back(BoundsVertex(Vec2f(bounds.right() + 2.0f, height - (bounds.bottom() + 2.0f - y)), color));
-                                vertices.push_back(BoundsVertex(Vec2f(bounds.right() + 2.0f, height - (bounds.top() - 2.0f - y)), color));
-                            }
-                        }
+                if (!group.intersectsY(y, height))
+                    break;
+                for (size_t j = group.indexOfRowAt(y); j < group.size(); ++j) {
+                    const Layout::Group::Row& row = group[j];
+                    if (!row.intersectsY(y, height))
+                        break;
+                    for (size_t k = 0; k < row.size(); ++k) {
+                        const Layout::Group::Row::Cell& cell = row[k];
+                        const LayoutBounds& bounds = cell.itemBounds();
+                        const Assets::Texture* texture = cell.item().texture;
+                        const Color& color = textureColor(*texture);
+                        vertices.push_back(BoundsVertex(Vec2f(bounds.left() - 2.0f, height - (bounds.top() - 2.0f - y)), color));
+                        vertices.push_back(BoundsVertex(Vec2f(bounds.left() - 2.0f, height - (bounds.bottom() + 2.0f - y)), color));
+                        vertices.push_back(BoundsVertex(Vec2f(bounds.right() + 2.0f, height - (bounds.bottom() + 2.0f - y)), color));
+                        vertices.push_back(BoundsVertex(Vec2f(bounds.right() + 2.0f, height - (bounds.top() - 2.0f - y)), color));
                     }
                 }
             }
@@ -302,47 +377,97 @@ namespace TrenchBroom {
 
         void TextureBrowserView::renderTextures(Layout& layout, const float y, const float height) {
             typedef Renderer::VertexSpecs::P2T2::Vertex TextureVertex;
-            TextureVertex::List vertices(4);
-
-            Renderer::ActiveShader shader(shaderManager(), Renderer::Shaders::TextureBrowserShader);
-            shader.set("ApplyTinting", false);
-            shader.set("Texture", 0);
-            shader.set("Brightness", pref(Preferences::Brightness));
             
-            size_t num = 0;
+            // Cells that can show a thumbnail are batched by atlas page and gray scale mode, all other cells are
+            // rendered one by one using the full texture.
+            typedef std::pair<const Renderer::TextureAtlas*, size_t> AtlasPage;
+            typedef std::pair<AtlasPage, bool> BatchKey;
+            typedef std::map<BatchKey, TextureVertex::List> BatchMap;
+            typedef std::vector<const Layout::Group::Row::Cell*> CellList;
             
-            Renderer::ActivateVbo activate(vertexVbo());
-
-            for (size_t i = 0; i < layout.size(); ++i) {
+            BatchMap batches;
+            CellList singleCells;
+            
+            for (size_t i = layout.indexOfGroupAt(y); i < layout.size(); ++i) {
                 const Layout::Group& group = layout[i];
-                if (group.intersectsY(y, height)) {
-                    for (size_t j = 0; j < group.size(); ++j) {
-                        const Layout::Group::Row& row = group[j];
-                        if (row.intersectsY(y, height)) {
-                            for (size_t k = 0; k < row.size(); ++k) {
-                                const Layout::Group::Row::Cell& cell = row[k];
-                                const LayoutBounds& bounds = cell.itemBounds();
-                                const Assets::Texture* texture = cell.item().texture;
-                                
-                                vertices[0] = TextureVertex(Vec2f(bounds.left(),  height - (bounds.top() - y)),    Vec2f(0.0f, 0.0f));
-                                vertices[1] = TextureVertex(Vec2f(bounds.left(),  height - (bounds.bottom() - y)), Vec2f(0.0f, 1.0f));
-                                vertices[2] = TextureVertex(Vec2f(bounds.right(), height - (bounds.bottom() - y)), Vec2f(1.0f, 1.0f));
-                                vertices[3] = TextureVertex(Vec2f(bounds.right(), height - (bounds.top() - y)),    Vec2f(1.0f, 0.0f));
-
-                                Renderer::VertexArray vertexArray = Renderer::VertexArray::copy(vertices);
-
-                                shader.set("GrayScale", texture->overridden());
-                                texture->activate();
-
-                                vertexArray.prepare(vertexVbo());
-                                vertexArray.render(GL_QUADS);
-                                
-                                ++num;
-                            }
+                if (!group.intersectsY(y, height))
+                    break;
+                for (size_t j = group.indexOfRowAt(y); j < group.size(); ++j) {
+                    const Layout::Group::Row& row = group[j];
+                    if (!row.intersectsY(y, height))
+                        break;
+                    for (size_t k = 0; k < row.size(); ++k) {
+                        const Layout::Group::Row::Cell& cell = row[k];
+                        const LayoutBounds& bounds = cell.itemBounds();
+                        const Assets::Texture* texture = cell.item().texture;
+                        
+                        if (useThumbnail(*texture, bounds)) {
+                            const Renderer::TextureAtlas::Slot& slot = texture->thumbnailSlot();
+                            const Vec2f& min = slot.texCoordsMin;
+                            const Vec2f& max = slot.texCoordsMax;
+                            
+                            TextureVertex::List& vertices = batches[BatchKey(AtlasPage(texture->thumbnailAtlas(), slot.page), texture->overridden())];
+                            vertices.push_back(TextureVertex(Vec2f(bounds.left(),  height - (bounds.top() - y)),    Vec2f(min.x(), min.y())));
+                            vertices.push_back(TextureVertex(Vec2f(bounds.left(),  height - (bounds.bottom() - y)), Vec2f(min.x(), max.y())));
+                            vertices.push_back(TextureVertex(Vec2f(bounds.right(), height - (bounds.bottom() - y)), Vec2f(max.x(), max.y())));
+                            vertices.push_back(TextureVertex(Vec2f(bounds.right(), height - (bounds.top() - y)),    Vec2f(max.x(), min.y())));
+                        } else {
+                            singleCells.push_back(&cell);
                         }
                     }
                 }
             }
+            
+            Renderer::ActiveShader shader(shaderManager(), Renderer::Shaders::TextureBrowserShader);
+            shader.set("ApplyTinting", false);
+            shader.set("Texture", 0);
+            shader.set("Brightness", pref(Preferences::Brightness));
+            
+            Renderer::ActivateVbo activate(vertexVbo());
+            
+            for (auto& entry : batches) {
+                const AtlasPage& page = entry.first.first;
+                const bool grayScale = entry.first.second;
+                Renderer::VertexArray vertexArray = Renderer::VertexArray::swap(entry.second);
+                
+                shader.set("GrayScale", grayScale);
+                page.first->activate(page.second);
+                
+                vertexArray.prepare(vertexVbo());
+                vertexArray.render(GL_QUADS);
+                
+                page.first->deactivate();
+            }
+            
+            TextureVertex::List vertices(4);
+            for (const Layout::Group::Row::Cell* cell : singleCells) {
+                const LayoutBounds& bounds = cell->itemBounds();
+                const Assets::Texture* texture = cell->item().texture;
+                
+                vertices[0] = TextureVertex(Vec2f(bounds.left(),  height - (bounds.top() - y)),    Vec2f(0.0f, 0.0f));
+                vertices[1] = TextureVertex(Vec2f(bounds.left(),  height - (bounds.bottom() - y)), Vec2f(0.0f, 1.0f));
+                vertices[2] = TextureVertex(Vec2f(bounds.right(), height - (bounds.bottom() - y)), Vec2f(1.0f, 1.0f));
+                vertices[3] = TextureVertex(Vec2f(bounds.right(), height - (bounds.top() - y)),    Vec2f(1.0f, 0.0f));
+                
+                Renderer::VertexArray vertexArray = Renderer::VertexArray::copy(vertices);
+                
+                shader.set("GrayScale", texture->overridden());
+                texture->activate();
+                
+                vertexArray.prepare(vertexVbo());
+                vertexArray.render(GL_QUADS);
+            }
+        }
+        
+        bool TextureBrowserView::useThumbnail(const Assets::Texture& texture, const LayoutBounds& bounds) const {
+            if (!texture.hasThumbnail())
+                return false;
+            
+            // the thumbnail is good enough if it is not downsampled or if it is not magnified in the cell
+            const Renderer::TextureAtlas::Slot& slot = texture.thumbnailSlot();
+            if (slot.width == texture.width() && slot.height == texture.height())
+                return true;
+            return static_cast<float>(slot.width) >= bounds.width() && static_cast<float>(slot.height) >= bounds.height();
         }
         
         void TextureBrowserView::renderNames(Layout& layout, const float y, const float height) {
@@ -354,15 +479,15 @@ namespace TrenchBroom {
             typedef Renderer::VertexSpecs::P2::Vertex Vertex;
             Vertex::List vertices;
             
-            for (size_t i = 0; i < layout.size(); ++i) {
+            for (size_t i = layout.indexOfGroupAt(y); i < layout.size(); ++i) {
                 const Layout::Group& group = layout[i];
-                if (group.intersectsY(y, height)) {
-                    const LayoutBounds titleBounds = layout.titleBoundsForVisibleRect(group, y, height);
-                    vertices.push_back(Vertex(Vec2f(titleBounds.left(), height - (titleBounds.top() - y))));
-                    vertices.push_back(Vertex(Vec2f(titleBounds.left(), height - (titleBounds.bottom() - y))));
-                    vertices.push_back(Vertex(Vec2f(titleBounds.right(), height - (titleBounds.bottom() - y))));
-                    vertices.push_back(Vertex(Vec2f(titleBounds.right(), height - (titleBounds.top() - y))));
-                }
+                if (!group.intersectsY(y, height))
+                    break;
+                const LayoutBounds titleBounds = layout.titleBoundsForVisibleRect(group, y, height);
+                vertices.push_back(Vertex(Vec2f(titleBounds.left(), height - (titleBounds.top() - y))));
+                vertices.push_back(Vertex(Vec2f(titleBounds.left(), height - (titleBounds.bottom() - y))));
+                vertices.push_back(Vertex(Vec2f(titleBounds.right(), height - (titleBounds.bottom() - y))));
+                vertices.push_back(Vertex(Vec2f(titleBounds.right(), height - (titleBounds.top() - y))));
             }
             
             Renderer::ActiveShader shader(shaderManager(), Renderer::Shaders::VaryingPUniformCShader);
@@ -409,36 +534,36 @@ namespace TrenchBroom {
             const Color::List textColor(1, pref(Preferences::BrowserTextColor));
 
             StringMap stringVertices;
-            for (size_t i = 0; i < layout.size(); ++i) {
+            for (size_t i = layout.indexOfGroupAt(y); i < layout.size(); ++i) {
                 const Layout::Group& group = layout[i];
-                if (group.intersectsY(y, height)) {
-                    const String& title = group.item();
-                    if (!title.empty()) {
-                        const LayoutBounds titleBounds = layout.titleBoundsForVisibleRect(group, y, height);
-                        const Vec2f offset(titleBounds.left() + 2.0f, height - (titleBounds.top() - y) - titleBounds.height());
+                if (!group.intersectsY(y, height))
+                    break;
+                const String& title = group.item();
+                if (!title.empty()) {
+                    const LayoutBounds titleBounds = layout.titleBoundsForVisibleRect(group, y, height);
+                    const Vec2f offset(titleBounds.left() + 2.0f, height - (titleBounds.top() - y) - titleBounds.height());
                         
-                        Renderer::TextureFont& font = fontManager().font(defaultDescriptor);
-                        const Vec2f::List quads = font.quads(title, false, offset);
-                        const TextVertex::List titleVertices = TextVertex::fromLists(quads, quads, textColor, quads.size() / 2, 0, 2, 1, 2, 0, 0);
-                        TextVertex::List& vertices = stringVertices[defaultDescriptor];
-                        vertices.insert(std::end(vertices), std::begin(titleVertices), std::end(titleVertices));
-                    }
+                    Renderer::TextureFont& font = fontManager().font(defaultDescriptor);
+                    const Vec2f::List quads = font.quads(title, false, offset);
+                    const TextVertex::List titleVertices = TextVertex::fromLists(quads, quads, textColor, quads.size() / 2, 0, 2, 1, 2, 0, 0);
+                    TextVertex::List& vertices = stringVertices[defaultDescriptor];
+                    vertices.insert(std::end(vertices), std::begin(titleVertices), std::end(titleVertices));
+                }
                     
-                    for (size_t j = 0; j < group.size(); ++j) {
-                        const Layout::Group::Row& row = group[j];
-                        if (row.intersectsY(y, height)) {
-                            for (unsigned int k = 0; k < row.size(); k++) {
-                                const Layout::Group::Row::Cell& cell = row[k];
-                                const LayoutBounds titleBounds = cell.titleBounds();
-                                const Vec2f offset(titleBounds.left(), height - (titleBounds.top() - y) - titleBounds.height());
+                for (size_t j = group.indexOfRowAt(y); j < group.size(); ++j) {
+                    const Layout::Group::Row& row = group[j];
+                    if (!row.intersectsY(y, height))
+                        break;
+                    for (unsigned int k = 0; k < row.size(); k++) {
+                        const Layout::Group::Row::Cell& cell = row[k];
+                        const LayoutBounds titleBounds = cell.titleBounds();
+                        const Vec2f offset(titleBounds.left(), height - (titleBounds.top() - y) - titleBounds.height());
                                 
-                                Renderer::TextureFont& font = fontManager().font(cell.item().fontDescriptor);
-                                const Vec2f::List quads = font.quads(cell.item().texture->name(), false, offset);
-                                const TextVertex::List titleVertices = TextVertex::fromLists(quads, quads, textColor, quads.size() / 2, 0, 2, 1, 2, 0, 0);
-                                TextVertex::List& vertices = stringVertices[cell.item().fontDescriptor];
-                                vertices.insert(std::end(vertices), std::begin(titleVertices), std::end(titleVertices));
-                            }
-                        }
+                        Renderer::TextureFont& font = fontManager().font(cell.item().fontDescriptor);
+                        const Vec2f::List quads = font.quads(cell.item().texture->name(), false, offset);
+                        const TextVertex::List titleVertices = TextVertex::fromLists(quads, quads, textColor, quads.size() / 2, 0, 2, 1, 2, 0, 0);
+                        TextVertex::List& vertices = stringVertices[cell.item().fontDescriptor];
+                        vertices.insert(std::end(vertices), std::begin(titleVertices), std::end(titleVertices));
                     }
                 }
             }
@@ -60,6 +60,23 @@ namespace TrenchBroom {
             typedef Renderer::VertexSpecs::P2T2C4::Vertex TextVertex;
             typedef std::map<Renderer::FontDescriptor, TextVertex::List> StringMap;
 
+            /**
+             * Per texture data that survives layout reloads: the lower case name used for filtering and
+             * sorting, whether the texture matches the current filter, and the measured title.
+             */
+            struct TextureInfo {
+                String name;
+                String key;
+                bool matchesFilter;
+                bool measured;
+                Renderer::FontDescriptor font;
+                float titleWidth;
+                
+                TextureInfo(const String& i_name, const String& i_key, bool i_matchesFilter, const Renderer::FontDescriptor& i_font);
+            };
+            typedef std::map<const Assets::Texture*, TextureInfo> TextureInfoMap;
+            typedef std::pair<const String*, Assets::Texture*> SortEntry;
+
             Assets::TextureManager& m_textureManager;
 
             bool m_group;
@@ -68,6 +85,12 @@ namespace TrenchBroom {
             String m_filterText;
             
             Assets::Texture* m_selectedTexture;
+            
+            TextureInfoMap m_textureInfos;
+            String m_indexedFilterText;
+            IO::Path m_measuredFontPath;
+            size_t m_measuredFontSize;
+            float m_measuredCellWidth;
         public:
             TextureBrowserView(wxWindow* parent,
                                wxScrollBar* scrollBar,
@@ -89,17 +112,19 @@ namespace TrenchBroom {
             void doReloadLayout(Layout& layout);
             void addTextureToLayout(Layout& layout, Assets::Texture* texture, const Renderer::FontDescriptor& font);
             
+            void updateTextureInfos(const Renderer::FontDescriptor& font, float maxCellWidth);
+            TextureInfo& textureInfo(const Assets::Texture* texture);
+            
             struct CompareByUsageCount;
             struct CompareByName;
             struct MatchUsageCount;
-            struct MatchName;
             
             Assets::TextureCollectionList getCollections() const;
-            Assets::TextureList getTextures(const Assets::TextureCollection* collection) const;
-            Assets::TextureList getTextures() const;
+            Assets::TextureList getTextures(const Assets::TextureCollection* collection);
+            Assets::TextureList getTextures();
             
-            void filterTextures(Assets::TextureList& textures) const;
-            void sortTextures(Assets::TextureList& textures) const;
+            void filterTextures(Assets::TextureList& textures);
+            void sortTextures(Assets::TextureList& textures);
             
             void doClear();
             void doRender(Layout& layout, float y, float height);
@@ -108,6 +133,7 @@ namespace TrenchBroom {
             void renderBounds(Layout& layout, float y, float height);
             const Color& textureColor(const Assets::Texture& texture) const;
             void renderTextures(Layout& layout, float y, float height);
+            bool useThumbnail(const Assets::Texture& texture, const LayoutBounds& bounds) const;
             void renderNames(Layout& layout, float y, float height);
             void renderGroupTitleBackgrounds(Layout& layout, float y, float height);
             void renderStrings(Layout& layout, float y, float height);
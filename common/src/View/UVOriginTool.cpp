@@ -287,7 +287,7 @@ namespace TrenchBroom {
             const Model::Hit& yHandleHit = pickResult.query().type(YHandleHit).occluded().first();
             
             const bool highlight = xHandleHit.isMatch() && yHandleHit.isMatch();;
-            renderBatch.addOneShot(new RenderOrigin(m_helper, OriginHandleRadius, highlight));
+            renderBatch.addStreamed(new RenderOrigin(m_helper, OriginHandleRadius, highlight));
         }
         
         bool UVOriginTool::doCancel() {
@@ -156,7 +156,7 @@ namespace TrenchBroom {
                 document->commitPendingAssets();
                 
                 Renderer::RenderContext renderContext(Renderer::RenderContext::RenderMode_2D, m_camera, fontManager(), shaderManager());
-                Renderer::RenderBatch renderBatch(vertexVbo(), indexVbo());
+                Renderer::RenderBatch renderBatch(vertexVbo(), indexVbo(), streamVbo());
                 
                 setupGL(renderContext);
                 renderTexture(renderContext, renderBatch);
@@ -265,7 +265,7 @@ namespace TrenchBroom {
             if (texture == NULL)
                 return;
 
-            renderBatch.addOneShot(new RenderTexture(m_helper));
+            renderBatch.addStreamed(new RenderTexture(m_helper));
         }
         
         void UVView::renderFace(Renderer::RenderContext& renderContext, Renderer::RenderBatch& renderBatch) {
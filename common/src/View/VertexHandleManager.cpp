@@ -35,6 +35,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <iterator>
 
 namespace TrenchBroom {
@@ -245,6 +246,7 @@ namespace TrenchBroom {
                 } else {
                     m_unselectedVertexHandles[vertex->position()].insert(brush);
                 }
+                m_vertexHandleGrid.insert(vertex->position());
             }
             m_totalVertexCount += brush->vertexCount();
             
@@ -257,6 +259,7 @@ namespace TrenchBroom {
                 } else {
                     m_unselectedEdgeHandles[position].insert(edge);
                 }
+                m_edgeHandleGrid.insert(position);
             }
             m_totalEdgeCount += brush->edgeCount();
 
@@ -269,6 +272,7 @@ namespace TrenchBroom {
                 } else {
                     m_unselectedFaceHandles[position].insert(face);
                 }
+                m_faceHandleGrid.insert(position);
             }
             m_totalFaceCount += brush->faceCount();
             
@@ -283,6 +287,7 @@ namespace TrenchBroom {
                 } else {
                     removeHandle(vertex->position(), brush, m_unselectedVertexHandles);
                 }
+                removeGridHandle(vertex->position(), m_selectedVertexHandles, m_unselectedVertexHandles, m_vertexHandleGrid);
             }
             ensure(m_totalVertexCount >= brush->vertexCount(), "brush vertices exceed total vertices");
             m_totalVertexCount -= brush->vertexCount();
@@ -295,6 +300,7 @@ namespace TrenchBroom {
                 } else {
                     removeHandle(position, edge, m_unselectedEdgeHandles);
                 }
+                removeGridHandle(position, m_selectedEdgeHandles, m_unselectedEdgeHandles, m_edgeHandleGrid);
             }
             ensure(m_totalEdgeCount >= brush->edgeCount(), "brush edges exceed total edges");
             m_totalEdgeCount -= brush->edgeCount();
@@ -307,6 +313,7 @@ namespace TrenchBroom {
                 } else {
                     removeHandle(position, face, m_unselectedFaceHandles);
                 }
+                removeGridHandle(position, m_selectedFaceHandles, m_unselectedFaceHandles, m_faceHandleGrid);
             }
             ensure(m_totalFaceCount >= brush->faceCount(), "brush faces exceed total faces");
             m_totalFaceCount -= brush->faceCount();
@@ -327,6 +334,9 @@ namespace TrenchBroom {
             m_selectedFaceHandles.clear();
             m_totalFaceCount = 0;
             m_selectedFaceCount = 0;
+            m_vertexHandleGrid.clear();
+            m_edgeHandleGrid.clear();
+            m_faceHandleGrid.clear();
             m_renderStateValid = false;
         }
         
@@ -514,54 +524,65 @@ namespace TrenchBroom {
             }
         }
 
-        void VertexHandleManager::pick(const Ray3& ray, const Renderer::Camera& camera, Model::PickResult& pickResult, bool splitMode) const {
-            if ((m_selectedEdgeHandles.empty() && m_selectedFaceHandles.empty()) || splitMode) {
-                for (const auto& entry : m_unselectedVertexHandles) {
-                    const Vec3& position = entry.first;
-                    const Model::Hit hit = pickHandle(ray, camera, position, VertexHandleHit);
-                    if (hit.isMatch())
-                        pickResult.addHit(hit);
-                }
-            }
-
-            for (const auto& entry : m_selectedVertexHandles) {
-                const Vec3& position = entry.first;
-                const Model::Hit hit = pickHandle(ray, camera, position, VertexHandleHit);
-                if (hit.isMatch())
-                    pickResult.addHit(hit);
-            }
+        class VertexHandleManager::HandleReach {
+        private:
+            const Renderer::Camera& m_camera;
+            FloatType m_handleRadius;
+        public:
+            HandleReach(const Renderer::Camera& camera, const FloatType handleRadius) :
+            m_camera(camera),
+            m_handleRadius(handleRadius) {}
             
-            if (m_selectedVertexHandles.empty() && m_selectedFaceHandles.empty() && !splitMode) {
-                for (const auto& entry : m_unselectedEdgeHandles) {
-                    const Vec3& position = entry.first;
-                    const Model::Hit hit = pickHandle(ray, camera, position, EdgeHandleHit);
-                    if (hit.isMatch())
-                        pickResult.addHit(hit);
+            // Camera::pickPointHandle scales the handle radius with the perspective scaling factor, which is linear in
+            // the distance to the camera, so its maximum over a cell is attained at one of the cell's corners.
+            FloatType operator()(const BBox3& bounds) const {
+                float maxScaling = 0.0f;
+                for (size_t i = 0; i < 8; ++i) {
+                    const Vec3f corner(static_cast<float>((i & 1) ? bounds.max.x() : bounds.min.x()),
+                                       static_cast<float>((i & 2) ? bounds.max.y() : bounds.min.y()),
+                                       static_cast<float>((i & 4) ? bounds.max.z() : bounds.min.z()));
+                    maxScaling = std::max(maxScaling, std::abs(m_camera.perspectiveScalingFactor(corner)));
                 }
+                return 2.0 * m_handleRadius * static_cast<FloatType>(maxScaling);
             }
+        };
+        
+        template <typename Element>
+        void VertexHandleManager::pickHandles(const Ray3& ray, const Renderer::Camera& camera, Vec3::List candidates, const std::map<Vec3, std::set<Element*>, Vec3::LexicographicOrder >* unselected, const std::map<Vec3, std::set<Element*>, Vec3::LexicographicOrder >& selected, const Model::Hit::HitType type, Model::PickResult& pickResult) const {
+            // keep the order in which hits at equal distances are added independent of the grid layout
+            std::sort(std::begin(candidates), std::end(candidates), Vec3::LexicographicOrder());
             
-            for (const auto& entry : m_selectedEdgeHandles) {
-                const Vec3& position = entry.first;
-                const Model::Hit hit = pickHandle(ray, camera, position, EdgeHandleHit);
-                if (hit.isMatch())
-                    pickResult.addHit(hit);
-            }
+            if (unselected != NULL)
+                pickHandles(ray, camera, candidates, *unselected, type, pickResult);
+            pickHandles(ray, camera, candidates, selected, type, pickResult);
+        }
+        
+        template <typename Element>
+        void VertexHandleManager::pickHandles(const Ray3& ray, const Renderer::Camera& camera, const Vec3::List& candidates, const std::map<Vec3, std::set<Element*>, Vec3::LexicographicOrder >& handles, const Model::Hit::HitType type, Model::PickResult& pickResult) const {
+            if (handles.empty())
+                return;
             
-            if (m_selectedVertexHandles.empty() && m_selectedEdgeHandles.empty() && !splitMode) {
-                for (const auto& entry : m_unselectedFaceHandles) {
-                    const Vec3& position = entry.first;
-                    const Model::Hit hit = pickHandle(ray, camera, position, FaceHandleHit);
+            for (const Vec3& candidate : candidates) {
+                const auto it = handles.find(candidate);
+                if (it != std::end(handles)) {
+                    const Model::Hit hit = pickHandle(ray, camera, it->first, type);
                     if (hit.isMatch())
                         pickResult.addHit(hit);
                 }
             }
+        }
+
+        void VertexHandleManager::pick(const Ray3& ray, const Renderer::Camera& camera, Model::PickResult& pickResult, bool splitMode) const {
+            const HandleReach reach(camera, pref(Preferences::HandleRadius));
             
-            for (const auto& entry : m_selectedFaceHandles) {
-                const Vec3& position = entry.first;
-                const Model::Hit hit = pickHandle(ray, camera, position, FaceHandleHit);
-                if (hit.isMatch())
-                    pickResult.addHit(hit);
-            }
+            const bool pickUnselectedVertices = (m_selectedEdgeHandles.empty() && m_selectedFaceHandles.empty()) || splitMode;
+            pickHandles(ray, camera, m_vertexHandleGrid.findNearRay(ray, reach), pickUnselectedVertices ? &m_unselectedVertexHandles : NULL, m_selectedVertexHandles, VertexHandleHit, pickResult);
+            
+            const bool pickUnselectedEdges = m_selectedVertexHandles.empty() && m_selectedFaceHandles.empty() && !splitMode;
+            pickHandles(ray, camera, m_edgeHandleGrid.findNearRay(ray, reach), pickUnselectedEdges ? &m_unselectedEdgeHandles : NULL, m_selectedEdgeHandles, EdgeHandleHit, pickResult);
+            
+            const bool pickUnselectedFaces = m_selectedVertexHandles.empty() && m_selectedEdgeHandles.empty() && !splitMode;
+            pickHandles(ray, camera, m_faceHandleGrid.findNearRay(ray, reach), pickUnselectedFaces ? &m_unselectedFaceHandles : NULL, m_selectedFaceHandles, FaceHandleHit, pickResult);
         }
 
         void VertexHandleManager::render(Renderer::RenderContext& renderContext, Renderer::RenderBatch& renderBatch, const bool splitMode) {
@@ -640,10 +661,12 @@ namespace TrenchBroom {
         Vec3::List VertexHandleManager::findVertexHandlePositions(const Model::BrushSet& brushes, const Vec3& query, const FloatType maxDistance) {
             Vec3::List result;
             
-            for (const Model::Brush* brush : brushes) {
-                for (const Model::BrushVertex* vertex : brush->vertices()) {
-                    if (query.squaredDistanceTo(vertex->position()) <= maxDistance * maxDistance)
-                        result.push_back(vertex->position());
+            for (const Vec3& position : m_vertexHandleGrid.findInRadius(query, maxDistance)) {
+                for (Model::Brush* brush : this->brushes(position)) {
+                    if (brushes.count(brush) > 0) {
+                        result.push_back(position);
+                        break;
+                    }
                 }
             }
             
@@ -653,11 +676,12 @@ namespace TrenchBroom {
         Vec3::List VertexHandleManager::findEdgeHandlePositions(const Model::BrushSet& brushes, const Vec3& query, const FloatType maxDistance) {
             Vec3::List result;
 
-            for (const Model::Brush* brush : brushes) {
-                for (const Model::BrushEdge* edge : brush->edges()) {
-                    const Vec3 center = edge->center();
-                    if (query.squaredDistanceTo(center) <= maxDistance * maxDistance)
-                        result.push_back(center);
+            for (const Vec3& position : m_edgeHandleGrid.findInRadius(query, maxDistance)) {
+                for (const Model::BrushEdge* edge : edges(position)) {
+                    if (brushes.count(edge->firstFace()->payload()->brush()) > 0) {
+                        result.push_back(position);
+                        break;
+                    }
                 }
             }
             
@@ -667,11 +691,12 @@ namespace TrenchBroom {
         Vec3::List VertexHandleManager::findFaceHandlePositions(const Model::BrushSet& brushes, const Vec3& query, const FloatType maxDistance) {
             Vec3::List result;
 
-            for (const Model::Brush* brush : brushes) {
-                for (const Model::BrushFace* face : brush->faces()) {
-                    const Vec3 center = face->center();
-                    if (query.squaredDistanceTo(center) <= maxDistance * maxDistance)
-                        result.push_back(center);
+            for (const Vec3& position : m_faceHandleGrid.findInRadius(query, maxDistance)) {
+                for (const Model::BrushFace* face : faces(position)) {
+                    if (brushes.count(face->brush()) > 0) {
+                        result.push_back(position);
+                        break;
+                    }
                 }
             }
             
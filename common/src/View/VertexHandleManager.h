@@ -21,6 +21,7 @@
 #define TrenchBroom_VertexHandleManager
 
 #include "TrenchBroom.h"
+#include "UniformGrid.h"
 #include "VecMath.h"
 #include "Model/BrushGeometry.h"
 #include "Model/Hit.h"
@@ -49,6 +50,8 @@ namespace TrenchBroom {
             static const Model::Hit::HitType EdgeHandleHit;
             static const Model::Hit::HitType FaceHandleHit;
         private:
+            typedef UniformGrid<FloatType> HandleGrid;
+            
             Model::VertexToBrushesMap m_unselectedVertexHandles;
             Model::VertexToBrushesMap m_selectedVertexHandles;
             Model::VertexToEdgesMap m_unselectedEdgeHandles;
@@ -56,6 +59,11 @@ namespace TrenchBroom {
             Model::VertexToFacesMap m_unselectedFaceHandles;
             Model::VertexToFacesMap m_selectedFaceHandles;
             
+            // all handle positions of each kind, selected or not, to find handles near a ray or a point quickly
+            HandleGrid m_vertexHandleGrid;
+            HandleGrid m_edgeHandleGrid;
+            HandleGrid m_faceHandleGrid;
+            
             size_t m_totalVertexCount;
             size_t m_selectedVertexCount;
             size_t m_totalEdgeCount;
@@ -201,6 +209,17 @@ namespace TrenchBroom {
                 return elementCount;
             }
 
+            template <typename Element>
+            inline void removeGridHandle(const Vec3& position, const std::map<Vec3, std::set<Element*>, Vec3::LexicographicOrder >& selected, const std::map<Vec3, std::set<Element*>, Vec3::LexicographicOrder >& unselected, HandleGrid& grid) {
+                if (selected.count(position) == 0 && unselected.count(position) == 0)
+                    grid.remove(position);
+            }
+            
+            template <typename Element>
+            void pickHandles(const Ray3& ray, const Renderer::Camera& camera, Vec3::List candidates, const std::map<Vec3, std::set<Element*>, Vec3::LexicographicOrder >* unselected, const std::map<Vec3, std::set<Element*>, Vec3::LexicographicOrder >& selected, Model::Hit::HitType type, Model::PickResult& pickResult) const;
+            template <typename Element>
+            void pickHandles(const Ray3& ray, const Renderer::Camera& camera, const Vec3::List& candidates, const std::map<Vec3, std::set<Element*>, Vec3::LexicographicOrder >& handles, Model::Hit::HitType type, Model::PickResult& pickResult) const;
+
             template <typename T, typename O>
             void handlePositions(const std::map<Vec3, T, O>& handles, Vec3::List& result) const {
                 result.reserve(result.size() + handles.size());
@@ -215,6 +234,7 @@ namespace TrenchBroom {
             Vec3::List findEdgeHandlePositions(const Model::BrushSet& brushes, const Vec3& query, FloatType maxDistance);
             Vec3::List findFaceHandlePositions(const Model::BrushSet& brushes, const Vec3& query, FloatType maxDistance);
             
+            class HandleReach;
             Model::Hit pickHandle(const Ray3& ray, const Renderer::Camera& camera, const Vec3& position, Model::Hit::HitType type) const;
             void validateRenderState(bool splitMode);
         };
@@ -0,0 +1,74 @@
+/*
+ Copyright (C) 2010-2016 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include "ByteBuffer.h"
+#include "Color.h"
+#include "Assets/Palette.h"
+#include "IO/DiskFileSystem.h"
+#include "IO/DiskIO.h"
+#include "IO/Path.h"
+
+namespace TrenchBroom {
+    namespace Assets {
+        TEST(PaletteTest, loadFileIsCached) {
+            Palette::clearCache();
+            
+            IO::DiskFileSystem fs(IO::Disk::getCurrentWorkingDir());
+            const Palette palette1 = Palette::loadFile(fs, IO::Path("data/palette.lmp"));
+            const Palette palette2 = Palette::loadFile(fs, IO::Path("data/palette.lmp"));
+            ASSERT_EQ(palette1, palette2);
+            
+            const Palette palette3 = Palette::loadFile(fs, IO::Path("data/colormap.pcx"));
+            ASSERT_NE(palette1, palette3);
+            
+            Palette::clearCache();
+            const Palette palette4 = Palette::loadFile(fs, IO::Path("data/palette.lmp"));
+            ASSERT_NE(palette1, palette4);
+        }
+        
+        TEST(PaletteTest, indexedToRgb) {
+            unsigned char* data = new unsigned char[6];
+            data[0] = 0x00; data[1] = 0x00; data[2] = 0x00;
+            data[3] = 0xFF; data[4] = 0x80; data[5] = 0x00;
+            const Palette palette(6, data);
+            
+            const unsigned char indices[] = { 0, 1, 1, 1 };
+            Buffer<unsigned char> rgbImage(4 * 3);
+            Color averageColor;
+            palette.indexedToRgb(indices, 4, rgbImage, averageColor);
+            
+            ASSERT_EQ(0x00, rgbImage[0]);
+            ASSERT_EQ(0x00, rgbImage[1]);
+            ASSERT_EQ(0x00, rgbImage[2]);
+            for (size_t i = 1; i < 4; ++i) {
+                ASSERT_EQ(0xFF, rgbImage[i * 3 + 0]);
+                ASSERT_EQ(0x80, rgbImage[i * 3 + 1]);
+                ASSERT_EQ(0x00, rgbImage[i * 3 + 2]);
+            }
+            
+            ASSERT_FLOAT_EQ(0.75f, averageColor.r());
+            ASSERT_FLOAT_EQ(0.75f * 0x80 / 0xFF, averageColor.g());
+            ASSERT_FLOAT_EQ(0.0f, averageColor.b());
+            ASSERT_FLOAT_EQ(1.0f, averageColor.a());
+        }
+    }
+}
@@ -0,0 +1,55 @@
+/*
+ Copyright (C) 2010-2016 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Assets/TextureName.h"
+
+namespace TrenchBroom {
+    namespace Assets {
+        TEST(TextureNameTest, internEqualNames) {
+            const TextureName name1("Rock1_2");
+            const TextureName name2(String("Rock1") + "_2");
+            const TextureName name3("rock1_2");
+            
+            ASSERT_EQ(name1, name2);
+            ASSERT_NE(name1, name3);
+            ASSERT_EQ(&name1.name(), &name2.name());
+            ASSERT_EQ("Rock1_2", name1.name());
+            ASSERT_EQ("rock1_2", name3.name());
+        }
+        
+        TEST(TextureNameTest, key) {
+            const TextureName upper("*WATER1");
+            const TextureName lower("*water1");
+            
+            ASSERT_EQ(lower, upper.key());
+            ASSERT_EQ(lower, lower.key());
+            ASSERT_EQ("*water1", upper.key().name());
+            
+            ASSERT_EQ(TextureName(""), TextureName());
+            ASSERT_EQ(TextureName(), TextureName().key());
+        }
+        
+        TEST(TextureNameTest, hash) {
+            const TextureName::Hash hash;
+            ASSERT_EQ(hash(TextureName("metal")), hash(TextureName("metal")));
+        }
+    }
+}
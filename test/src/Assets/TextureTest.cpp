@@ -0,0 +1,106 @@
+/*
+ Copyright (C) 2010-2016 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Assets/Texture.h"
+
+namespace TrenchBroom {
+    namespace Assets {
+        TEST(TextureTest, createThumbnailOfSmallTexture) {
+            TextureBuffer buffer(3 * 4 * 2);
+            for (size_t i = 0; i < buffer.size(); ++i)
+                buffer[i] = static_cast<unsigned char>(i);
+            
+            const Texture texture("small", 4, 2, Color(), buffer);
+            size_t width, height;
+            const TextureBuffer thumbnail = texture.createThumbnail(64, width, height);
+            ASSERT_EQ(4u, width);
+            ASSERT_EQ(2u, height);
+            ASSERT_EQ(buffer.size(), thumbnail.size());
+            for (size_t i = 0; i < buffer.size(); ++i)
+                ASSERT_EQ(buffer[i], thumbnail[i]);
+        }
+        
+        TEST(TextureTest, createThumbnailUsesSmallestSuitableMip) {
+            TextureBuffer::List buffers(3);
+            setMipBufferSize(buffers, 16, 8);
+            for (size_t i = 0; i < buffers.size(); ++i) {
+                for (size_t j = 0; j < buffers[i].size(); ++j)
+                    buffers[i][j] = static_cast<unsigned char>(10 * (i + 1));
+            }
+            
+            const Texture texture("mipped", 16, 8, Color(), buffers);
+            size_t width, height;
+            const TextureBuffer thumbnail = texture.createThumbnail(8, width, height);
+            ASSERT_EQ(8u, width);
+            ASSERT_EQ(4u, height);
+            ASSERT_EQ(3u * 8u * 4u, thumbnail.size());
+            for (size_t i = 0; i < thumbnail.size(); ++i)
+                ASSERT_EQ(20u, thumbnail[i]);
+        }
+        
+        TEST(TextureTest, createThumbnailAveragesPixels) {
+            // a 4x2 BGR image where each 2x2 block has a distinct average
+            TextureBuffer buffer(3 * 4 * 2);
+            const unsigned char pixels[] = {
+                0, 10, 100,   0, 30, 100,   50, 0, 0,   150, 0, 0,
+                0, 10, 200,   0, 30, 200,   50, 0, 0,   150, 0, 0
+            };
+            for (size_t i = 0; i < buffer.size(); ++i)
+                buffer[i] = pixels[i];
+            
+            const Texture texture("averaged", 4, 2, Color(), buffer, GL_BGR);
+            size_t width, height;
+            const TextureBuffer thumbnail = texture.createThumbnail(2, width, height);
+            ASSERT_EQ(2u, width);
+            ASSERT_EQ(1u, height);
+            
+            // the channels are swapped to RGB
+            ASSERT_EQ(150u, thumbnail[0]);
+            ASSERT_EQ(20u, thumbnail[1]);
+            ASSERT_EQ(0u, thumbnail[2]);
+            ASSERT_EQ(0u, thumbnail[3]);
+            ASSERT_EQ(0u, thumbnail[4]);
+            ASSERT_EQ(100u, thumbnail[5]);
+        }
+        
+        TEST(TextureTest, createThumbnailWithoutImageData) {
+            const Texture texture("empty", 16, 16);
+            size_t width = 0, height = 0;
+            const TextureBuffer thumbnail = texture.createThumbnail(8, width, height);
+            ASSERT_EQ(0u, thumbnail.size());
+        }
+        
+        TEST(TextureTest, createThumbnailFromMips) {
+            TextureBuffer::List mips(2);
+            setMipBufferSize(mips, 4, 4);
+            for (size_t i = 0; i < mips[1].size(); ++i)
+                mips[1][i] = 50;
+            
+            size_t width, height;
+            const TextureBuffer thumbnail = createThumbnail(mips, 4, 4, GL_RGB, 2, width, height);
+            ASSERT_EQ(2u, width);
+            ASSERT_EQ(2u, height);
+            ASSERT_EQ(12u, thumbnail.size());
+            for (size_t i = 0; i < thumbnail.size(); ++i)
+                ASSERT_EQ(50u, thumbnail[i]);
+        }
+    }
+}
@@ -24,6 +24,8 @@
 
 #include "TestUtils.h"
 
+#include <random>
+
 TEST(BBoxTest, constructBBox3fWithDefaults) {
     const BBox3f bounds;
     ASSERT_EQ(Vec3f::Null, bounds.min);
@@ -228,3 +230,55 @@ TEST(BBoxTest, translated) {
     const BBox3f translated(Vec3f(-10.0f, -4.0f,  1.0f), Vec3f(10.0f, 8.0f, 5.0f));
     ASSERT_EQ(translated, bounds.translated(Vec3f(2.0f, -1.0f, -3.0f)));
 }
+
+template <typename T>
+static void assertMergeBoundsMatchesMergeWith() {
+    std::mt19937 generator(3);
+    std::uniform_real_distribution<T> coordinates(static_cast<T>(-1024.0), static_cast<T>(1024.0));
+    
+    typename Vec<T,3>::List points;
+    for (size_t i = 0; i < 65; ++i)
+        points.push_back(Vec<T,3>(coordinates(generator), coordinates(generator), coordinates(generator)));
+    
+    std::vector<BBox<T,3> > boxes;
+    for (size_t i = 0; i + 1 < points.size(); i += 2) {
+        BBox<T,3> box(points[i], points[i]);
+        boxes.push_back(box.mergeWith(points[i + 1]));
+    }
+    
+    const BBox<T,3> initial(static_cast<T>(-1.0), static_cast<T>(1.0));
+    
+    BBox<T,3> expectedFromPoints = initial;
+    for (const Vec<T,3>& point : points)
+        expectedFromPoints.mergeWith(point);
+    BBox<T,3> fromPoints = initial;
+    mergeBounds(fromPoints, &points.front(), points.size());
+    ASSERT_EQ(expectedFromPoints, fromPoints);
+    
+    BBox<T,3> constructed(points);
+    ASSERT_EQ(constructed.mergeWith(initial), fromPoints);
+    
+    BBox<T,3> expectedFromBoxes = initial;
+    for (const BBox<T,3>& box : boxes)
+        expectedFromBoxes.mergeWith(box);
+    BBox<T,3> fromBoxes = initial;
+    mergeBounds(fromBoxes, &boxes.front(), boxes.size());
+    ASSERT_EQ(expectedFromBoxes, fromBoxes);
+}
+
+TEST(BBoxTest, mergeBoundsd) {
+    assertMergeBoundsMatchesMergeWith<double>();
+}
+
+TEST(BBoxTest, mergeBoundsf) {
+    assertMergeBoundsMatchesMergeWith<float>();
+}
+
+TEST(BBoxTest, rotateBBoxWithMatrix) {
+    const BBox3d bounds(Vec3d(-2.0, -1.0, 0.0), Vec3d(4.0, 3.0, 5.0));
+    const Mat4x4d transformation = translationMatrix(Vec3d(1.0, 2.0, 3.0)) * rotationMatrix(Vec3d::PosZ, Math::radians(90.0));
+    
+    const BBox3d rotated = rotateBBox(bounds, transformation);
+    ASSERT_VEC_EQ(Vec3d(-2.0, 0.0, 3.0), rotated.min);
+    ASSERT_VEC_EQ(Vec3d(2.0, 6.0, 8.0), rotated.max);
+}
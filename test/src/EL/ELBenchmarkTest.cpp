@@ -0,0 +1,92 @@
+/*
+ Copyright (C) 2010-2016 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "EL.h"
+#include "TestUtils.h"
+#include "IO/ELParser.h"
+
+namespace TrenchBroom {
+    namespace EL {
+        static Expression modelDefinitionExpression() {
+            Expression expression = IO::ELParser::parse("{{ spawnflags & 1 -> { 'path': 'progs/armor.mdl', 'skin': 1 + 1 }, spawnflags & 2 -> 'progs/' + model + '.mdl', 'progs/armor.mdl' }}");
+            expression.optimize();
+            return expression;
+        }
+        
+        static Expression arithmeticExpression() {
+            Expression expression = IO::ELParser::parse("(x * 2 + y) % 7 == 3 && !(x < y) || x >= 100");
+            expression.optimize();
+            return expression;
+        }
+        
+        static void declareModelDefinitionVariables(VariableTable& store) {
+            store.declare("spawnflags", Value(2));
+            store.declare("model", Value("ogre"));
+        }
+        
+        static void declareArithmeticVariables(VariableTable& store) {
+            store.declare("x", Value(10));
+            store.declare("y", Value(3));
+        }
+        
+        TEST(ELBenchmarkTest, evaluateModelDefinition) {
+            const Expression expression = modelDefinitionExpression();
+            VariableTable store;
+            declareModelDefinitionVariables(store);
+            
+            ASSERT_EQ(Value("progs/ogre.mdl"), expression.evaluate(EvaluationContext(store)));
+        }
+        
+        TEST(ELBenchmarkTest, evaluateArithmetic) {
+            const Expression expression = arithmeticExpression();
+            VariableTable store;
+            declareArithmeticVariables(store);
+            
+            ASSERT_EQ(Value(false), expression.evaluate(EvaluationContext(store)));
+        }
+        
+        TEST(ELBenchmarkTest, DISABLED_evaluateModelDefinitionRepeatedly) {
+            const Expression expression = modelDefinitionExpression();
+            VariableTable store;
+            declareModelDefinitionVariables(store);
+            
+            Value result;
+            measureTime("evaluateMs", [&]() {
+                for (size_t i = 0; i < 20000; ++i)
+                    result = expression.evaluate(EvaluationContext(store));
+            });
+            ASSERT_EQ(Value("progs/ogre.mdl"), result);
+        }
+        
+        TEST(ELBenchmarkTest, DISABLED_evaluateArithmeticRepeatedly) {
+            const Expression expression = arithmeticExpression();
+            VariableTable store;
+            declareArithmeticVariables(store);
+            
+            Value result;
+            measureTime("evaluateMs", [&]() {
+                for (size_t i = 0; i < 20000; ++i)
+                    result = expression.evaluate(EvaluationContext(store));
+            });
+            ASSERT_EQ(Value(false), result);
+        }
+    }
+}
@@ -84,6 +84,7 @@ namespace TrenchBroom {
         
         glDrawArrays.bindMemFunc(this, &GLMock::DrawArrays);
         glMultiDrawArrays.bindMemFunc(this, &GLMock::MultiDrawArrays);
+        glDrawElements.bindMemFunc(this, &GLMock::DrawElements);
         
         glCreateShader.bindMemFunc(this, &GLMock::CreateShader);
         glDeleteShader.bindMemFunc(this, &GLMock::DeleteShader);
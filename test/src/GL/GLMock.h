@@ -91,6 +91,7 @@ namespace TrenchBroom {
         
         MOCK_METHOD3(DrawArrays, void(GLenum, GLint, GLsizei));
         MOCK_METHOD4(MultiDrawArrays, void(GLenum, const GLint*, const GLsizei*, GLsizei));
+        MOCK_METHOD4(DrawElements, void(GLenum, GLsizei, GLenum, const GLvoid*));
         
         MOCK_METHOD1(CreateShader, GLuint(GLenum));
         MOCK_METHOD1(DeleteShader, void(GLuint));
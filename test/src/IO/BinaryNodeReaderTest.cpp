@@ -0,0 +1,150 @@
+/*
+ Copyright (C) 2010-2016 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "CollectionUtils.h"
+#include "IO/BinaryNodeReader.h"
+#include "IO/BinaryNodeWriter.h"
+#include "IO/TestParserStatus.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushFace.h"
+#include "Model/Entity.h"
+#include "Model/Group.h"
+#include "Model/Layer.h"
+#include "Model/MapFormat.h"
+#include "Model/World.h"
+
+namespace TrenchBroom {
+    namespace IO {
+        static void assertSameFaces(const Model::BrushFace* expected, const Model::BrushFace* actual) {
+            for (size_t i = 0; i < 3; ++i)
+                ASSERT_EQ(expected->points()[i], actual->points()[i]);
+            ASSERT_EQ(expected->textureName(), actual->textureName());
+            ASSERT_FLOAT_EQ(expected->xOffset(), actual->xOffset());
+            ASSERT_FLOAT_EQ(expected->yOffset(), actual->yOffset());
+            ASSERT_FLOAT_EQ(expected->rotation(), actual->rotation());
+            ASSERT_FLOAT_EQ(expected->xScale(), actual->xScale());
+            ASSERT_FLOAT_EQ(expected->yScale(), actual->yScale());
+        }
+        
+        static void assertSameBrushes(const Model::Brush* expected, const Model::Brush* actual) {
+            const Model::BrushFaceList& expectedFaces = expected->faces();
+            const Model::BrushFaceList& actualFaces = actual->faces();
+            ASSERT_EQ(expectedFaces.size(), actualFaces.size());
+            for (size_t i = 0; i < expectedFaces.size(); ++i)
+                assertSameFaces(expectedFaces[i], actualFaces[i]);
+            ASSERT_EQ(expected->bounds(), actual->bounds());
+        }
+        
+        TEST(BinaryNodeReaderTest, readWrittenNodes) {
+            const BBox3 worldBounds(8192.0);
+            Model::World world(Model::MapFormat::Standard, NULL, worldBounds);
+            Model::BrushBuilder builder(&world, worldBounds);
+            
+            Model::Brush* worldBrush = builder.createCube(64.0, "rock");
+            worldBrush->faces().front()->setXOffset(0.125f);
+            worldBrush->faces().front()->setRotation(33.3f);
+            world.defaultLayer()->addChild(worldBrush);
+            
+            Model::Entity* entity = world.createEntity();
+            entity->addOrUpdateAttribute("classname", "func_door");
+            entity->addOrUpdateAttribute("angle", "90");
+            Model::Brush* entityBrush = builder.createCuboid(BBox3(Vec3(64.0, 0.0, 0.0), Vec3(128.0, 32.0, 16.0)), "door");
+            entity->addChild(entityBrush);
+            world.defaultLayer()->addChild(entity);
+            
+            Model::Group* group = world.createGroup("some group");
+            Model::Brush* groupBrush = builder.createCube(32.0, "metal");
+            group->addChild(groupBrush);
+            world.defaultLayer()->addChild(group);
+            
+            Model::NodeList nodes;
+            nodes.push_back(worldBrush);
+            nodes.push_back(entity);
+            nodes.push_back(group);
+            
+            const String data = BinaryNodeWriter::writeNodes(world.format(), nodes);
+            ASSERT_TRUE(BinaryNodeReader::isBinaryNodeData(data));
+            
+            TestParserStatus status;
+            const Model::NodeList result = BinaryNodeReader::readNodes(data, &world, worldBounds, status);
+            ASSERT_EQ(3u, result.size());
+            
+            const Model::Brush* readWorldBrush = static_cast<const Model::Brush*>(result[0]);
+            assertSameBrushes(worldBrush, readWorldBrush);
+            
+            const Model::Group* readGroup = static_cast<const Model::Group*>(result[1]);
+            ASSERT_EQ(String("some group"), readGroup->name());
+            ASSERT_EQ(1u, readGroup->childCount());
+            assertSameBrushes(groupBrush, static_cast<const Model::Brush*>(readGroup->children().front()));
+            
+            const Model::Entity* readEntity = static_cast<const Model::Entity*>(result[2]);
+            ASSERT_EQ(entity->attributes().size(), readEntity->attributes().size());
+            ASSERT_EQ(String("func_door"), readEntity->attribute("classname"));
+            ASSERT_EQ(String("90"), readEntity->attribute("angle"));
+            ASSERT_EQ(1u, readEntity->childCount());
+            assertSameBrushes(entityBrush, static_cast<const Model::Brush*>(readEntity->children().front()));
+            
+            VectorUtils::deleteAll(result);
+        }
+        
+        TEST(BinaryNodeReaderTest, readWrittenBrushFaces) {
+            const BBox3 worldBounds(8192.0);
+            Model::World world(Model::MapFormat::Valve, NULL, worldBounds);
+            Model::BrushBuilder builder(&world, worldBounds);
+            
+            Model::Brush* brush = builder.createCube(64.0, "rock");
+            brush->faces().back()->setYScale(0.5f);
+            world.defaultLayer()->addChild(brush);
+            
+            const String data = BinaryNodeWriter::writeBrushFaces(world.format(), brush->faces());
+            const Model::BrushFaceList result = BinaryNodeReader::readBrushFaces(data, &world);
+            ASSERT_EQ(brush->faces().size(), result.size());
+            for (size_t i = 0; i < result.size(); ++i) {
+                assertSameFaces(brush->faces()[i], result[i]);
+                ASSERT_EQ(brush->faces()[i]->textureXAxis(), result[i]->textureXAxis());
+                ASSERT_EQ(brush->faces()[i]->textureYAxis(), result[i]->textureYAxis());
+            }
+            
+            VectorUtils::deleteAll(result);
+        }
+        
+        TEST(BinaryNodeReaderTest, rejectInvalidData) {
+            const BBox3 worldBounds(8192.0);
+            Model::World world(Model::MapFormat::Standard, NULL, worldBounds);
+            Model::BrushBuilder builder(&world, worldBounds);
+            
+            Model::Brush* brush = builder.createCube(64.0, "rock");
+            world.defaultLayer()->addChild(brush);
+            
+            const String data = BinaryNodeWriter::writeNodes(world.format(), Model::NodeList(1, brush));
+            TestParserStatus status;
+            
+            ASSERT_FALSE(BinaryNodeReader::isBinaryNodeData("{ \"classname\" \"worldspawn\" }"));
+            ASSERT_THROW(BinaryNodeReader::readNodes("{ \"classname\" \"worldspawn\" }", &world, worldBounds, status), ParserException);
+            ASSERT_THROW(BinaryNodeReader::readNodes(data.substr(0, data.size() - 5), &world, worldBounds, status), ParserException);
+            ASSERT_THROW(BinaryNodeReader::readBrushFaces(data, &world), ParserException);
+            
+            Model::World valveWorld(Model::MapFormat::Valve, NULL, worldBounds);
+            ASSERT_THROW(BinaryNodeReader::readNodes(data, &valveWorld, worldBounds, status), ParserException);
+        }
+    }
+}
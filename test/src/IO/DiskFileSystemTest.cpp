@@ -231,6 +231,36 @@ namespace TrenchBroom {
             ASSERT_FALSE(fs.fileExists(Path("fdfdf.blah")));
         }
         
+        TEST(DiskFileSystemTest, invalidateIndex) {
+            TestEnvironment env;
+            DiskFileSystem fs(env.dir());
+            
+            ASSERT_TRUE(fs.fileExists(Path("ANOTHERDIR/TEST3.MAP")));
+            ASSERT_FALSE(fs.fileExists(Path("anotherDir/test4.map")));
+            
+            wxFile file;
+            ASSERT_TRUE(file.Create((env.dir() + Path("anotherDir/Test4.map")).asString()));
+            file.Close();
+            
+            fs.invalidateIndex();
+            ASSERT_TRUE(fs.fileExists(Path("anotherDir/test4.map")));
+            ASSERT_TRUE(fs.fileExists(Path("anotherDir/Test4.map")));
+        }
+        
+        TEST(DiskFileSystemTest, refresh) {
+            TestEnvironment env;
+            DiskFileSystem fs(env.dir());
+            
+            ASSERT_FALSE(fs.fileExists(Path("anotherDir/test4.map")));
+            
+            wxFile file;
+            ASSERT_TRUE(file.Create((env.dir() + Path("anotherDir/Test4.map")).asString()));
+            file.Close();
+            
+            fs.refresh();
+            ASSERT_TRUE(fs.fileExists(Path("anotherDir/test4.map")));
+        }
+        
         TEST(DiskFileSystemTest, findItems) {
             TestEnvironment env;
             const DiskFileSystem fs(env.dir());
@@ -19,6 +19,7 @@
 
 #include <gtest/gtest.h>
 
+#include "TestUtils.h"
 #include "IO/DiskFileSystem.h"
 #include "IO/FileMatcher.h"
 #include "IO/DkPakFileSystem.h"
@@ -26,9 +27,96 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstring>
 
 namespace TrenchBroom {
     namespace IO {
+        /**
+         * Builds a compressed entry and its expected uncompressed contents side by side.
+         */
+        class CompressedEntryBuilder {
+        private:
+            String m_compressed;
+            String m_uncompressed;
+        public:
+            void literal(const String& bytes) {
+                assert(!bytes.empty() && bytes.size() <= 64);
+                m_compressed.push_back(static_cast<char>(bytes.size() - 1));
+                m_compressed.append(bytes);
+                m_uncompressed.append(bytes);
+            }
+            
+            void zeros(const size_t count) {
+                assert(count >= 2 && count <= 65);
+                m_compressed.push_back(static_cast<char>(count + 62));
+                m_uncompressed.append(count, '\0');
+            }
+            
+            void run(const char c, const size_t count) {
+                assert(count >= 2 && count <= 65);
+                m_compressed.push_back(static_cast<char>(count + 126));
+                m_compressed.push_back(c);
+                m_uncompressed.append(count, c);
+            }
+            
+            void reference(const size_t distance, const size_t count) {
+                assert(distance >= 2 && distance <= 257 && distance <= m_uncompressed.size());
+                assert(count >= 2 && count <= 63);
+                m_compressed.push_back(static_cast<char>(count + 190));
+                m_compressed.push_back(static_cast<char>(distance - 2));
+                for (size_t i = 0; i < count; ++i)
+                    m_uncompressed.push_back(m_uncompressed[m_uncompressed.size() - distance]);
+            }
+            
+            String compressed() const {
+                return m_compressed + static_cast<char>(0xFF);
+            }
+            
+            const String& uncompressed() const {
+                return m_uncompressed;
+            }
+        };
+        
+        static void appendInt(String& str, const size_t value) {
+            const int32_t i = static_cast<int32_t>(value);
+            str.append(reinterpret_cast<const char*>(&i), sizeof(i));
+        }
+        
+        static MappedFile::Ptr createPak(const StringList& names, const String& compressed, const size_t uncompressedSize) {
+            String pak = "PACK";
+            appendInt(pak, 12 + names.size() * compressed.size());
+            appendInt(pak, names.size() * 0x48);
+            for (size_t i = 0; i < names.size(); ++i)
+                pak.append(compressed);
+            
+            for (size_t i = 0; i < names.size(); ++i) {
+                String name = names[i];
+                name.resize(0x38, '\0');
+                pak.append(name);
+                appendInt(pak, 12 + i * compressed.size());
+                appendInt(pak, uncompressedSize);
+                appendInt(pak, compressed.size());
+                appendInt(pak, 1);
+            }
+            
+            char* buffer = new char[pak.size()];
+            std::memcpy(buffer, pak.data(), pak.size());
+            return MappedFile::Ptr(new MappedFileBuffer(Path("test.pak"), buffer, pak.size()));
+        }
+        
+        static CompressedEntryBuilder createTextureLikeEntry() {
+            CompressedEntryBuilder builder;
+            builder.literal("0123456789abcdef");
+            for (size_t i = 0; i < 200; ++i) {
+                builder.reference(16, 48);
+                builder.run(static_cast<char>(i), 20);
+                builder.zeros(30);
+                builder.reference(100, 63);
+                builder.literal("xyz");
+            }
+            return builder;
+        }
+        
         TEST(DkPakFileSystemTest, directoryExists) {
             const Path pakPath = Disk::getCurrentWorkingDir() + Path("data/IO/Pak/dkpak_test.pak");
             const MappedFile::Ptr pakFile = Disk::openFile(pakPath);
@@ -149,5 +237,66 @@ namespace TrenchBroom {
             
             ASSERT_TRUE(fs.openFile(Path("amnet.cfg")) != NULL);
         }
+        
+        TEST(DkPakFileSystemTest, openCompressedFile) {
+            const CompressedEntryBuilder builder = createTextureLikeEntry();
+            const String& expected = builder.uncompressed();
+            const DkPakFileSystem fs(Path("test.pak"), createPak(StringList(1, "textures/test.wal"), builder.compressed(), expected.size()));
+            
+            const MappedFile::Ptr file = fs.openFile(Path("textures/test.wal"));
+            ASSERT_TRUE(file != NULL);
+            ASSERT_EQ(expected, String(file->begin(), file->end()));
+            
+            // decompressed entries are cached
+            ASSERT_EQ(file, fs.openFile(Path("TEXTURES/test.wal")));
+        }
+        
+        TEST(DkPakFileSystemTest, openCompressedFileWithoutCache) {
+            const CompressedEntryBuilder builder = createTextureLikeEntry();
+            const String& expected = builder.uncompressed();
+            const DkPakFileSystem fs(Path("test.pak"), createPak(StringList(1, "textures/test.wal"), builder.compressed(), expected.size()), 0);
+            
+            const MappedFile::Ptr file1 = fs.openFile(Path("textures/test.wal"));
+            const MappedFile::Ptr file2 = fs.openFile(Path("textures/test.wal"));
+            ASSERT_NE(file1, file2);
+            ASSERT_EQ(expected, String(file1->begin(), file1->end()));
+            ASSERT_EQ(expected, String(file2->begin(), file2->end()));
+        }
+        
+        TEST(DkPakFileSystemTest, openCorruptCompressedFile) {
+            CompressedEntryBuilder builder;
+            builder.literal("abc");
+            builder.run('x', 10);
+            const DkPakFileSystem fs(Path("test.pak"), createPak(StringList(1, "test.wal"), builder.compressed(), 5));
+            ASSERT_THROW(fs.openFile(Path("test.wal")), FileSystemException);
+        }
+        
+        static void openRepeatedly(const DkPakFileSystem& fs, const Path::List& paths, const size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                for (const Path& path : paths)
+                    fs.openFile(path);
+            }
+        }
+        
+        TEST(DkPakFileSystemTest, DISABLED_benchmarkOpenCompressedFiles) {
+            const CompressedEntryBuilder builder = createTextureLikeEntry();
+            
+            StringList names;
+            Path::List paths;
+            for (size_t i = 0; i < 50; ++i) {
+                StringStream name;
+                name << "textures/test" << i << ".wal";
+                names.push_back(name.str());
+                paths.push_back(Path(names.back()));
+            }
+            
+            const MappedFile::Ptr pakFile = createPak(names, builder.compressed(), builder.uncompressed().size());
+            const DkPakFileSystem uncached(Path("test.pak"), pakFile, 0);
+            const DkPakFileSystem cached(Path("test.pak"), pakFile);
+            
+            const size_t count = 20;
+            measureTime("uncachedMs", [&]() { openRepeatedly(uncached, paths, count); });
+            measureTime("cachedMs", [&]() { openRepeatedly(cached, paths, count); });
+        }
     }
 }
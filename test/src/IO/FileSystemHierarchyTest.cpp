@@ -0,0 +1,196 @@
+/*
+ Copyright (C) 2010-2016 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "CollectionUtils.h"
+#include "IO/FileMatcher.h"
+#include "IO/FileSystemHierarchy.h"
+#include "IO/MappedFile.h"
+
+#include <algorithm>
+#include <map>
+
+namespace TrenchBroom {
+    namespace IO {
+        class TestFileSystem : public FileSystem {
+        private:
+            typedef std::map<Path, String> FileMap;
+            FileMap m_files;
+            size_t m_refreshCount;
+        public:
+            TestFileSystem(const Path::List& paths, const String& contents) :
+            m_refreshCount(0) {
+                for (const Path& path : paths)
+                    m_files[path] = contents;
+            }
+            
+            void addFile(const Path& path, const String& contents) {
+                m_files[path] = contents;
+            }
+            
+            size_t refreshCount() const {
+                return m_refreshCount;
+            }
+        private:
+            Path doMakeAbsolute(const Path& relPath) const {
+                return Path("/") + relPath;
+            }
+            
+            bool doDirectoryExists(const Path& path) const {
+                if (path.isEmpty())
+                    return true;
+                const Path lcPath = path.makeLowerCase();
+                for (const FileMap::value_type& entry : m_files) {
+                    const Path& filePath = entry.first;
+                    if (filePath.length() > lcPath.length() && filePath.prefix(lcPath.length()).makeLowerCase() == lcPath)
+                        return true;
+                }
+                return false;
+            }
+            
+            bool doFileExists(const Path& path) const {
+                return findFile(path) != std::end(m_files);
+            }
+            
+            std::time_t doModificationTime(const Path& path) const {
+                return 0;
+            }
+            
+            void doRefresh() {
+                ++m_refreshCount;
+            }
+            
+            Path::List doGetDirectoryContents(const Path& path) const {
+                Path::List result;
+                const Path lcPath = path.makeLowerCase();
+                for (const FileMap::value_type& entry : m_files) {
+                    const Path& filePath = entry.first;
+                    if (filePath.length() > lcPath.length() && (lcPath.isEmpty() || filePath.prefix(lcPath.length()).makeLowerCase() == lcPath))
+                        result.push_back(filePath.subPath(lcPath.length(), 1));
+                }
+                VectorUtils::sortAndRemoveDuplicates(result);
+                return result;
+            }
+            
+            const MappedFile::Ptr doOpenFile(const Path& path) const {
+                FileMap::const_iterator it = findFile(path);
+                if (it == std::end(m_files))
+                    return MappedFile::Ptr();
+                
+                // the mapped file takes ownership of the buffer
+                const String& contents = it->second;
+                char* buffer = new char[contents.size()];
+                std::copy(std::begin(contents), std::end(contents), buffer);
+                return MappedFile::Ptr(new MappedFileBuffer(it->first, buffer, contents.size()));
+            }
+            
+            FileMap::const_iterator findFile(const Path& path) const {
+                const Path lcPath = path.makeLowerCase();
+                for (FileMap::const_iterator it = std::begin(m_files), end = std::end(m_files); it != end; ++it) {
+                    if (it->first.makeLowerCase() == lcPath)
+                        return it;
+                }
+                return std::end(m_files);
+            }
+        };
+        
+        static Path::List makePaths(const StringList& strings) {
+            Path::List result;
+            for (const String& str : strings)
+                result.push_back(Path(str));
+            return result;
+        }
+        
+        static String readFile(const FileSystem& fs, const Path& path) {
+            const MappedFile::Ptr file = fs.openFile(path);
+            if (file.get() == NULL)
+                return "";
+            return String(file->begin(), file->end());
+        }
+        
+        TEST(FileSystemHierarchyTest, laterFileSystemsOverrideEarlierOnes) {
+            FileSystemHierarchy fs;
+            fs.addFileSystem(new TestFileSystem(makePaths(StringList({ "maps/start.bsp", "gfx/palette.lmp" })), "base"));
+            fs.addFileSystem(new TestFileSystem(makePaths(StringList({ "Gfx/Palette.lmp", "progs/player.mdl" })), "mod"));
+            
+            ASSERT_TRUE(fs.fileExists(Path("maps/start.bsp")));
+            ASSERT_TRUE(fs.fileExists(Path("GFX/PALETTE.LMP")));
+            ASSERT_TRUE(fs.fileExists(Path("progs/player.mdl")));
+            ASSERT_FALSE(fs.fileExists(Path("maps/e1m1.bsp")));
+            ASSERT_FALSE(fs.fileExists(Path("gfx")));
+            
+            ASSERT_TRUE(fs.directoryExists(Path("")));
+            ASSERT_TRUE(fs.directoryExists(Path("MAPS")));
+            ASSERT_TRUE(fs.directoryExists(Path("progs")));
+            ASSERT_FALSE(fs.directoryExists(Path("maps/start.bsp")));
+            ASSERT_FALSE(fs.directoryExists(Path("sound")));
+            
+            ASSERT_EQ(String("base"), readFile(fs, Path("maps/start.bsp")));
+            ASSERT_EQ(String("mod"), readFile(fs, Path("gfx/palette.lmp")));
+            ASSERT_EQ(Path("/progs/player.mdl"), fs.makeAbsolute(Path("progs/player.mdl")));
+        }
+        
+        TEST(FileSystemHierarchyTest, getDirectoryContents) {
+            FileSystemHierarchy fs;
+            fs.addFileSystem(new TestFileSystem(makePaths(StringList({ "maps/start.bsp", "gfx/palette.lmp" })), "base"));
+            fs.addFileSystem(new TestFileSystem(makePaths(StringList({ "gfx/colormap.lmp", "progs/player.mdl" })), "mod"));
+            
+            const Path::List root = fs.getDirectoryContents(Path(""));
+            ASSERT_EQ(makePaths(StringList({ "gfx", "maps", "progs" })), root);
+            
+            const Path::List gfx = fs.getDirectoryContents(Path("GFX"));
+            ASSERT_EQ(makePaths(StringList({ "colormap.lmp", "palette.lmp" })), gfx);
+            
+            ASSERT_THROW(fs.getDirectoryContents(Path("sound")), FileSystemException);
+            ASSERT_EQ(2u, fs.findItemsRecursively(Path(""), FileExtensionMatcher("lmp")).size());
+        }
+        
+        TEST(FileSystemHierarchyTest, addAndClearFileSystems) {
+            FileSystemHierarchy fs;
+            ASSERT_FALSE(fs.directoryExists(Path("")));
+            
+            fs.addFileSystem(new TestFileSystem(makePaths(StringList({ "maps/start.bsp" })), "base"));
+            ASSERT_TRUE(fs.fileExists(Path("maps/start.bsp")));
+            ASSERT_FALSE(fs.fileExists(Path("progs/player.mdl")));
+            
+            fs.addFileSystem(new TestFileSystem(makePaths(StringList({ "progs/player.mdl" })), "mod"));
+            ASSERT_TRUE(fs.fileExists(Path("progs/player.mdl")));
+            
+            fs.clear();
+            ASSERT_FALSE(fs.fileExists(Path("maps/start.bsp")));
+            ASSERT_FALSE(fs.directoryExists(Path("maps")));
+        }
+        
+        TEST(FileSystemHierarchyTest, refreshPicksUpNewFiles) {
+            TestFileSystem* base = new TestFileSystem(makePaths(StringList({ "maps/start.bsp" })), "base");
+            FileSystemHierarchy fs;
+            fs.addFileSystem(base);
+            
+            ASSERT_TRUE(fs.fileExists(Path("maps/start.bsp")));
+            
+            base->addFile(Path("maps/e1m1.bsp"), "base");
+            ASSERT_FALSE(fs.fileExists(Path("maps/e1m1.bsp")));
+            
+            fs.refresh();
+            ASSERT_EQ(1u, base->refreshCount());
+            ASSERT_TRUE(fs.fileExists(Path("maps/e1m1.bsp")));
+        }
+    }
+}
@@ -0,0 +1,80 @@
+/*
+ Copyright (C) 2010-2016 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "IO/MappedFile.h"
+#include "IO/MappedFileCache.h"
+
+#include <cstring>
+
+namespace TrenchBroom {
+    namespace IO {
+        static MappedFile::Ptr createFile(const Path& path, const size_t size) {
+            char* buffer = new char[size];
+            std::memset(buffer, 0, size);
+            return MappedFile::Ptr(new MappedFileBuffer(path, buffer, size));
+        }
+        
+        TEST(MappedFileCacheTest, findAndInsert) {
+            MappedFileCache cache(100);
+            ASSERT_TRUE(cache.find(Path("a")) == NULL);
+            
+            const MappedFile::Ptr a = createFile(Path("a"), 10);
+            cache.insert(Path("a"), a);
+            ASSERT_EQ(a, cache.find(Path("a")));
+            ASSERT_EQ(1u, cache.count());
+            ASSERT_EQ(10u, cache.size());
+            
+            const MappedFile::Ptr b = createFile(Path("a"), 20);
+            cache.insert(Path("a"), b);
+            ASSERT_EQ(b, cache.find(Path("a")));
+            ASSERT_EQ(1u, cache.count());
+            ASSERT_EQ(20u, cache.size());
+            
+            cache.clear();
+            ASSERT_TRUE(cache.find(Path("a")) == NULL);
+            ASSERT_EQ(0u, cache.size());
+        }
+        
+        TEST(MappedFileCacheTest, evictLeastRecentlyUsed) {
+            MappedFileCache cache(100);
+            cache.insert(Path("a"), createFile(Path("a"), 40));
+            cache.insert(Path("b"), createFile(Path("b"), 40));
+            ASSERT_TRUE(cache.find(Path("a")) != NULL);
+            
+            cache.insert(Path("c"), createFile(Path("c"), 40));
+            ASSERT_TRUE(cache.find(Path("a")) != NULL);
+            ASSERT_TRUE(cache.find(Path("b")) == NULL);
+            ASSERT_TRUE(cache.find(Path("c")) != NULL);
+            ASSERT_EQ(80u, cache.size());
+        }
+        
+        TEST(MappedFileCacheTest, skipFilesLargerThanCapacity) {
+            MappedFileCache cache(100);
+            cache.insert(Path("a"), createFile(Path("a"), 40));
+            
+            const MappedFile::Ptr b = createFile(Path("b"), 101);
+            cache.insert(Path("b"), b);
+            ASSERT_TRUE(cache.find(Path("b")) == NULL);
+            ASSERT_TRUE(cache.find(Path("a")) != NULL);
+            ASSERT_EQ(101u, b->size());
+        }
+    }
+}
@@ -351,6 +351,37 @@ namespace TrenchBroom {
                                                                  ));
         }
         
+        TEST(NodeWriterTest, writeNodesWithoutParent) {
+            const BBox3 worldBounds(8192.0);
+            
+            Model::World map(Model::MapFormat::Standard, NULL, worldBounds);
+            map.addOrUpdateAttribute("classname", "worldspawn");
+            
+            Model::BrushBuilder builder(&map, worldBounds);
+            Model::Brush* brush = builder.createCube(64.0, "none");
+            
+            StringStream str;
+            NodeWriter writer(&map, str);
+            writer.writeNodes(Model::NodeList(1, brush));
+            
+            const String result = str.str();
+            ASSERT_STREQ("// entity 0\n"
+                         "{\n"
+                         "\"classname\" \"worldspawn\"\n"
+                         "// brush 0\n"
+                         "{\n"
+                         "( -32 -32 -32 ) ( -32 -31 -32 ) ( -32 -32 -31 ) none 0 0 0 1 1\n"
+                         "( 32 32 32 ) ( 32 32 33 ) ( 32 33 32 ) none 0 0 0 1 1\n"
+                         "( -32 -32 -32 ) ( -32 -32 -31 ) ( -31 -32 -32 ) none 0 0 0 1 1\n"
+                         "( 32 32 32 ) ( 33 32 32 ) ( 32 32 33 ) none 0 0 0 1 1\n"
+                         "( 32 32 32 ) ( 32 33 32 ) ( 33 32 32 ) none 0 0 0 1 1\n"
+                         "( -32 -32 -32 ) ( -31 -32 -32 ) ( -32 -31 -32 ) none 0 0 0 1 1\n"
+                         "}\n"
+                         "}\n", result.c_str());
+            
+            delete brush;
+        }
+        
         TEST(NodeWriterTest, writeFaces) {
             const BBox3 worldBounds(8192.0);
             
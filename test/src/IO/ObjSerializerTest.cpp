@@ -0,0 +1,87 @@
+/*
+ Copyright (C) 2010-2016 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "StringUtils.h"
+#include "IO/NodeWriter.h"
+#include "IO/ObjSerializer.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/Layer.h"
+#include "Model/MapFormat.h"
+#include "Model/World.h"
+
+#include <cstdio>
+
+namespace TrenchBroom {
+    namespace IO {
+        static String exportObj(Model::World& map) {
+            FILE* file = std::tmpfile();
+            assert(file != NULL);
+            
+            NodeWriter writer(&map, new ObjFileSerializer(file));
+            writer.writeMap();
+            
+            String result;
+            std::rewind(file);
+            char buffer[4096];
+            size_t count;
+            while ((count = std::fread(buffer, 1, sizeof(buffer), file)) > 0)
+                result.append(buffer, count);
+            std::fclose(file);
+            return result;
+        }
+        
+        static size_t countLines(const StringList& lines, const String& prefix) {
+            size_t count = 0;
+            for (const String& line : lines) {
+                if (StringUtils::isPrefix(line, prefix))
+                    ++count;
+            }
+            return count;
+        }
+        
+        TEST(ObjSerializerTest, writeSharedVerticesOnce) {
+            const BBox3 worldBounds(8192.0);
+            
+            Model::World map(Model::MapFormat::Standard, NULL, worldBounds);
+            Model::BrushBuilder builder(&map, worldBounds);
+            map.defaultLayer()->addChild(builder.createCuboid(BBox3(Vec3(0.0, 0.0, 0.0), Vec3(64.0, 64.0, 64.0)), "none"));
+            map.defaultLayer()->addChild(builder.createCuboid(BBox3(Vec3(64.0, 0.0, 0.0), Vec3(128.0, 64.0, 64.0)), "none"));
+            
+            const String result = exportObj(map);
+            const StringList lines = StringUtils::split(result, '\n');
+            
+            // the two cubes share one side
+            ASSERT_EQ(12u, countLines(lines, "v "));
+            ASSERT_EQ(6u, countLines(lines, "vn "));
+            ASSERT_EQ(2u, countLines(lines, "o "));
+            ASSERT_EQ(12u, countLines(lines, "f "));
+            
+            // all vertices are listed before any other section
+            ASSERT_EQ(String("# vertices"), lines.front());
+            ASSERT_TRUE(StringUtils::isPrefix(lines[12], "v "));
+            ASSERT_EQ(String(""), lines[13]);
+            ASSERT_EQ(String("# texture coordinates"), lines[14]);
+            ASSERT_TRUE(result.find("o entity0_brush0\n") != String::npos);
+            ASSERT_TRUE(result.find("o entity0_brush1\n") != String::npos);
+        }
+    }
+}
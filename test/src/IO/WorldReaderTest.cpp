@@ -24,6 +24,7 @@
 #include "Model/Brush.h"
 #include "Model/BrushFace.h"
 #include "Model/Entity.h"
+#include "Model/Layer.h"
 #include "Model/World.h"
 
 namespace TrenchBroom {
@@ -116,6 +117,35 @@ namespace TrenchBroom {
             delete world;
         }
 
+        TEST(WorldReaderTest, callWorldspawnCallbackBeforeReadingEntities) {
+            const String data("{"
+                              "\"classname\" \"worldspawn\""
+                              "\"wad\" \"cr8_czg.wad\""
+                              "}"
+                              "{"
+                              "\"classname\" \"info_player_deathmatch\""
+                              "\"origin\" \"1 22 -3\""
+                              "}");
+            BBox3 worldBounds(8192);
+            
+            IO::TestParserStatus status;
+            WorldReader reader(data, NULL);
+            
+            size_t callCount = 0;
+            reader.setWorldspawnCallback([&callCount](const Model::World* world) {
+                ++callCount;
+                ASSERT_STREQ("cr8_czg.wad", world->attribute("wad").c_str());
+                ASSERT_FALSE(world->defaultLayer()->hasChildren());
+            });
+            
+            Model::World* world = reader.read(Model::MapFormat::Standard, worldBounds, status);
+            
+            ASSERT_EQ(1u, callCount);
+            ASSERT_EQ(1u, world->defaultLayer()->childCount());
+            
+            delete world;
+        }
+        
         TEST(WorldReaderTest, parseMapWithWorldspawnAndOneMoreEntity) {
             const String data("{"
                               "\"classname\" \"worldspawn\""
@@ -27,6 +27,7 @@
 
 #include <cstdlib>
 #include <ctime>
+#include <random>
 
 TEST(MatTest, nullMatrix) {
     const Mat4x4d& m = Mat4x4d::Null;
@@ -860,3 +861,53 @@ TEST(MatTest, scalingMatrix) {
         }
     }
 }
+
+template <typename T>
+static Mat<T,4,4> projectiveTestMatrix() {
+    Mat<T,4,4> m = translationMatrix(Vec<T,3>(static_cast<T>(12.5), static_cast<T>(-3.0), static_cast<T>(7.25))) *
+                   rotationMatrix(static_cast<T>(0.3), static_cast<T>(-1.1), static_cast<T>(2.4)) *
+                   scalingMatrix(Vec<T,3>(static_cast<T>(2.0), static_cast<T>(0.5), static_cast<T>(-1.5)));
+    m[0][3] = static_cast<T>(0.001);
+    m[2][3] = static_cast<T>(-0.002);
+    return m;
+}
+
+template <typename T>
+static typename Vec<T,3>::List randomTestPoints(const size_t count) {
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<T> distribution(static_cast<T>(-256.0), static_cast<T>(256.0));
+    
+    typename Vec<T,3>::List points;
+    for (size_t i = 0; i < count; ++i)
+        points.push_back(Vec<T,3>(distribution(generator), distribution(generator), distribution(generator)));
+    return points;
+}
+
+template <typename T>
+static void assertTransformPointsMatchesPointTransformation() {
+    const Mat<T,4,4> m = projectiveTestMatrix<T>();
+    const typename Vec<T,3>::List points = randomTestPoints<T>(101);
+    
+    typename Vec<T,3>::List transformed(points.size());
+    transformPoints(m, &points.front(), points.size(), &transformed.front());
+    
+    const typename Vec<T,3>::List multiplied = m * points;
+    
+    typename Vec<T,3>::List inPlace = points;
+    transformPoints(m, &inPlace.front(), inPlace.size(), &inPlace.front());
+    
+    for (size_t i = 0; i < points.size(); ++i) {
+        const Vec<T,3> expected = m * points[i];
+        ASSERT_EQ(expected, transformed[i]);
+        ASSERT_EQ(expected, multiplied[i]);
+        ASSERT_EQ(expected, inPlace[i]);
+    }
+}
+
+TEST(MatTest, transformPointsd) {
+    assertTransformPointsMatchesPointTransformation<double>();
+}
+
+TEST(MatTest, transformPointsf) {
+    assertTransformPointsMatchesPointTransformation<float>();
+}
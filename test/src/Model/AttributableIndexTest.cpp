@@ -20,6 +20,7 @@
 #include <gtest/gtest.h>
 
 #include "CollectionUtils.h"
+#include "TestUtils.h"
 #include "Model/AttributableNode.h"
 #include "Model/AttributableNodeIndex.h"
 #include "Model/Entity.h"
@@ -177,5 +178,83 @@ namespace TrenchBroom {
             
             delete entity1;
         }
+        
+        TEST(EntityAttributeIndexTest, findNumberedAttributeWithMultipleMatches) {
+            AttributableNodeIndex index;
+            
+            Entity* entity1 = new Entity();
+            entity1->addOrUpdateAttribute("target", "somevalue");
+            entity1->addOrUpdateAttribute("target2", "somevalue");
+            entity1->addOrUpdateAttribute("targetname", "somevalue");
+            
+            Entity* entity2 = new Entity();
+            entity2->addOrUpdateAttribute("targetname", "somevalue");
+            
+            index.addAttributableNode(entity1);
+            index.addAttributableNode(entity2);
+            
+            AttributableNodeList attributables = findNumberedExact(index, "target", "somevalue");
+            ASSERT_EQ(1u, attributables.size());
+            ASSERT_EQ(entity1, attributables.front());
+            
+            attributables = index.findAttributableNodes(AttributableNodeIndexQuery::prefix("target"), "somevalue");
+            ASSERT_EQ(2u, attributables.size());
+            ASSERT_TRUE(VectorUtils::contains(attributables, entity1));
+            ASSERT_TRUE(VectorUtils::contains(attributables, entity2));
+            
+            index.removeAttributableNode(entity1);
+            attributables = findNumberedExact(index, "target", "somevalue");
+            ASSERT_TRUE(attributables.empty());
+            
+            delete entity1;
+            delete entity2;
+        }
+        
+        static String numbered(const String& prefix, const size_t i) {
+            StringStream str;
+            str << prefix << i;
+            return str.str();
+        }
+        
+        TEST(EntityAttributeIndexTest, DISABLED_benchmarkAddQueryRemove) {
+            const size_t count = 20000;
+            
+            AttributableNodeList entities;
+            entities.reserve(count);
+            for (size_t i = 0; i < count; ++i) {
+                Entity* entity = new Entity();
+                entity->addOrUpdateAttribute("classname", i % 2 == 0 ? "light" : "info_notnull");
+                entity->addOrUpdateAttribute("origin", numbered("0 0 ", i));
+                entity->addOrUpdateAttribute("targetname", numbered("t", i));
+                entity->addOrUpdateAttribute("target", numbered("t", i + 1));
+                entity->addOrUpdateAttribute("light", "300");
+                entity->addOrUpdateAttribute("spawnflags", "1");
+                entities.push_back(entity);
+            }
+            
+            AttributableNodeIndex index;
+            
+            measureTime("addMs", [&]() {
+                for (AttributableNode* entity : entities)
+                    index.addAttributableNode(entity);
+            });
+            
+            size_t found = 0;
+            measureTime("queryMs", [&]() {
+                for (size_t i = 0; i < count; ++i) {
+                    found += findExactExact(index, "targetname", numbered("t", i)).size();
+                    found += findNumberedExact(index, "target", numbered("t", i)).size();
+                }
+            });
+            ASSERT_EQ(2 * count - 1, found);
+            
+            measureTime("removeMs", [&]() {
+                for (AttributableNode* entity : entities)
+                    index.removeAttributableNode(entity);
+            });
+            ASSERT_TRUE(findExactExact(index, "classname", "light").empty());
+            
+            VectorUtils::clearAndDelete(entities);
+        }
     }
 }
@@ -0,0 +1,100 @@
+/*
+ Copyright (C) 2010-2016 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "CollectionUtils.h"
+#include "Model/AttributableLinkIndex.h"
+#include "Model/Entity.h"
+#include "Model/EntityAttributes.h"
+
+namespace TrenchBroom {
+    namespace Model {
+        TEST(AttributableLinkIndexTest, findLinkPartners) {
+            AttributableLinkIndex index;
+            
+            Entity* source = new Entity();
+            Entity* target = new Entity();
+            
+            index.addAttribute(source, AttributeNames::Target, "a");
+            index.addAttribute(source, AttributeNames::Killtarget + "2", "b");
+            index.addAttribute(target, AttributeNames::Targetname, "a");
+            index.addAttribute(target, "target_", "a");
+            index.addAttribute(target, "message", "a");
+            
+            AttributableNodeList result;
+            index.findNodesWithTargetname("a", result);
+            ASSERT_EQ(1u, result.size());
+            ASSERT_EQ(target, result.front());
+            
+            result.clear();
+            index.findNodesWithTarget("a", result);
+            ASSERT_EQ(1u, result.size());
+            ASSERT_EQ(source, result.front());
+            
+            result.clear();
+            index.findNodesWithKilltarget("b", result);
+            ASSERT_EQ(1u, result.size());
+            ASSERT_EQ(source, result.front());
+            
+            result.clear();
+            index.findNodesWithTarget("b", result);
+            index.findNodesWithTargetname("b", result);
+            ASSERT_TRUE(result.empty());
+            
+            delete source;
+            delete target;
+        }
+        
+        TEST(AttributableLinkIndexTest, removeAttribute) {
+            AttributableLinkIndex index;
+            
+            Entity* entity1 = new Entity();
+            Entity* entity2 = new Entity();
+            
+            index.addAttribute(entity1, AttributeNames::Target, "a");
+            index.addAttribute(entity1, AttributeNames::Target + "2", "a");
+            index.addAttribute(entity2, AttributeNames::Target, "a");
+            
+            AttributableNodeList result;
+            index.findNodesWithTarget("a", result);
+            ASSERT_EQ(2u, result.size());
+            ASSERT_TRUE(VectorUtils::contains(result, entity1));
+            ASSERT_TRUE(VectorUtils::contains(result, entity2));
+            
+            // entity1 still links to "a" through its other target attribute
+            index.removeAttribute(entity1, AttributeNames::Target, "a");
+            index.removeAttribute(entity2, AttributeNames::Target, "a");
+            
+            result.clear();
+            index.findNodesWithTarget("a", result);
+            ASSERT_EQ(1u, result.size());
+            ASSERT_EQ(entity1, result.front());
+            
+            index.removeAttribute(entity1, AttributeNames::Target + "2", "a");
+            
+            result.clear();
+            index.findNodesWithTarget("a", result);
+            ASSERT_TRUE(result.empty());
+            
+            delete entity1;
+            delete entity2;
+        }
+    }
+}
@@ -36,6 +36,7 @@
 #include "Model/World.h"
 
 #include <algorithm>
+#include <random>
 
 namespace TrenchBroom {
     namespace Model {
@@ -471,6 +472,116 @@ namespace TrenchBroom {
             ASSERT_TRUE(hits2.empty());
         }
         
+        static Brush* createRoundBrush(const BrushBuilder& builder, const FloatType radius) {
+            Vec3::List points;
+            for (size_t i = 0; i <= 8; ++i) {
+                const FloatType latitude = Math::C::pi() * static_cast<FloatType>(i) / 8.0 - Math::C::piOverTwo();
+                for (size_t j = 0; j < 16; ++j) {
+                    const FloatType longitude = Math::C::twoPi() * static_cast<FloatType>(j) / 16.0;
+                    const Vec3 point(std::cos(latitude) * std::cos(longitude),
+                                     std::cos(latitude) * std::sin(longitude),
+                                     std::sin(latitude));
+                    points.push_back((radius * point).rounded());
+                }
+            }
+            return builder.createBrush(points, "");
+        }
+        
+        static std::vector<Ray3> createRaysTowardsCenter(const size_t count, const FloatType distance, const FloatType spread) {
+            std::mt19937 generator(11);
+            std::uniform_real_distribution<FloatType> coordinates(-1.0, 1.0);
+            
+            std::vector<Ray3> rays;
+            while (rays.size() < count) {
+                const Vec3 direction(coordinates(generator), coordinates(generator), coordinates(generator));
+                if (direction.null())
+                    continue;
+                const Vec3 origin = direction.normalized() * distance;
+                const Vec3 target(spread * coordinates(generator), spread * coordinates(generator), spread * coordinates(generator));
+                rays.push_back(Ray3(origin, (target - origin).normalized()));
+            }
+            return rays;
+        }
+        
+        static BrushFace* findFaceHitByPolygons(const Brush* brush, const Ray3& ray, FloatType& distance) {
+            if (Math::isnan(brush->bounds().intersectWithRay(ray)))
+                return NULL;
+            for (BrushFace* face : brush->faces()) {
+                distance = face->intersectWithRay(ray);
+                if (!Math::isnan(distance))
+                    return face;
+            }
+            return NULL;
+        }
+        
+        TEST(BrushTest, pickMatchesFacePolygonIntersection) {
+            const BBox3 worldBounds(4096.0);
+            World world(MapFormat::Standard, NULL, worldBounds);
+            const BrushBuilder builder(&world, worldBounds);
+            
+            Brush* brush = createRoundBrush(builder, 128.0);
+            const std::vector<Ray3> rays = createRaysTowardsCenter(1000, 512.0, 192.0);
+            
+            size_t hitCount = 0;
+            for (const Ray3& ray : rays) {
+                PickResult hits;
+                brush->pick(ray, hits);
+                
+                FloatType expectedDistance;
+                BrushFace* expectedFace = findFaceHitByPolygons(brush, ray, expectedDistance);
+                if (expectedFace == NULL) {
+                    ASSERT_TRUE(hits.empty());
+                } else {
+                    ASSERT_EQ(1u, hits.size());
+                    const Hit& hit = hits.all().front();
+                    ASSERT_EQ(expectedFace, hit.target<BrushFace*>());
+                    ASSERT_NEAR(expectedDistance, hit.distance(), 0.0001);
+                    ++hitCount;
+                }
+            }
+            
+            ASSERT_LT(0u, hitCount);
+            ASSERT_GT(rays.size(), hitCount);
+            
+            // rays starting inside the brush do not hit it
+            PickResult hits;
+            brush->pick(Ray3(Vec3::Null, Vec3::PosX), hits);
+            ASSERT_TRUE(hits.empty());
+            
+            delete brush;
+        }
+        
+        TEST(BrushTest, DISABLED_pickBenchmark) {
+            const BBox3 worldBounds(4096.0);
+            World world(MapFormat::Standard, NULL, worldBounds);
+            const BrushBuilder builder(&world, worldBounds);
+            
+            Brush* brush = createRoundBrush(builder, 128.0);
+            const std::vector<Ray3> rays = createRaysTowardsCenter(100000, 512.0, 192.0);
+            
+            size_t planeHits = 0;
+            measureTime("facePlanesMs", [&]() {
+                for (const Ray3& ray : rays) {
+                    if (!Math::isnan(brush->intersectWithRay(ray)))
+                        ++planeHits;
+                }
+            });
+            
+            size_t polygonHits = 0;
+            measureTime("facePolygonsMs", [&]() {
+                for (const Ray3& ray : rays) {
+                    FloatType distance;
+                    if (findFaceHitByPolygons(brush, ray, distance) != NULL)
+                        ++polygonHits;
+                }
+            });
+            
+            // rays that graze an edge may be classified differently by the two tests
+            ASSERT_NEAR(static_cast<double>(polygonHits), static_cast<double>(planeHits), rays.size() / 1000.0);
+            
+            delete brush;
+        }
+        
         TEST(BrushTest, partialSelectionAfterAdd) {
             const BBox3 worldBounds(4096.0);
             
@@ -642,6 +753,63 @@ namespace TrenchBroom {
             delete clone;
         }
         
+        static void assertSameGeometry(const Brush& expected, const Brush& actual) {
+            ASSERT_EQ(expected.bounds(), actual.bounds());
+            ASSERT_EQ(expected.vertexCount(), actual.vertexCount());
+            ASSERT_EQ(expected.edgeCount(), actual.edgeCount());
+            for (const BrushVertex* vertex : expected.vertices())
+                ASSERT_TRUE(actual.hasVertex(vertex->position()));
+            
+            ASSERT_EQ(expected.faceCount(), actual.faceCount());
+            for (const BrushFace* face : actual.faces()) {
+                ASSERT_EQ(&actual, face->brush());
+                ASSERT_TRUE(face->geometry() != NULL);
+                ASSERT_EQ(face, face->geometry()->payload());
+                ASSERT_TRUE(expected.findFace(face->polygon()) != NULL);
+            }
+        }
+        
+        TEST(BrushTest, cloneCopiesGeometry) {
+            const BBox3 worldBounds(4096.0);
+            World world(MapFormat::Standard, NULL, worldBounds);
+            const BrushBuilder builder(&world, worldBounds);
+            
+            // a brush whose geometry was edited directly
+            Brush* original = builder.createCube(64.0, "");
+            original->moveVertices(worldBounds, Vec3::List(1, Vec3(32.0, 32.0, 32.0)), Vec3(-16.0, -16.0, 0.0));
+            
+            Brush* clone = original->clone(worldBounds);
+            assertSameGeometry(*original, *clone);
+            
+            // the clone's geometry is independent of the original's
+            clone->moveVertices(worldBounds, Vec3::List(1, Vec3(-32.0, -32.0, -32.0)), Vec3(-16.0, 0.0, 0.0));
+            ASSERT_TRUE(original->hasVertex(Vec3(-32.0, -32.0, -32.0)));
+            ASSERT_FALSE(clone->hasVertex(Vec3(-32.0, -32.0, -32.0)));
+            
+            delete clone;
+            delete original;
+        }
+        
+        TEST(BrushTest, snapshotRestoresGeometry) {
+            const BBox3 worldBounds(4096.0);
+            World world(MapFormat::Standard, NULL, worldBounds);
+            const BrushBuilder builder(&world, worldBounds);
+            
+            Brush* brush = builder.createCube(64.0, "");
+            Brush* expected = brush->clone(worldBounds);
+            
+            NodeSnapshot* snapshot = brush->takeSnapshot();
+            brush->moveVertices(worldBounds, Vec3::List(1, Vec3(32.0, 32.0, 32.0)), Vec3(-16.0, -16.0, 0.0));
+            ASSERT_FALSE(brush->hasVertex(Vec3(32.0, 32.0, 32.0)));
+            
+            snapshot->restore(worldBounds);
+            assertSameGeometry(*expected, *brush);
+            
+            delete snapshot;
+            delete expected;
+            delete brush;
+        }
+        
         TEST(BrushTest, clip) {
             const BBox3 worldBounds(4096.0);
             
@@ -688,6 +856,76 @@ namespace TrenchBroom {
             assertHasFace(brush, *bottom);
         }
         
+        TEST(BrushTest, clipGeometry) {
+            const BBox3 worldBounds(4096.0);
+            
+            // build a cube with length 16 at the origin
+            BrushFace* left = BrushFace::createParaxial(Vec3(0.0, 0.0, 0.0),
+                                                        Vec3(0.0, 1.0, 0.0),
+                                                        Vec3(0.0, 0.0, 1.0));
+            BrushFace* right = BrushFace::createParaxial(Vec3(16.0, 0.0, 0.0),
+                                                         Vec3(16.0, 0.0, 1.0),
+                                                         Vec3(16.0, 1.0, 0.0));
+            BrushFace* front = BrushFace::createParaxial(Vec3(0.0, 0.0, 0.0),
+                                                         Vec3(0.0, 0.0, 1.0),
+                                                         Vec3(1.0, 0.0, 0.0));
+            BrushFace* back = BrushFace::createParaxial(Vec3(0.0, 16.0, 0.0),
+                                                        Vec3(1.0, 16.0, 0.0),
+                                                        Vec3(0.0, 16.0, 1.0));
+            BrushFace* top = BrushFace::createParaxial(Vec3(0.0, 0.0, 16.0),
+                                                       Vec3(0.0, 1.0, 16.0),
+                                                       Vec3(1.0, 0.0, 16.0));
+            BrushFace* bottom = BrushFace::createParaxial(Vec3(0.0, 0.0, 0.0),
+                                                          Vec3(1.0, 0.0, 0.0),
+                                                          Vec3(0.0, 1.0, 0.0));
+            BrushFace* clip = BrushFace::createParaxial(Vec3(8.0, 0.0, 0.0),
+                                                        Vec3(8.0, 0.0, 1.0),
+                                                        Vec3(8.0, 1.0, 0.0));
+            
+            BrushFaceList faces;
+            faces.push_back(left);
+            faces.push_back(right);
+            faces.push_back(front);
+            faces.push_back(back);
+            faces.push_back(top);
+            faces.push_back(bottom);
+            
+            const Brush brush(worldBounds, faces);
+            
+            BrushGeometry* geometry = brush.clipGeometry(clip->boundary());
+            ASSERT_TRUE(geometry != NULL);
+            
+            Brush* clipped = brush.createClippedBrush(geometry, clip);
+            ASSERT_EQ(6u, clipped->faces().size());
+            assertHasFace(*clipped, *left);
+            assertHasFace(*clipped, *clip);
+            assertHasFace(*clipped, *front);
+            assertHasFace(*clipped, *back);
+            assertHasFace(*clipped, *top);
+            assertHasFace(*clipped, *bottom);
+            ASSERT_EQ(BBox3(Vec3(0.0, 0.0, 0.0), Vec3(8.0, 16.0, 16.0)), clipped->bounds());
+            
+            // the original brush is left alone
+            ASSERT_EQ(6u, brush.faces().size());
+            ASSERT_EQ(BBox3(Vec3(0.0, 0.0, 0.0), Vec3(16.0, 16.0, 16.0)), brush.bounds());
+            
+            // a plane below the brush removes it completely
+            ASSERT_TRUE(brush.clipGeometry(Plane3(-8.0, Vec3::PosX)) == NULL);
+            
+            // a plane above the brush leaves it unchanged, and the unused clip face is discarded
+            BrushGeometry* unchanged = brush.clipGeometry(Plane3(32.0, Vec3::PosX));
+            ASSERT_TRUE(unchanged != NULL);
+            
+            Brush* copy = brush.createClippedBrush(unchanged, BrushFace::createParaxial(Vec3(32.0, 0.0, 0.0),
+                                                                                       Vec3(32.0, 0.0, 1.0),
+                                                                                       Vec3(32.0, 1.0, 0.0)));
+            ASSERT_EQ(6u, copy->faces().size());
+            ASSERT_EQ(brush.bounds(), copy->bounds());
+            
+            delete copy;
+            delete clipped;
+        }
+        
         TEST(BrushTest, moveBoundary) {
             const BBox3 worldBounds(4096.0);
             
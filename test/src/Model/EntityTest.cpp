@@ -0,0 +1,53 @@
+/*
+ Copyright (C) 2010-2016 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Assets/EntityDefinition.h"
+#include "Assets/ModelDefinition.h"
+#include "IO/ELParser.h"
+#include "Model/Entity.h"
+
+namespace TrenchBroom {
+    namespace Model {
+        TEST(EntityTest, modelSpecificationFollowsAttributesAndDefinition) {
+            const Assets::ModelDefinition modelDefinition(IO::ELParser::parse("{ 'path': model, 'skin': skin }"));
+            Assets::PointEntityDefinition definition("monster", Color(), BBox3(8.0), "", Assets::AttributeDefinitionList(), modelDefinition);
+            
+            Entity* entity = new Entity();
+            ASSERT_EQ(Assets::ModelSpecification(), entity->modelSpecification());
+            
+            entity->setDefinition(&definition);
+            entity->addOrUpdateAttribute("model", "progs/ogre.mdl");
+            ASSERT_EQ(Assets::ModelSpecification(IO::Path("progs/ogre.mdl")), entity->modelSpecification());
+            ASSERT_EQ(Assets::ModelSpecification(IO::Path("progs/ogre.mdl")), entity->modelSpecification());
+            
+            entity->addOrUpdateAttribute("skin", "1");
+            ASSERT_EQ(Assets::ModelSpecification(IO::Path("progs/ogre.mdl"), 1), entity->modelSpecification());
+            
+            entity->removeAttribute("skin");
+            ASSERT_EQ(Assets::ModelSpecification(IO::Path("progs/ogre.mdl")), entity->modelSpecification());
+            
+            entity->setDefinition(NULL);
+            ASSERT_EQ(Assets::ModelSpecification(), entity->modelSpecification());
+            
+            delete entity;
+        }
+    }
+}
@@ -44,6 +44,7 @@ namespace TrenchBroom {
         
         void TestGame::doSetGamePath(const IO::Path& gamePath) {}
         void TestGame::doSetAdditionalSearchPaths(const IO::Path::List& searchPaths) {}
+        void TestGame::doRefreshFileSystem() {}
         
         CompilationConfig& TestGame::doCompilationConfig() {
             static CompilationConfig config;
@@ -58,7 +59,7 @@ namespace TrenchBroom {
             return new World(format, brushContentTypeBuilder(), worldBounds);
         }
         
-        World* TestGame::doLoadMap(const MapFormat::Type format, const BBox3& worldBounds, const IO::Path& path, Logger* logger) const {
+        World* TestGame::doLoadMap(const MapFormat::Type format, const BBox3& worldBounds, const IO::Path& path, Logger* logger, const WorldspawnCallback& worldspawnCallback) const {
             return new World(format, brushContentTypeBuilder(), worldBounds);
         }
         
@@ -108,6 +109,10 @@ namespace TrenchBroom {
             textureLoader.loadTextures(paths, textureManager);
         }
         
+        Assets::TextureCollectionList TestGame::doReadTextureCollections(const EL::VariableStore& variables, const IO::Path& documentPath, const IO::Path::List& paths, Logger* logger) const {
+            return Assets::TextureCollectionList();
+        }
+        
         bool TestGame::doIsTextureCollection(const IO::Path& path) const {
             return false;
         }
@@ -36,12 +36,13 @@ namespace TrenchBroom {
             IO::Path doGamePath() const;
             void doSetGamePath(const IO::Path& gamePath);
             void doSetAdditionalSearchPaths(const IO::Path::List& searchPaths);
+            void doRefreshFileSystem();
 
             CompilationConfig& doCompilationConfig();
             size_t doMaxPropertyLength() const;
             
             World* doNewMap(MapFormat::Type format, const BBox3& worldBounds) const;
-            World* doLoadMap(MapFormat::Type format, const BBox3& worldBounds, const IO::Path& path, Logger* logger) const;
+            World* doLoadMap(MapFormat::Type format, const BBox3& worldBounds, const IO::Path& path, Logger* logger, const WorldspawnCallback& worldspawnCallback) const;
             void doWriteMap(World* world, const IO::Path& path) const;
             void doExportMap(World* world, Model::ExportFormat format, const IO::Path& path) const;
             
@@ -52,6 +53,7 @@ namespace TrenchBroom {
             
             TexturePackageType doTexturePackageType() const;
             void doLoadTextureCollections(World* world, const IO::Path& documentPath, Assets::TextureManager& textureManager) const;
+            Assets::TextureCollectionList doReadTextureCollections(const EL::VariableStore& variables, const IO::Path& documentPath, const IO::Path::List& paths, Logger* logger) const;
             bool doIsTextureCollection(const IO::Path& path) const;
             IO::Path::List doFindTextureCollections() const;
             IO::Path::List doExtractTextureCollections(const World* world) const;
@@ -0,0 +1,91 @@
+/*
+ Copyright (C) 2010-2016 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "ParallelUtils.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+TEST(ParallelUtilsTest, parallelForVisitsEveryIndexOnce) {
+    const size_t count = 10000;
+    std::vector<size_t> visits(count, 0);
+    
+    ParallelUtils::parallelFor(count, 4, [&](const size_t i) { ++visits[i]; });
+    
+    for (size_t i = 0; i < count; ++i)
+        ASSERT_EQ(1u, visits[i]);
+}
+
+TEST(ParallelUtilsTest, parallelForWithNoTasks) {
+    std::atomic<size_t> calls(0);
+    ParallelUtils::parallelFor(0, [&](const size_t i) { ++calls; });
+    ASSERT_EQ(0u, calls.load());
+}
+
+TEST(ParallelUtilsTest, parallelForRethrowsException) {
+    ASSERT_THROW(ParallelUtils::parallelFor(100, 4, [](const size_t i) {
+        if (i == 42)
+            throw std::runtime_error("failed");
+    }), std::runtime_error);
+}
+
+TEST(ParallelUtilsTest, parallelForCanBeNested) {
+    const size_t count = 64;
+    std::vector<size_t> visits(count * count, 0);
+    
+    ParallelUtils::parallelFor(count, 4, [&](const size_t i) {
+        ParallelUtils::parallelFor(count, 4, [&](const size_t j) { ++visits[i * count + j]; });
+    });
+    
+    for (size_t i = 0; i < count * count; ++i)
+        ASSERT_EQ(1u, visits[i]);
+}
+
+TEST(ParallelUtilsTest, threadPoolReusesItsThreads) {
+    ParallelUtils::ThreadPool pool(2);
+    ASSERT_EQ(2u, pool.threadCount());
+    
+    const size_t count = 100;
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::set<std::thread::id> threadIds;
+    size_t done = 0;
+    
+    for (size_t i = 0; i < count; ++i) {
+        pool.submit([&]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            threadIds.insert(std::this_thread::get_id());
+            if (++done == count)
+                finished.notify_all();
+        });
+    }
+    
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [&]() { return done == count; });
+    
+    ASSERT_LE(threadIds.size(), 2u);
+    ASSERT_EQ(0u, threadIds.count(std::this_thread::get_id()));
+}
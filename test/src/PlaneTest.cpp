@@ -24,6 +24,8 @@
 #include "MathUtils.h"
 #include "TestUtils.h"
 
+#include <random>
+
 TEST(PlaneTest, constructDefault) {
     const Plane3f p;
     ASSERT_EQ(0.0f, p.distance);
@@ -252,3 +254,42 @@ TEST(PlaneTest, alignedOrthogonalDragPlane) {
     ASSERT_TRUE(p.pointStatus(position) == Math::PointStatus::PSInside);
     ASSERT_VEC_EQ(direction.firstAxis(), p.normal);
 }
+
+template <typename T>
+static void assertClassifyPointsMatchesPointStatus() {
+    const Plane<T,3> plane(static_cast<T>(17.0), Vec<T,3>(static_cast<T>(1.0), static_cast<T>(-2.0), static_cast<T>(0.5)).normalized());
+    const T epsilon = Math::Constants<T>::pointStatusEpsilon();
+    
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<T> coordinates(static_cast<T>(-64.0), static_cast<T>(64.0));
+    std::uniform_int_distribution<int> offsets(-3, 3);
+    
+    // points close to the plane at offsets of up to three times the epsilon, so that all statuses occur
+    typename Vec<T,3>::List points;
+    for (size_t i = 0; i < 103; ++i) {
+        const Vec<T,3> point(coordinates(generator), coordinates(generator), coordinates(generator));
+        const T distance = static_cast<T>(offsets(generator)) * epsilon;
+        points.push_back(point - plane.normal * (plane.pointDistance(point) - distance));
+    }
+    
+    std::vector<Math::PointStatus::Type> statuses(points.size());
+    classifyPoints(plane, &points.front(), points.size(), &statuses.front());
+    
+    size_t counts[3] = { 0, 0, 0 };
+    for (size_t i = 0; i < points.size(); ++i) {
+        ASSERT_EQ(plane.pointStatus(points[i]), statuses[i]);
+        ++counts[statuses[i]];
+    }
+    
+    ASSERT_LT(0u, counts[Math::PointStatus::PSAbove]);
+    ASSERT_LT(0u, counts[Math::PointStatus::PSBelow]);
+    ASSERT_LT(0u, counts[Math::PointStatus::PSInside]);
+}
+
+TEST(PlaneTest, classifyPointsd) {
+    assertClassifyPointsMatchesPointStatus<double>();
+}
+
+TEST(PlaneTest, classifyPointsf) {
+    assertClassifyPointsMatchesPointStatus<float>();
+}
@@ -24,8 +24,11 @@
 #include "Polyhedron.h"
 #include "Polyhedron_DefaultPayload.h"
 #include "MathUtils.h"
+#include "ParallelUtils.h"
 #include "TestUtils.h"
 
+#include <random>
+
 typedef Polyhedron<double, DefaultPolyhedronPayload, DefaultPolyhedronPayload> Polyhedron3d;
 typedef Polyhedron3d::Vertex Vertex;
 typedef Polyhedron3d::VertexList VertexList;
@@ -1392,6 +1395,153 @@ TEST(PolyhedronTest, crashWhileAddingPoints5) {
     p.addPoint(p2); // Assertion failure here - re-adding p2
 }
 
+static Vec3d::List randomPointsInBall(const size_t count, const double radius, const unsigned int seed) {
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<double> distribution(-radius, radius);
+    
+    Vec3d::List result;
+    result.reserve(count);
+    while (result.size() < count) {
+        const Vec3d point(distribution(generator), distribution(generator), distribution(generator));
+        if (point.squaredLength() <= radius * radius)
+            result.push_back(point);
+    }
+    return result;
+}
+
+static bool hasSameVertices(const Polyhedron3d& lhs, const Polyhedron3d& rhs) {
+    if (lhs.vertexCount() != rhs.vertexCount())
+        return false;
+    
+    const Vertex* first = lhs.vertices().front();
+    const Vertex* current = first;
+    do {
+        if (!rhs.hasVertex(current->position()))
+            return false;
+        current = current->next();
+    } while (current != first);
+    return true;
+}
+
+TEST(PolyhedronTest, quickHullOfCubeWithInnerAndDuplicatePoints) {
+    const BBox3d bounds(Vec3d(-8.0, -8.0, -8.0), Vec3d(8.0, 8.0, 8.0));
+    
+    Vec3d::List points;
+    for (size_t i = 0; i < 8; ++i) {
+        const Vec3d corner((i & 1) ? bounds.max.x() : bounds.min.x(),
+                           (i & 2) ? bounds.max.y() : bounds.min.y(),
+                           (i & 4) ? bounds.max.z() : bounds.min.z());
+        points.push_back(corner);
+        points.push_back(corner);
+        points.push_back(corner / 2.0);
+    }
+    points.push_back(Vec3d::Null);
+    points.push_back(Vec3d(8.0, 0.0, 0.0));
+    points.push_back(Vec3d(8.0, 8.0, 0.0));
+    
+    const Polyhedron3d p(points);
+    ASSERT_TRUE(p.closed());
+    ASSERT_EQ(8u, p.vertexCount());
+    ASSERT_EQ(12u, p.edgeCount());
+    ASSERT_EQ(6u, p.faceCount());
+    ASSERT_EQ(bounds, p.bounds());
+    ASSERT_TRUE(p == Polyhedron3d(bounds));
+}
+
+TEST(PolyhedronTest, quickHullOfCoplanarPoints) {
+    Vec3d::List points;
+    points.push_back(Vec3d(0.0, 0.0, 0.0));
+    points.push_back(Vec3d(8.0, 0.0, 0.0));
+    points.push_back(Vec3d(8.0, 8.0, 0.0));
+    points.push_back(Vec3d(0.0, 8.0, 0.0));
+    points.push_back(Vec3d(4.0, 4.0, 0.0));
+    points.push_back(Vec3d(8.0, 8.0, 0.0));
+    
+    const Polyhedron3d p(points);
+    ASSERT_TRUE(p.polygon());
+    ASSERT_EQ(4u, p.vertexCount());
+}
+
+TEST(PolyhedronTest, quickHullMatchesIncrementalHull) {
+    const Vec3d::List points = randomPointsInBall(500, 512.0, 1);
+    
+    Polyhedron3d incremental;
+    for (const Vec3d& point : points)
+        incremental.addPoint(point);
+    
+    const Polyhedron3d batch(points);
+    ASSERT_TRUE(batch.closed());
+    ASSERT_TRUE(hasSameVertices(incremental, batch));
+    ASSERT_EQ(incremental.faceCount(), batch.faceCount());
+    ASSERT_EQ(incremental.edgeCount(), batch.edgeCount());
+    
+    for (const Vec3d& point : points)
+        ASSERT_TRUE(batch.contains(point));
+}
+
+TEST(PolyhedronTest, DISABLED_quickHullBenchmark) {
+    const Vec3d::List points = randomPointsInBall(10000, 4096.0, 2);
+    
+    Polyhedron3d batch;
+    TrenchBroom::measureTime("quickhullMs", [&]() {
+        batch = Polyhedron3d(points);
+    });
+    
+    Polyhedron3d incremental;
+    TrenchBroom::measureTime("incrementalMs", [&]() {
+        for (const Vec3d& point : points)
+            incremental.addPoint(point);
+    });
+    
+    ASSERT_TRUE(batch.closed());
+    ASSERT_TRUE(hasSameVertices(incremental, batch));
+}
+
+TEST(PolyhedronTest, buildAndDestroyOnDifferentThreads) {
+    const size_t count = 2000;
+    std::vector<Polyhedron3d*> polyhedra(count, NULL);
+    
+    ParallelUtils::parallelFor(count, 4, [&](const size_t i) {
+        const double size = static_cast<double>(i % 64 + 1);
+        Polyhedron3d* polyhedron = new Polyhedron3d(BBox3d(Vec3d(-size, -size, -size), Vec3d(size, size, size)));
+        polyhedron->addPoint(Vec3d(0.0, 0.0, 2.0 * size));
+        polyhedra[i] = polyhedron;
+    });
+    
+    for (size_t i = 0; i < count; ++i) {
+        const Polyhedron3d copy(*polyhedra[i]);
+        ASSERT_TRUE(copy.closed());
+        ASSERT_EQ(9u, copy.vertexCount());
+        ASSERT_TRUE(copy == *polyhedra[i]);
+    }
+    
+    // delete half of the polyhedra on worker threads and the rest on this thread
+    ParallelUtils::parallelFor(count / 2, 4, [&](const size_t i) {
+        delete polyhedra[2 * i];
+        polyhedra[2 * i] = NULL;
+    });
+    for (Polyhedron3d* polyhedron : polyhedra)
+        delete polyhedron;
+}
+
+static void buildAndDestroyCuboids(const size_t count, const size_t threadCount) {
+    ParallelUtils::parallelFor(count, threadCount, [](const size_t i) {
+        const double size = static_cast<double>(i % 64 + 1);
+        Polyhedron3d polyhedron(BBox3d(Vec3d(-size, -size, -size), Vec3d(size, size, size)));
+        polyhedron.addPoint(Vec3d(0.0, 0.0, 2.0 * size));
+        const Polyhedron3d copy(polyhedron);
+    });
+}
+
+TEST(PolyhedronTest, DISABLED_allocationBenchmark) {
+    const size_t count = 20000;
+    const size_t threadCount = ParallelUtils::workerCount(count);
+    
+    TrenchBroom::measureTime("sequentialMs", [&]() { buildAndDestroyCuboids(count, 1); });
+    TrenchBroom::measureTime("parallelMs", [&]() { buildAndDestroyCuboids(count, threadCount); });
+    RecordProperty("threads", static_cast<int>(threadCount));
+}
+
 TEST(PolyhedronTest, removeVertexFromPoint) {
     const Vec3d p1(  0.0,   0.0,   0.0);
     
@@ -0,0 +1,125 @@
+/*
+ Copyright (C) 2010-2016 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "GL/GLMock.h"
+#include "Assets/Texture.h"
+#include "Renderer/IndexRangeMapBuilder.h"
+#include "Renderer/RenderUtils.h"
+#include "Renderer/TexturedIndexRangeMapBuilder.h"
+#include "Renderer/TexturedIndexRangeRenderer.h"
+#include "Renderer/Vbo.h"
+#include "Renderer/VertexArray.h"
+#include "Renderer/VertexSpec.h"
+
+namespace TrenchBroom {
+    namespace Renderer {
+        typedef VertexSpecs::P3::Vertex Vertex;
+        
+        static Vertex::List makeQuad(const float offset) {
+            Vertex::List vertices;
+            vertices.push_back(Vertex(Vec3f(offset,        0.0f, 0.0f)));
+            vertices.push_back(Vertex(Vec3f(offset + 1.0f, 0.0f, 0.0f)));
+            vertices.push_back(Vertex(Vec3f(offset + 1.0f, 1.0f, 0.0f)));
+            vertices.push_back(Vertex(Vec3f(offset,        1.0f, 0.0f)));
+            return vertices;
+        }
+        
+        TEST(IndexRangeMapTest, polygonsAreRenderedWithOneDrawCall) {
+            using namespace testing;
+            NiceMock<GLMock> glMock;
+            
+            const size_t polygonCount = 100;
+            
+            IndexRangeMap::Size size;
+            for (size_t i = 0; i < polygonCount; ++i)
+                size.incPolygon(4);
+            
+            IndexRangeMapBuilder<VertexSpecs::P3> builder(4 * polygonCount, size);
+            for (size_t i = 0; i < polygonCount; ++i)
+                builder.addPolygon(makeQuad(static_cast<float>(i)));
+            
+            ASSERT_EQ(4 * polygonCount, builder.vertices().size());
+            
+            Vbo vbo(0xFFFF, GL_ARRAY_BUFFER);
+            VertexArray vertexArray = VertexArray::swap(builder.vertices());
+            
+            ActivateVbo activate(vbo);
+            vertexArray.prepare(vbo);
+            
+            EXPECT_CALL(glMock, MultiDrawArrays(_, _, _, _)).Times(0);
+            EXPECT_CALL(glMock, DrawArrays(_, _, _)).Times(0);
+            EXPECT_CALL(glMock, DrawElements(GL_TRIANGLES, static_cast<GLsizei>(6 * polygonCount), GL_UNSIGNED_INT, _)).Times(1);
+            builder.indexArray().render(vertexArray);
+        }
+        
+        TEST(IndexRangeMapTest, singleRangeIsRenderedWithOneDrawCall) {
+            using namespace testing;
+            NiceMock<GLMock> glMock;
+            
+            Vertex::List vertices = makeQuad(0.0f);
+            VectorUtils::append(vertices, makeQuad(1.0f));
+            
+            IndexRangeMap indexArray(GL_QUADS, 0, 4);
+            indexArray.add(GL_QUADS, 4, 4);
+            
+            Vbo vbo(0xFFFF, GL_ARRAY_BUFFER);
+            VertexArray vertexArray = VertexArray::swap(vertices);
+            
+            ActivateVbo activate(vbo);
+            vertexArray.prepare(vbo);
+            
+            EXPECT_CALL(glMock, MultiDrawArrays(_, _, _, _)).Times(0);
+            EXPECT_CALL(glMock, DrawArrays(GL_QUADS, 0, 8)).Times(1);
+            indexArray.render(vertexArray);
+        }
+        
+        TEST(IndexRangeMapTest, texturedPolygonsAreRenderedWithOneDrawCallPerTexture) {
+            using namespace testing;
+            NiceMock<GLMock> glMock;
+            
+            Assets::Texture texture1("texture1", 16, 16);
+            Assets::Texture texture2("texture2", 16, 16);
+            
+            const size_t polygonCount = 1000;
+            
+            TexturedIndexRangeMap::Size size;
+            for (size_t i = 0; i < polygonCount; ++i)
+                size.incPolygon(i % 2 == 0 ? &texture1 : &texture2, 4);
+            
+            TexturedIndexRangeMapBuilder<VertexSpecs::P3> builder(4 * polygonCount, size);
+            for (size_t i = 0; i < polygonCount; ++i)
+                builder.addPolygon(i % 2 == 0 ? &texture1 : &texture2, makeQuad(static_cast<float>(i)));
+            
+            Vbo vbo(0xFFFFF, GL_ARRAY_BUFFER);
+            TexturedIndexRangeRenderer renderer(VertexArray::swap(builder.vertices()), builder.indices());
+            
+            ActivateVbo activate(vbo);
+            renderer.prepare(vbo);
+            
+            EXPECT_CALL(glMock, MultiDrawArrays(_, _, _, _)).Times(0);
+            EXPECT_CALL(glMock, DrawElements(GL_TRIANGLES, static_cast<GLsizei>(3 * polygonCount), GL_UNSIGNED_INT, _)).Times(2);
+            
+            TextureRenderFunc func;
+            renderer.render(func);
+        }
+    }
+}
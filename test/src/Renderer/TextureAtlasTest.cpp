@@ -0,0 +1,81 @@
+/*
+ Copyright (C) 2010-2016 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Renderer/TextureAtlas.h"
+
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        static bool overlaps(const TextureAtlas::Slot& lhs, const TextureAtlas::Slot& rhs) {
+            if (lhs.page != rhs.page)
+                return false;
+            return (lhs.texCoordsMin.x() < rhs.texCoordsMax.x() && rhs.texCoordsMin.x() < lhs.texCoordsMax.x() &&
+                    lhs.texCoordsMin.y() < rhs.texCoordsMax.y() && rhs.texCoordsMin.y() < lhs.texCoordsMax.y());
+        }
+        
+        TEST(TextureAtlasTest, insertIntoEmptyAtlas) {
+            TextureAtlas atlas(64, 1);
+            ASSERT_EQ(0u, atlas.pageCount());
+            
+            const std::vector<unsigned char> image(3 * 16 * 8, 255);
+            TextureAtlas::Slot slot;
+            ASSERT_TRUE(atlas.insert(&image.front(), 16, 8, slot));
+            ASSERT_EQ(1u, atlas.pageCount());
+            ASSERT_EQ(0u, slot.page);
+            ASSERT_EQ(16u, slot.width);
+            ASSERT_EQ(8u, slot.height);
+            ASSERT_FLOAT_EQ(1.5f / 64.0f, slot.texCoordsMin.x());
+            ASSERT_FLOAT_EQ(1.5f / 64.0f, slot.texCoordsMin.y());
+            ASSERT_FLOAT_EQ(16.5f / 64.0f, slot.texCoordsMax.x());
+            ASSERT_FLOAT_EQ(8.5f / 64.0f, slot.texCoordsMax.y());
+        }
+        
+        TEST(TextureAtlasTest, insertTooLargeImage) {
+            TextureAtlas atlas(64, 1);
+            
+            const std::vector<unsigned char> image(3 * 64 * 8, 255);
+            TextureAtlas::Slot slot;
+            ASSERT_FALSE(atlas.insert(&image.front(), 64, 8, slot));
+            ASSERT_EQ(0u, atlas.pageCount());
+        }
+        
+        TEST(TextureAtlasTest, insertStartsNewPagesWithoutOverlap) {
+            TextureAtlas atlas(64, 1);
+            
+            const std::vector<unsigned char> image(3 * 20 * 20, 255);
+            std::vector<TextureAtlas::Slot> slots(20);
+            for (size_t i = 0; i < slots.size(); ++i)
+                ASSERT_TRUE(atlas.insert(&image.front(), 20, 20, slots[i]));
+            
+            // three shelves of three images each fit onto a page
+            ASSERT_EQ(3u, atlas.pageCount());
+            ASSERT_EQ(0u, slots[8].page);
+            ASSERT_EQ(1u, slots[9].page);
+            ASSERT_EQ(2u, slots[19].page);
+            
+            for (size_t i = 0; i < slots.size(); ++i) {
+                for (size_t j = i + 1; j < slots.size(); ++j)
+                    ASSERT_FALSE(overlaps(slots[i], slots[j]));
+            }
+        }
+    }
+}
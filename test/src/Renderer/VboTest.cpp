@@ -183,5 +183,176 @@ namespace TrenchBroom {
             // destroy vbo
             EXPECT_CALL(glMock, DeleteBuffers(1, Pointee(13)));
         }
+        
+        TEST(VboTest, reuseCoalescedFreeBlocks) {
+            using namespace testing;
+            InSequence forceInSequenceMockCalls;
+            
+            GLMock glMock;
+            
+            Vbo vbo(0xFFFF, GL_ARRAY_BUFFER);
+            
+            // activate for the first time
+            EXPECT_CALL(glMock, GenBuffers(1,_)).WillOnce(SetArgumentPointee<1>(13));
+            EXPECT_CALL(glMock, BindBuffer(GL_ARRAY_BUFFER, 13));
+            EXPECT_CALL(glMock, BufferData(GL_ARRAY_BUFFER, 0xFFFF, NULL, GL_DYNAMIC_DRAW));
+            {
+                ActivateVbo activate(vbo);
+                
+                VboBlock* block1 = vbo.allocateBlock(100);
+                VboBlock* block2 = vbo.allocateBlock(200);
+                VboBlock* block3 = vbo.allocateBlock(300);
+                ASSERT_EQ(0u, block1->offset());
+                ASSERT_EQ(100u, block2->offset());
+                ASSERT_EQ(300u, block3->offset());
+                
+                block1->free();
+                block2->free();
+                
+                Vbo::Stats stats = vbo.stats();
+                ASSERT_EQ(1u, stats.usedBlockCount);
+                ASSERT_EQ(2u, stats.freeBlockCount);
+                ASSERT_EQ(0xFFFFu - 300u, stats.freeCapacity);
+                
+                // the freed blocks were merged, so this fits without growing the buffer
+                VboBlock* block4 = vbo.allocateBlock(250);
+                ASSERT_EQ(0u, block4->offset());
+                ASSERT_EQ(250u, block4->capacity());
+                
+                stats = vbo.stats();
+                ASSERT_EQ(2u, stats.usedBlockCount);
+                ASSERT_EQ(2u, stats.freeBlockCount);
+                ASSERT_EQ(0xFFFFu - 600u, stats.largestFreeBlock);
+                
+                // deactivate by leaving block
+                EXPECT_CALL(glMock, BindBuffer(GL_ARRAY_BUFFER, 0));
+            }
+            
+            // destroy vbo
+            EXPECT_CALL(glMock, DeleteBuffers(1, Pointee(13)));
+        }
+        
+        TEST(VboTest, compact) {
+            using namespace testing;
+            InSequence forceInSequenceMockCalls;
+            
+            GLMock glMock;
+            
+            Vbo vbo(1000, GL_ARRAY_BUFFER);
+            
+            unsigned char buffer[1000];
+            for (size_t i = 0; i < 1000; ++i)
+                buffer[i] = static_cast<unsigned char>(i % 251);
+            
+            // activate for the first time
+            EXPECT_CALL(glMock, GenBuffers(1,_)).WillOnce(SetArgumentPointee<1>(13));
+            EXPECT_CALL(glMock, BindBuffer(GL_ARRAY_BUFFER, 13));
+            EXPECT_CALL(glMock, BufferData(GL_ARRAY_BUFFER, 1000, NULL, GL_DYNAMIC_DRAW));
+            {
+                ActivateVbo activate(vbo);
+                
+                VboBlock* block1 = vbo.allocateBlock(100);
+                VboBlock* block2 = vbo.allocateBlock(200);
+                VboBlock* block3 = vbo.allocateBlock(300);
+                VboBlock* block4 = vbo.allocateBlock(100);
+                
+                block2->free();
+                block4->free();
+                
+                Vbo::Stats stats = vbo.stats();
+                ASSERT_EQ(2u, stats.freeBlockCount);
+                ASSERT_EQ(600u, stats.freeCapacity);
+                ASSERT_EQ(400u, stats.largestFreeBlock);
+                ASSERT_FLOAT_EQ(1.0f / 3.0f, stats.fragmentation());
+                
+                EXPECT_CALL(glMock, MapBuffer(GL_ARRAY_BUFFER, GL_READ_WRITE)).WillOnce(Return(buffer));
+                EXPECT_CALL(glMock, UnmapBuffer(GL_ARRAY_BUFFER));
+                vbo.compact();
+                
+                ASSERT_EQ(0u, block1->offset());
+                ASSERT_EQ(100u, block3->offset());
+                for (size_t i = 0; i < 300; ++i)
+                    ASSERT_EQ(static_cast<unsigned char>((300 + i) % 251), buffer[100 + i]);
+                
+                stats = vbo.stats();
+                ASSERT_EQ(2u, stats.usedBlockCount);
+                ASSERT_EQ(1u, stats.freeBlockCount);
+                ASSERT_EQ(600u, stats.largestFreeBlock);
+                ASSERT_FLOAT_EQ(0.0f, stats.fragmentation());
+                
+                // compacting a compact buffer does nothing
+                vbo.compact();
+                
+                VboBlock* block5 = vbo.allocateBlock(600);
+                ASSERT_EQ(400u, block5->offset());
+                
+                // deactivate by leaving block
+                EXPECT_CALL(glMock, BindBuffer(GL_ARRAY_BUFFER, 0));
+            }
+            
+            // destroy vbo
+            EXPECT_CALL(glMock, DeleteBuffers(1, Pointee(13)));
+        }
+        
+        TEST(VboTest, streamingVboUploadsOnFlush) {
+            using namespace testing;
+            InSequence forceInSequenceMockCalls;
+            
+            typedef std::vector<unsigned char> Buf;
+            
+            GLMock glMock;
+            
+            Vbo vbo(1000, GL_ARRAY_BUFFER, GL_STREAM_DRAW);
+            ASSERT_TRUE(vbo.streaming());
+            
+            // activate for the first time
+            EXPECT_CALL(glMock, GenBuffers(1,_)).WillOnce(SetArgumentPointee<1>(13));
+            EXPECT_CALL(glMock, BindBuffer(GL_ARRAY_BUFFER, 13));
+            EXPECT_CALL(glMock, BufferData(GL_ARRAY_BUFFER, 1000, NULL, GL_STREAM_DRAW));
+            {
+                ActivateVbo activate(vbo);
+                
+                const Buf writeBuffer(100, 7);
+                
+                // writing to the blocks does not touch the buffer
+                VboBlock* block1 = vbo.allocateBlock(100);
+                VboBlock* block2 = vbo.allocateBlock(100);
+                {
+                    MapVboBlock map(block1);
+                    block1->writeBuffer(0, writeBuffer);
+                }
+                {
+                    MapVboBlock map(block2);
+                    block2->writeBuffer(0, writeBuffer);
+                }
+                
+                // flushing orphans the buffer and uploads the used range at once
+                EXPECT_CALL(glMock, BufferData(GL_ARRAY_BUFFER, 1000, NULL, GL_STREAM_DRAW));
+                EXPECT_CALL(glMock, BufferSubData(GL_ARRAY_BUFFER, 0, 200, _));
+                vbo.flush();
+                
+                // flushing again does nothing
+                vbo.flush();
+                
+                // growing the buffer does not map it
+                EXPECT_CALL(glMock, BindBuffer(GL_ARRAY_BUFFER, 0));
+                EXPECT_CALL(glMock, DeleteBuffers(1, Pointee(13)));
+                EXPECT_CALL(glMock, GenBuffers(1,_)).WillOnce(SetArgumentPointee<1>(14));
+                EXPECT_CALL(glMock, BindBuffer(GL_ARRAY_BUFFER, 14));
+                EXPECT_CALL(glMock, BufferData(GL_ARRAY_BUFFER, 1500, NULL, GL_STREAM_DRAW));
+                VboBlock* block3 = vbo.allocateBlock(1000);
+                ASSERT_EQ(200u, block3->offset());
+                
+                EXPECT_CALL(glMock, BufferData(GL_ARRAY_BUFFER, 1500, NULL, GL_STREAM_DRAW));
+                EXPECT_CALL(glMock, BufferSubData(GL_ARRAY_BUFFER, 0, 1200, _));
+                vbo.flush();
+                
+                // deactivate by leaving block
+                EXPECT_CALL(glMock, BindBuffer(GL_ARRAY_BUFFER, 0));
+            }
+            
+            // destroy vbo
+            EXPECT_CALL(glMock, DeleteBuffers(1, Pointee(14)));
+        }
     }
 }
@@ -0,0 +1,57 @@
+/*
+ Copyright (C) 2010-2016 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "StringPool.h"
+
+namespace TrenchBroom {
+    TEST(StringPoolTest, internEqualStrings) {
+        StringPool pool;
+        
+        const String* str1 = pool.intern("test");
+        const String* str2 = pool.intern(String("te") + "st");
+        const String* str3 = pool.intern("other");
+        
+        ASSERT_EQ(str1, str2);
+        ASSERT_NE(str1, str3);
+        ASSERT_EQ("test", *str1);
+        ASSERT_EQ(2u, pool.size());
+        
+        pool.release(str1);
+        pool.release(str2);
+        pool.release(str3);
+    }
+    
+    TEST(StringPoolTest, releaseLastReference) {
+        StringPool pool;
+        
+        const String* str = pool.intern("test");
+        pool.intern("test");
+        ASSERT_EQ(str, pool.find("test"));
+        ASSERT_TRUE(pool.find("other") == NULL);
+        
+        pool.release(str);
+        ASSERT_EQ(str, pool.find("test"));
+        
+        pool.release(str);
+        ASSERT_TRUE(pool.find("test") == NULL);
+        ASSERT_EQ(0u, pool.size());
+    }
+}
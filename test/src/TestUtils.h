@@ -26,9 +26,29 @@
 #include "VecMath.h"
 #include "Model/ModelTypes.h"
 
+#include <chrono>
+
 namespace TrenchBroom {
     bool texCoordsEqual(const Vec2f& tc1, const Vec2f& tc2);
     bool pointExactlyIntegral(const Vec3d &point);
+    
+    /**
+     * Runs the given function and records the time it took in milliseconds as a property of the current test, which
+     * ends up in the XML report. Benchmarks are disabled, run them with --gtest_also_run_disabled_tests.
+     */
+    template <typename F>
+    double measureTime(const String& name, F func) {
+        typedef std::chrono::high_resolution_clock Clock;
+        
+        const Clock::time_point start = Clock::now();
+        func();
+        const std::chrono::duration<double, std::milli> time = Clock::now() - start;
+        
+        StringStream str;
+        str << time.count();
+        ::testing::Test::RecordProperty(name, str.str());
+        return time.count();
+    }
 
     namespace Model {
         void assertTexture(const String& expected, const Brush* brush, const Vec3d& faceNormal);
@@ -0,0 +1,177 @@
+/*
+ Copyright (C) 2010-2016 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "UniformGrid.h"
+#include "VecMath.h"
+
+#include <algorithm>
+
+typedef UniformGrid<double> Grid;
+
+static bool containsPoint(const Grid::PointList& points, const Vec3d& point) {
+    return std::find(std::begin(points), std::end(points), point) != std::end(points);
+}
+
+class ConstantReach {
+private:
+    double m_reach;
+public:
+    ConstantReach(const double reach) : m_reach(reach) {}
+    double operator()(const BBox3d& bounds) const { return m_reach; }
+};
+
+TEST(UniformGridTest, insertAndRemove) {
+    Grid grid(16.0);
+    ASSERT_TRUE(grid.empty());
+    
+    ASSERT_TRUE(grid.insert(Vec3d(1.0, 2.0, 3.0)));
+    ASSERT_FALSE(grid.insert(Vec3d(1.0, 2.0, 3.0)));
+    ASSERT_TRUE(grid.insert(Vec3d(-1.0, -2.0, -3.0)));
+    ASSERT_EQ(2u, grid.size());
+    ASSERT_EQ(2u, grid.cellCount());
+    
+    ASSERT_TRUE(grid.contains(Vec3d(1.0, 2.0, 3.0)));
+    ASSERT_FALSE(grid.contains(Vec3d(1.0, 2.0, 4.0)));
+    
+    ASSERT_TRUE(grid.remove(Vec3d(1.0, 2.0, 3.0)));
+    ASSERT_FALSE(grid.remove(Vec3d(1.0, 2.0, 3.0)));
+    ASSERT_EQ(1u, grid.size());
+    ASSERT_EQ(1u, grid.cellCount());
+    
+    grid.clear();
+    ASSERT_TRUE(grid.empty());
+    ASSERT_EQ(0u, grid.cellCount());
+}
+
+TEST(UniformGridTest, pointsOnCellBoundaryAreEqualWithinEpsilon) {
+    Grid grid(16.0);
+    ASSERT_TRUE(grid.insert(Vec3d(16.0, 0.0, 0.0)));
+    
+    const Vec3d nearby(16.0 - Math::Constants<double>::almostZero() / 2.0, 0.0, 0.0);
+    ASSERT_TRUE(grid.contains(nearby));
+    ASSERT_FALSE(grid.insert(nearby));
+    ASSERT_TRUE(grid.remove(nearby));
+    ASSERT_TRUE(grid.empty());
+}
+
+TEST(UniformGridTest, findInRadius) {
+    Grid grid(16.0);
+    grid.insert(Vec3d(0.0, 0.0, 0.0));
+    grid.insert(Vec3d(15.0, 0.0, 0.0));
+    grid.insert(Vec3d(17.0, 0.0, 0.0));
+    grid.insert(Vec3d(100.0, 100.0, 100.0));
+    
+    const Grid::PointList result = grid.findInRadius(Vec3d(16.0, 0.0, 0.0), 1.5);
+    ASSERT_EQ(2u, result.size());
+    ASSERT_TRUE(containsPoint(result, Vec3d(15.0, 0.0, 0.0)));
+    ASSERT_TRUE(containsPoint(result, Vec3d(17.0, 0.0, 0.0)));
+    
+    // a radius that covers more cells than there are non-empty cells
+    ASSERT_EQ(4u, grid.findInRadius(Vec3d::Null, 1000.0).size());
+}
+
+TEST(UniformGridTest, findNearRay) {
+    Grid grid(16.0);
+    grid.insert(Vec3d(8.0, 8.0, 8.0));
+    grid.insert(Vec3d(8.0, 40.0, 8.0));
+    grid.insert(Vec3d(8.0, 8.0, 200.0));
+    
+    const Ray3d ray(Vec3d(-100.0, 8.0, 8.0), Vec3d::PosX);
+    
+    Grid::PointList result = grid.findNearRay(ray, ConstantReach(0.0));
+    ASSERT_EQ(1u, result.size());
+    ASSERT_TRUE(containsPoint(result, Vec3d(8.0, 8.0, 8.0)));
+    
+    // the second point is in a cell which is 24 units away from the ray
+    result = grid.findNearRay(ray, ConstantReach(25.0));
+    ASSERT_EQ(2u, result.size());
+    ASSERT_TRUE(containsPoint(result, Vec3d(8.0, 40.0, 8.0)));
+    
+    // cells behind the ray origin are not returned
+    const Ray3d reverse(Vec3d(-100.0, 8.0, 8.0), Vec3d::NegX);
+    ASSERT_TRUE(grid.findNearRay(reverse, ConstantReach(0.0)).empty());
+}
+
+class GrowingReach {
+private:
+    Vec3d m_origin;
+public:
+    GrowingReach(const Vec3d& origin) : m_origin(origin) {}
+    double operator()(const BBox3d& bounds) const {
+        double maxDistance = 0.0;
+        for (size_t i = 0; i < 8; ++i) {
+            const Vec3d corner((i & 1) ? bounds.max.x() : bounds.min.x(),
+                               (i & 2) ? bounds.max.y() : bounds.min.y(),
+                               (i & 4) ? bounds.max.z() : bounds.min.z());
+            maxDistance = std::max(maxDistance, corner.distanceTo(m_origin));
+        }
+        return 2.0 + maxDistance / 20.0;
+    }
+};
+
+template <typename Reach>
+static void assertFindNearRayVisitsAllCells(const Grid::PointList& points, const Grid& grid, const double cellSize, const Ray3d& ray, const Reach& reach) {
+    Grid::PointList expected;
+    for (const Vec3d& point : points) {
+        const Vec3d min(std::floor(point.x() / cellSize) * cellSize,
+                        std::floor(point.y() / cellSize) * cellSize,
+                        std::floor(point.z() / cellSize) * cellSize);
+        const BBox3d bounds(min, min + Vec3d(cellSize, cellSize, cellSize));
+        const BBox3d expanded = bounds.expanded(reach(bounds));
+        if (expanded.contains(ray.origin) || !Math::isnan(expanded.intersectWithRay(ray)))
+            expected.push_back(point);
+    }
+    
+    Grid::PointList actual = grid.findNearRay(ray, reach);
+    std::sort(std::begin(expected), std::end(expected), Vec3d::LexicographicOrder());
+    std::sort(std::begin(actual), std::end(actual), Vec3d::LexicographicOrder());
+    ASSERT_EQ(expected, actual);
+}
+
+TEST(UniformGridTest, findNearRayTraversesCells) {
+    // enough cells that the ray is followed through the grid instead of checking every cell
+    const double cellSize = 16.0;
+    Grid grid(cellSize);
+    Grid::PointList points;
+    for (size_t x = 0; x < 30; ++x) {
+        for (size_t y = 0; y < 30; ++y) {
+            for (size_t z = 0; z < 30; ++z) {
+                const Vec3d point(-200.0 + 16.0 * x + 3.0, -200.0 + 16.0 * y + 5.0, -200.0 + 16.0 * z + 7.0);
+                grid.insert(point);
+                points.push_back(point);
+            }
+        }
+    }
+    
+    const Ray3d rays[] = {
+        Ray3d(Vec3d(-500.0, 3.0, 7.0), Vec3d::PosX),
+        Ray3d(Vec3d(0.0, 0.0, 0.0), Vec3d(1.0, -2.0, 0.5).normalized()),
+        Ray3d(Vec3d(400.0, 350.0, -300.0), Vec3d(-1.0, -1.0, 1.0).normalized()),
+        Ray3d(Vec3d(-300.0, 0.0, 0.0), Vec3d(0.0, 1.0, 0.0)),
+        Ray3d(Vec3d(-300.0, 500.0, 500.0), Vec3d(3.0, -1.0, -2.0).normalized())
+    };
+    
+    for (const Ray3d& ray : rays) {
+        assertFindNearRayVisitsAllCells(points, grid, cellSize, ray, ConstantReach(0.0));
+        assertFindNearRayVisitsAllCells(points, grid, cellSize, ray, ConstantReach(5.0));
+        assertFindNearRayVisitsAllCells(points, grid, cellSize, ray, GrowingReach(ray.origin));
+    }
+}
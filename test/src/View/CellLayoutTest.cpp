@@ -0,0 +1,104 @@
+/*
+ Copyright (C) 2010-2016 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "StringUtils.h"
+#include "View/CellLayout.h"
+
+namespace TrenchBroom {
+    namespace View {
+        typedef CellLayout<int, String> TestLayout;
+        
+        static void createLayout(TestLayout& layout, const size_t groupCount, const size_t itemsPerGroup) {
+            layout.setWidth(200.0f);
+            layout.setOuterMargin(5.0f);
+            layout.setGroupMargin(5.0f);
+            layout.setRowMargin(5.0f);
+            layout.setCellMargin(5.0f);
+            layout.setCellWidth(40.0f, 40.0f);
+            layout.setCellHeight(40.0f, 40.0f);
+            
+            int item = 0;
+            for (size_t i = 0; i < groupCount; ++i) {
+                layout.addGroup("group", 12.0f);
+                for (size_t j = 0; j < itemsPerGroup; ++j)
+                    layout.addItem(item++, 40.0f, 40.0f, 20.0f, 12.0f);
+            }
+        }
+        
+        TEST(CellLayoutTest, indexOfGroupAt) {
+            TestLayout layout;
+            createLayout(layout, 5, 11);
+            ASSERT_EQ(5u, layout.size());
+            
+            for (float y = 0.0f; y < layout.height() + 10.0f; y += 1.0f) {
+                size_t expected = layout.size();
+                for (size_t i = 0; i < layout.size(); ++i) {
+                    if (layout[i].bounds().bottom() >= y) {
+                        expected = i;
+                        break;
+                    }
+                }
+                ASSERT_EQ(expected, layout.indexOfGroupAt(y));
+            }
+        }
+        
+        TEST(CellLayoutTest, indexOfRowAt) {
+            TestLayout layout;
+            createLayout(layout, 1, 23);
+            const TestLayout::Group& group = layout[0];
+            ASSERT_LT(1u, group.size());
+            
+            for (float y = 0.0f; y < layout.height() + 10.0f; y += 1.0f) {
+                size_t expected = group.size();
+                for (size_t i = 0; i < group.size(); ++i) {
+                    if (y < group[i].bounds().bottom()) {
+                        expected = i;
+                        break;
+                    }
+                }
+                ASSERT_EQ(expected, group.indexOfRowAt(y));
+            }
+        }
+        
+        TEST(CellLayoutTest, cellAt) {
+            TestLayout layout;
+            createLayout(layout, 3, 9);
+            
+            for (size_t i = 0; i < layout.size(); ++i) {
+                const TestLayout::Group& group = layout[i];
+                for (size_t j = 0; j < group.size(); ++j) {
+                    const TestLayout::Group::Row& row = group[j];
+                    for (size_t k = 0; k < row.size(); ++k) {
+                        const TestLayout::Group::Row::Cell& cell = row[k];
+                        const LayoutBounds& bounds = cell.itemBounds();
+                        
+                        const TestLayout::Group::Row::Cell* result = NULL;
+                        ASSERT_TRUE(layout.cellAt(bounds.midX(), bounds.midY(), &result));
+                        ASSERT_EQ(cell.item(), result->item());
+                    }
+                }
+            }
+            
+            const TestLayout::Group::Row::Cell* result = NULL;
+            ASSERT_FALSE(layout.cellAt(100.0f, layout.height() + 10.0f, &result));
+        }
+    }
+}